@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * Minimal timing helpers shared by the micro-benchmarks.
+ *
+ * Each benchmark is a plain executable: it prints one line per measured
+ * variant and a speedup line, so results can be diffed between builds.
+ */
+namespace Benchmark {
+
+    // Keeps the optimizer from discarding a computed value
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result {
+        std::string name;
+        double secondsTotal = 0.0;
+        std::size_t iterations = 0;
+        std::size_t bytesPerIteration = 0;
+
+        double nanosPerIteration() const {
+            return iterations ? secondsTotal * 1e9 / static_cast<double>(iterations) : 0.0;
+        }
+
+        double megabytesPerSecond() const {
+            if (secondsTotal <= 0.0) return 0.0;
+            return static_cast<double>(bytesPerIteration) * static_cast<double>(iterations) /
+                   secondsTotal / (1024.0 * 1024.0);
+        }
+    };
+
+    // Runs fn() `iterations` times after a short warm-up and prints the result
+    template<typename Fn>
+    Result run(const std::string& name, std::size_t iterations, std::size_t bytesPerIteration, Fn&& fn) {
+        for (std::size_t i = 0; i < iterations / 10 + 1; ++i) {
+            doNotOptimize(fn());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            doNotOptimize(fn());
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        Result result;
+        result.name = name;
+        result.secondsTotal = std::chrono::duration<double>(stop - start).count();
+        result.iterations = iterations;
+        result.bytesPerIteration = bytesPerIteration;
+
+        std::cout << std::left << std::setw(40) << name << std::right
+                  << std::setw(14) << std::fixed << std::setprecision(1) << result.nanosPerIteration() << " ns/op";
+        if (bytesPerIteration) {
+            std::cout << std::setw(12) << std::setprecision(1) << result.megabytesPerSecond() << " MiB/s";
+        }
+        std::cout << "\n";
+        return result;
+    }
+
+    inline void printSpeedup(const Result& baseline, const Result& candidate) {
+        const double speedup = candidate.nanosPerIteration() > 0.0
+            ? baseline.nanosPerIteration() / candidate.nanosPerIteration()
+            : 0.0;
+        std::cout << "  -> " << candidate.name << " is " << std::fixed << std::setprecision(2)
+                  << speedup << "x faster than " << baseline.name << "\n\n";
+    }
+
+} // namespace Benchmark
@@ -0,0 +1,83 @@
+/**
+ * Benchmark: the per-byte switch hasBalancedBraces vs. the table-driven and
+ * vectorized BraceBalanceChecker kernels on a large pasted file.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "BraceBalance.hpp"
+#include "SimdSearch.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string makePastedFile(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "// Inventory management for level 4, pasted from the player's editor\n",
+        "class Inventory {\n",
+        "public:\n",
+        "    void add(const std::string& item, int count) { items_[item] += count; }\n",
+        "    int total() const {\n",
+        "        return std::accumulate(items_.begin(), items_.end(), 0,\n",
+        "                               [](int sum, const auto& entry) { return sum + entry.second; });\n",
+        "    }\n",
+        "private:\n",
+        "    std::map<std::string, int> items_;\n",
+        "};\n",
+    };
+
+    std::string code;
+    for (std::size_t i = 0; code.size() < targetBytes; ++i) {
+        code += lines[i % lines.size()];
+    }
+    return code;
+}
+
+// The pre-vectorization hasBalancedBraces, kept as the baseline
+bool legacyHasBalancedBraces(const std::string& code) {
+    int braceCount = 0;
+    int parenCount = 0;
+    int bracketCount = 0;
+
+    for (char c : code) {
+        switch (c) {
+            case '{': braceCount++; break;
+            case '}': braceCount--; break;
+            case '(': parenCount++; break;
+            case ')': parenCount--; break;
+            case '[': bracketCount++; break;
+            case ']': bracketCount--; break;
+        }
+        if (braceCount < 0 || parenCount < 0 || bracketCount < 0) {
+            return false;
+        }
+    }
+
+    return braceCount == 0 && parenCount == 0 && bracketCount == 0;
+}
+
+} // namespace
+
+int main() {
+    const std::string code = makePastedFile(8 * 1024 * 1024);
+    const std::size_t iterations = 20;
+
+    std::cout << "Bracket balance benchmark (" << code.size() / (1024 * 1024) << " MiB of balanced code)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    auto baseline = Benchmark::run("switch per byte", iterations, code.size(),
+                                   [&] { return legacyHasBalancedBraces(code); });
+
+    for (auto level : {SimdSearch::Level::Scalar, SimdSearch::Level::SSE2, SimdSearch::Level::AVX2}) {
+        if (!SimdSearch::setLevel(level)) {
+            continue;
+        }
+        auto result = Benchmark::run(std::string("BraceBalanceChecker [") + SimdSearch::levelName(level) + "]",
+                                     iterations, code.size(),
+                                     [&] { return BraceBalanceChecker::check(code).balanced; });
+        Benchmark::printSpeedup(baseline, result);
+    }
+    SimdSearch::setLevel(SimdSearch::bestSupportedLevel());
+
+    return 0;
+}
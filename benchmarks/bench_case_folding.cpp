@@ -0,0 +1,75 @@
+/**
+ * Benchmark: copy-and-lowercase case-insensitive search and ::tolower
+ * transforms vs. the SimdSearch case-folding kernels.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "SimdSearch.hpp"
+#include "StringUtils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string makeSubmission(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "    // TODO: Replace the Raw Pointer with a Smart Pointer\n",
+        "    auto Widget = std::make_shared<Gadget>(Config{\"Level\", 3});\n",
+        "    for (const auto& [Key, Value] : Inventory) { Total += Value; }\n",
+        "    Logger::Info(\"Attempt accepted after \" + std::to_string(Ms) + \" ms\");\n",
+    };
+
+    std::string code;
+    for (std::size_t i = 0; code.size() < targetBytes; ++i) {
+        code += lines[i % lines.size()];
+    }
+    return code;
+}
+
+// The pre-SIMD helpers, kept as the baseline
+std::string legacyToLowerCase(const std::string& str) {
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    return result;
+}
+
+bool legacyContainsIgnoreCase(const std::string& str, const std::string& substr) {
+    return legacyToLowerCase(str).find(legacyToLowerCase(substr)) != std::string::npos;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t iterations = 2000;
+
+    std::cout << "Case folding benchmark (best level: "
+              << SimdSearch::levelName(SimdSearch::bestSupportedLevel()) << ")\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t size : {std::size_t{4 * 1024}, std::size_t{256 * 1024}}) {
+        const std::string code = makeSubmission(size) + "std::MAKE_UNIQUE";
+        const std::size_t bytes = code.size();
+        std::cout << "submission of " << bytes / 1024 << " KiB, hint at the very end\n";
+
+        auto legacySearch = Benchmark::run("lowercase copies + find", iterations, bytes,
+                                           [&] { return legacyContainsIgnoreCase(code, "std::make_unique"); });
+        auto foldedSearch = Benchmark::run("StringUtils::containsIgnoreCase", iterations, bytes,
+                                           [&] { return StringUtils::containsIgnoreCase(code, "std::make_unique"); });
+        Benchmark::printSpeedup(legacySearch, foldedSearch);
+
+        std::string scratch = code;
+        auto legacyLower = Benchmark::run("std::transform(::tolower)", iterations, bytes, [&] {
+            std::transform(scratch.begin(), scratch.end(), scratch.begin(), ::tolower);
+            return scratch.size();
+        });
+        auto simdLower = Benchmark::run("StringUtils::toLowerCaseInPlace", iterations, bytes, [&] {
+            StringUtils::toLowerCaseInPlace(scratch);
+            return scratch.size();
+        });
+        Benchmark::printSpeedup(legacyLower, simdLower);
+    }
+
+    return 0;
+}
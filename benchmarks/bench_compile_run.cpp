@@ -0,0 +1,155 @@
+/**
+ * Benchmark: compile-and-run validation latency and throughput.
+ *
+ * Shelling out to the compiler for every attempt (a fresh shell, all headers
+ * parsed from scratch) vs. the CompileRunner pool with and without its
+ * precompiled header. Prints p50/p99 latency per submission and sustained
+ * submissions per second with one client thread per worker.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "CompileRunner.hpp"
+#include "FileUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kSubmissions[] = {
+    R"(#include <iostream>
+#include <memory>
+#include <string>
+
+int main() {
+    auto unique = std::make_unique<int>(42);
+    auto shared1 = std::make_shared<std::string>("Hello");
+    auto shared2 = shared1;
+    std::cout << *unique << " " << *shared1 << std::endl;
+    std::cout << "Shared count: " << shared1.use_count() << std::endl;
+    return 0;
+})",
+    R"(#include <iostream>
+#include <utility>
+#include <type_traits>
+
+template<typename T>
+auto process(T value) {
+    if constexpr (std::is_integral_v<T>) {
+        return value * 2;
+    } else {
+        return value;
+    }
+}
+
+int main() {
+    auto [number, text] = std::make_pair(42, "Hello");
+    std::cout << "Number: " << number << "\nText: " << text << "\nProcessed: " << process(number) << std::endl;
+    return 0;
+})",
+};
+
+// Every submission differs, as real attempts do
+std::string submission(std::size_t index) {
+    return "// attempt " + std::to_string(index) + "\n" + kSubmissions[index % 2];
+}
+
+struct Measurement {
+    std::vector<double> millis;
+    double seconds = 0.0;
+    std::size_t failures = 0;
+};
+
+void report(const std::string& name, Measurement m) {
+    std::sort(m.millis.begin(), m.millis.end());
+    auto percentile = [&](double fraction) {
+        return m.millis[static_cast<std::size_t>(fraction * static_cast<double>(m.millis.size() - 1) + 0.5)];
+    };
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(1)
+              << "p50 " << std::setw(7) << percentile(0.50) << " ms  p99 " << std::setw(7) << percentile(0.99)
+              << " ms  " << std::setw(6) << std::setprecision(2)
+              << static_cast<double>(m.millis.size()) / m.seconds << " submissions/s";
+    if (m.failures) {
+        std::cout << "  (" << m.failures << " failed)";
+    }
+    std::cout << "\n";
+}
+
+// Runs `count` validations spread over `clients` threads
+Measurement measure(std::size_t count, std::size_t clients, const std::function<bool(std::size_t)>& validate) {
+    Measurement m;
+    m.millis.resize(count);
+    std::vector<char> passed(count, 0);
+    std::atomic<std::size_t> next{0};
+
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < clients; ++t) {
+        threads.emplace_back([&] {
+            for (std::size_t i; (i = next.fetch_add(1)) < count;) {
+                const auto begin = Clock::now();
+                passed[i] = validate(i) ? 1 : 0;
+                m.millis[i] = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    m.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    m.failures = static_cast<std::size_t>(std::count(passed.begin(), passed.end(), 0));
+    return m;
+}
+
+} // namespace
+
+int main() {
+    if (!CompileRunner::isSupported()) {
+        std::cout << "Compile-and-run validation is not supported on this platform\n";
+        return 0;
+    }
+
+    const std::size_t workers = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t count = 20 * workers;
+
+    std::cout << "Compile-and-run benchmark (" << count << " submissions, " << workers << " worker(s))\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    // Baseline: one shell + compiler + run per attempt
+    const auto scratch = std::filesystem::temp_directory_path() / "cpp-code-quest-bench-shell";
+    std::filesystem::create_directories(scratch);
+    const auto shell = measure(count, workers, [&](std::size_t i) {
+        const auto dir = scratch / std::to_string(i);
+        std::filesystem::create_directories(dir);
+        GameUtils::FileUtils::write_file((dir / "main.cpp").string(), submission(i));
+        const std::string command = "cd '" + dir.string() + "' && c++ -std=c++17 -O0 -w main.cpp -o main "
+                                    "2>/dev/null && ./main > out.txt";
+        return std::system(command.c_str()) == 0;
+    });
+    std::filesystem::remove_all(scratch);
+    report("system(\"c++ ... && ./main\")", shell);
+
+    for (bool pch : {false, true}) {
+        CompileRunner::Options options;
+        options.workers = workers;
+        options.precompiledHeader = pch;
+        CompileRunner runner(options);
+        if (!runner.ready()) {
+            std::cout << "CompileRunner could not start\n";
+            return 1;
+        }
+        const auto pooled = measure(count, workers, [&](std::size_t i) {
+            return runner.execute(submission(i)).status == CompileRunner::Status::Passed;
+        });
+        report(pch ? "CompileRunner (pool + PCH)" : "CompileRunner (pool, no PCH)", pooled);
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * Benchmark: isValidCppIdentifier with the old per-call keyword vector and
+ * linear std::find vs. the compile-time perfect hash.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "CppKeywords.hpp"
+#include "StringUtils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The pre-perfect-hash implementation, kept as the baseline
+bool legacyIsValidCppIdentifier(const std::string& str) {
+    if (str.empty()) {
+        return false;
+    }
+    if (!std::isalpha(static_cast<unsigned char>(str[0])) && str[0] != '_') {
+        return false;
+    }
+    for (size_t i = 1; i < str.length(); ++i) {
+        if (!std::isalnum(static_cast<unsigned char>(str[i])) && str[i] != '_') {
+            return false;
+        }
+    }
+
+    // getCppKeywords() built this vector on every call
+    const std::vector<std::string> keywords(std::begin(CppKeywords::kWords), std::end(CppKeywords::kWords));
+    return std::find(keywords.begin(), keywords.end(), str) == keywords.end();
+}
+
+} // namespace
+
+int main() {
+    // A mix of keywords and identifiers as they show up in submissions
+    const std::vector<std::string> identifiers = {
+        "auto", "value", "lambda", "multiplier", "std", "make_unique", "result_", "unique",
+        "shared1", "template", "T", "arg", "wrapper", "condition_variable", "x", "counter_42",
+    };
+    const std::size_t checksPerOp = identifiers.size();
+
+    std::cout << "isValidCppIdentifier benchmark (" << checksPerOp << " identifiers per op)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    auto legacy = Benchmark::run("vector + std::find", 20000, 0, [&] {
+        int valid = 0;
+        for (const auto& identifier : identifiers) {
+            valid += legacyIsValidCppIdentifier(identifier);
+        }
+        return valid;
+    });
+
+    auto hashed = Benchmark::run("constexpr perfect hash", 4000000, 0, [&] {
+        int valid = 0;
+        for (const auto& identifier : identifiers) {
+            valid += StringUtils::isValidCppIdentifier(identifier);
+        }
+        return valid;
+    });
+
+    Benchmark::printSpeedup(legacy, hashed);
+    std::cout << "  " << hashed.iterations * checksPerOp / 1000000 << "M checks in "
+              << hashed.secondsTotal << " s\n";
+    return 0;
+}
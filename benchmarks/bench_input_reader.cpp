@@ -0,0 +1,83 @@
+/**
+ * Benchmark: reading a large DONE-terminated paste. The original
+ * Level::getUserCode loop (std::getline plus code += line + "\n") vs.
+ * InputReader on the same stream and directly on the file descriptor.
+ * Prints the number of reads each InputReader variant needed.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "InputReader.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define CQ_BENCH_POSIX 1
+#endif
+
+namespace {
+
+std::string makePaste(std::size_t targetBytes) {
+    std::string paste;
+    for (std::size_t i = 0; paste.size() < targetBytes; ++i) {
+        paste += "    total += counts[" + std::to_string(i) + "]; // running sum\n";
+    }
+    return paste + "DONE\n";
+}
+
+} // namespace
+
+int main() {
+    const auto path = (std::filesystem::temp_directory_path() / "cpp-code-quest-bench-paste.txt").string();
+    const std::string paste = makePaste(8 * 1024 * 1024);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << paste;
+    }
+    const std::size_t iterations = 10;
+
+    std::cout << "Input reader benchmark (" << paste.size() / (1024 * 1024) << " MiB paste)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    auto baseline = Benchmark::run("getline + code += line + \"\\n\"", iterations, paste.size(), [&] {
+        std::ifstream in(path, std::ios::binary);
+        std::string code;
+        std::string line;
+        while (std::getline(in, line) && line != "DONE") {
+            code += line + "\n";
+        }
+        return code.size();
+    });
+
+    std::size_t reads = 0;
+    auto stream = Benchmark::run("InputReader on the ifstream", iterations, paste.size(), [&] {
+        std::ifstream in(path, std::ios::binary);
+        InputReader reader(InputReader::fromStream(in));
+        std::string code;
+        reader.readSubmission(code, "DONE");
+        reads = reader.readCalls();
+        return code.size();
+    });
+    std::cout << "  (" << reads << " reads)\n";
+    Benchmark::printSpeedup(baseline, stream);
+
+#ifdef CQ_BENCH_POSIX
+    auto descriptor = Benchmark::run("InputReader on the descriptor", iterations, paste.size(), [&] {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        InputReader reader(InputReader::fromDescriptor(fd));
+        std::string code;
+        reader.readSubmission(code, "DONE");
+        reads = reader.readCalls();
+        ::close(fd);
+        return code.size();
+    });
+    std::cout << "  (" << reads << " read(2) calls)\n";
+    Benchmark::printSpeedup(baseline, descriptor);
+#endif
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * Benchmark: inventory queries for a leaderboard job over 10,000 players.
+ * The old inventory was a std::vector<std::string> of reward names, so a
+ * membership test was a std::find with string compares and merging another
+ * player's items copied strings; Inventory is a bitset over reward ids
+ * interned from the catalog. Also compares the saved size of each form.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "Inventory.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Names = std::vector<std::string>;
+
+const std::size_t kPlayers = 10000;
+const std::size_t kRewards = 40;
+
+// The old has_inventory_item()
+bool hasName(const Names& items, const std::string& name) {
+    return std::find(items.begin(), items.end(), name) != items.end();
+}
+
+// The old way to award items that may already be held
+void mergeNames(Names& items, const Names& other) {
+    for (const auto& name : other) {
+        if (!hasName(items, name)) {
+            items.push_back(name);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Inventory benchmark (" << kPlayers << " players, " << kRewards << " rewards)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    std::vector<std::string> rewards;
+    for (std::size_t id = 0; id < kRewards; ++id) {
+        rewards.push_back("Scroll of Modern C++ Feature " + std::to_string(id));
+    }
+
+    // Each player holds a scattered half of the rewards, in award order
+    std::vector<Names> named(kPlayers);
+    std::vector<Inventory> bitsets(kPlayers);
+    for (std::size_t p = 0; p < kPlayers; ++p) {
+        for (std::size_t i = 0; i < kRewards; ++i) {
+            const std::size_t id = (i * 7 + p * 13) % kRewards;
+            if ((p + id) % 2 == 0) {
+                named[p].push_back(rewards[id]);
+                bitsets[p].add(static_cast<Inventory::ItemId>(id));
+            }
+        }
+    }
+
+    // An unlock needs three rewards from across the catalog
+    const Names unlockNames = {rewards[3], rewards[20], rewards[37]};
+    Inventory unlock;
+    for (const Inventory::ItemId id : {3u, 20u, 37u}) {
+        unlock.add(id);
+    }
+
+    auto baseline = Benchmark::run("vector<string> has, find", 200, 0, [&] {
+        std::size_t total = 0;
+        for (const auto& items : named) {
+            total += hasName(items, rewards[kRewards - 1]) ? 1u : 0u;
+        }
+        return total;
+    });
+    auto result = Benchmark::run("Inventory::has", 200, 0, [&] {
+        std::size_t total = 0;
+        for (const auto& items : bitsets) {
+            total += items.has(static_cast<Inventory::ItemId>(kRewards - 1)) ? 1u : 0u;
+        }
+        return total;
+    });
+    Benchmark::printSpeedup(baseline, result);
+
+    baseline = Benchmark::run("vector<string> unlock, 3 finds", 200, 0, [&] {
+        std::size_t total = 0;
+        for (const auto& items : named) {
+            total += std::all_of(unlockNames.begin(), unlockNames.end(),
+                                 [&](const std::string& name) { return hasName(items, name); }) ? 1u : 0u;
+        }
+        return total;
+    });
+    result = Benchmark::run("Inventory::includes", 200, 0, [&] {
+        std::size_t total = 0;
+        for (const auto& items : bitsets) {
+            total += items.includes(unlock) ? 1u : 0u;
+        }
+        return total;
+    });
+    Benchmark::printSpeedup(baseline, result);
+
+    // Union of each player with the next, as a team report would
+    baseline = Benchmark::run("vector<string> union, copies", 50, 0, [&] {
+        std::size_t total = 0;
+        for (std::size_t p = 0; p < kPlayers; ++p) {
+            Names team = named[p];
+            mergeNames(team, named[(p + 1) % kPlayers]);
+            total += team.size();
+        }
+        return total;
+    });
+    result = Benchmark::run("Inventory::merge", 50, 0, [&] {
+        std::size_t total = 0;
+        for (std::size_t p = 0; p < kPlayers; ++p) {
+            Inventory team = bitsets[p];
+            team.merge(bitsets[(p + 1) % kPlayers]);
+            total += team.count();
+        }
+        return total;
+    });
+    Benchmark::printSpeedup(baseline, result);
+
+    // Saved form: one "inventory_item=<name>" line per item vs. one hex line
+    std::size_t namedBytes = 0;
+    std::size_t hexBytes = 0;
+    for (std::size_t p = 0; p < kPlayers; ++p) {
+        for (const auto& name : named[p]) {
+            namedBytes += std::string("inventory_item=").size() + name.size() + 1;
+        }
+        hexBytes += std::string("inventory=").size() + bitsets[p].toHex().size() + 1;
+    }
+    std::cout << "Saved inventory per player: " << namedBytes / kPlayers << " bytes as names, "
+              << hexBytes / kPlayers << " bytes as hex\n";
+    return 0;
+}
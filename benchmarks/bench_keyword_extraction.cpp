@@ -0,0 +1,102 @@
+/**
+ * Benchmark: regex-per-keyword extraction vs. the single-pass tokenizer
+ * behind StringUtils::extractCppKeywords.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "StringUtils.hpp"
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<std::string> kLegacyKeywords = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor",
+    "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t",
+    "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+    "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype",
+    "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+    "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+    "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+    "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected",
+    "public", "register", "reinterpret_cast", "requires", "return", "short",
+    "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+    "switch", "template", "this", "thread_local", "throw", "true", "try",
+    "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual",
+    "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+    "std", "string", "vector", "map", "set", "list", "queue", "stack",
+    "unique_ptr", "shared_ptr", "weak_ptr", "make_unique", "make_shared",
+    "move", "forward", "pair", "tuple", "optional", "variant", "any",
+    "function", "lambda", "bind", "ref", "cref", "iterator", "const_iterator",
+    "begin", "end", "size", "empty", "push_back", "pop_back", "insert",
+    "erase", "find", "count", "sort", "reverse", "transform", "for_each",
+    "algorithm", "numeric", "functional", "memory", "utility", "type_traits",
+    "chrono", "thread", "mutex", "lock_guard", "unique_lock", "condition_variable",
+    "future", "promise", "async", "packaged_task", "exception", "runtime_error",
+    "logic_error", "invalid_argument", "out_of_range", "length_error",
+    "domain_error", "range_error", "overflow_error", "underflow_error"
+};
+
+// The pre-tokenizer implementation: one regex compile and scan per keyword
+std::vector<std::string> legacyExtractCppKeywords(const std::string& code) {
+    std::vector<std::string> foundKeywords;
+    for (const auto& keyword : kLegacyKeywords) {
+        std::regex wordRegex("\\b" + keyword + "\\b");
+        if (std::regex_search(code, wordRegex)) {
+            foundKeywords.push_back(keyword);
+        }
+    }
+    return foundKeywords;
+}
+
+const std::string kSubmission = R"(#include <iostream>
+#include <memory>
+#include <string>
+
+template<typename T>
+auto wrapper(T&& arg) {
+    return std::forward<T>(arg);
+}
+
+int main() {
+    auto unique = std::make_unique<int>(42);
+    auto shared1 = std::make_shared<std::string>("Hello");
+    auto lambda = [p = std::move(unique)](auto multiplier) { return *p * multiplier; };
+    if constexpr (sizeof(int) == 4) {
+        std::cout << lambda(3) << " " << *shared1 << std::endl;
+    }
+    return 0;
+}
+)";
+
+} // namespace
+
+int main() {
+    std::cout << "extractCppKeywords benchmark\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    std::string large;
+    while (large.size() < 64 * 1024) {
+        large += kSubmission;
+    }
+
+    if (legacyExtractCppKeywords(large) != StringUtils::extractCppKeywords(large)) {
+        std::cerr << "Output mismatch between legacy and current implementation\n";
+        return 1;
+    }
+
+    for (const std::string* input : {&kSubmission, static_cast<const std::string*>(&large)}) {
+        std::cout << "input: " << input->size() << " bytes\n";
+        const std::size_t legacyIterations = input->size() < 4096 ? 50 : 2;
+
+        auto legacy = Benchmark::run("regex per keyword", legacyIterations, input->size(),
+                                     [&] { return legacyExtractCppKeywords(*input).size(); });
+        auto current = Benchmark::run("single-pass tokenizer", legacyIterations * 1000, input->size(),
+                                      [&] { return StringUtils::extractCppKeywords(*input).size(); });
+
+        Benchmark::printSpeedup(legacy, current);
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * Benchmark: fetching a level's hint and solution. The old Level code walked
+ * an if/else chain comparing its title with every known title and returned
+ * the text by value; LevelCatalog::find() is one table lookup returning
+ * views into the loaded catalog. Run over catalogs of 5 and 500 levels.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "LevelCatalog.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::string makeCatalog(std::size_t levels) {
+    std::string text;
+    for (std::size_t id = 1; id <= levels; ++id) {
+        const std::string n = std::to_string(id);
+        text += "[level " + n + "]\n"
+                "title = The Hall of Feature " + n + "\n"
+                "story = story\ncharacter = guide\ndialogue = hello\nconcept = concept\n"
+                "explanation = explanation\nchallenge = challenge\nreward = reward\n"
+                "hint = Use feature " + n + " the way the guide showed you, one step at a time.\n"
+                "rule = contains(\"feature\")\n"
+                "solution = <<END\n#include <iostream>\n\nint main() {\n"
+                "    std::cout << \"Feature " + n + " mastered!\" << std::endl;\n"
+                "    return 0;\n}\nEND\n";
+    }
+    return text;
+}
+
+// The shape of the old Level::getHintText()/getSolutionText(): one title
+// comparison per level before the match, then a copy of the text
+struct TitleChain {
+    std::vector<std::pair<std::string, std::string>> hints;       // title, text
+    std::vector<std::pair<std::string, std::string>> solutions;
+
+    static std::string lookup(const std::vector<std::pair<std::string, std::string>>& chain,
+                              const std::string& title) {
+        for (const auto& [candidate, text] : chain) {
+            if (title == candidate) {
+                return text;
+            }
+        }
+        return "Think about the modern C++ features introduced in C++14/17!";
+    }
+};
+
+} // namespace
+
+int main() {
+    std::cout << "Level catalog benchmark (hint + solution per lookup)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t levels : {std::size_t{5}, std::size_t{500}}) {
+        std::string error;
+        const auto catalog = LevelCatalog::parse(makeCatalog(levels), error);
+        if (!catalog) {
+            std::cerr << "Error: " << error << "\n";
+            return 1;
+        }
+
+        TitleChain chain;
+        std::vector<std::string> titles;
+        for (const auto& entry : *catalog) {
+            titles.emplace_back(entry.title);
+            chain.hints.emplace_back(std::string(entry.title), std::string(entry.hint));
+            chain.solutions.emplace_back(std::string(entry.title), std::string(entry.solution));
+        }
+
+        // Every level once per pass, in a scattered order
+        std::vector<std::uint32_t> order;
+        for (std::size_t i = 0; i < levels; ++i) {
+            order.push_back(static_cast<std::uint32_t>((i * 7919) % levels + 1));
+        }
+        const std::size_t lookups = 100000;
+        const std::size_t bytes = lookups * (catalog->find(1)->hint.size() + catalog->find(1)->solution.size());
+        const std::string label = std::to_string(levels) + " levels";
+
+        auto baseline = Benchmark::run("if/else by title, copies, " + label, 20, bytes, [&] {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                const std::string& title = titles[order[i % levels] - 1];
+                total += TitleChain::lookup(chain.hints, title).size();
+                total += TitleChain::lookup(chain.solutions, title).size();
+            }
+            return total;
+        });
+        auto result = Benchmark::run("LevelCatalog::find views, " + label, 20, bytes, [&] {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                const auto* entry = catalog->find(order[i % levels]);
+                total += entry->hint.size();
+                total += entry->solution.size();
+            }
+            return total;
+        });
+        Benchmark::printSpeedup(baseline, result);
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * Benchmark: getting a 500-level catalog ready at startup. Copying every
+ * field into its own std::string per level (what each GameEngine used to do
+ * in its constructor) vs. LevelCatalog::load() on the text catalog vs. the
+ * same on a binary pack written by level-pack, which maps the file and
+ * parses nothing. Heap allocations per load are counted alongside.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "LevelCatalog.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+std::string makeCatalog(std::size_t levels) {
+    std::string text;
+    for (std::size_t id = 1; id <= levels; ++id) {
+        const std::string n = std::to_string(id);
+        text += "[level " + n + "]\n"
+                "title = The Hall of Feature " + n + "\n"
+                "story = You walk into a hall lined with compilers, each one humming a different standard.\n"
+                "character = Keeper of the Hall\ndialogue = Show me what you have learned.\n"
+                "concept = Feature " + n + "\nexplanation = Feature " + n + " makes everyday code shorter.\n"
+                "challenge = Use feature " + n + " in a small program.\nreward = Token " + n + "\n"
+                "hint = Use feature " + n + " the way the keeper showed you.\n"
+                "rule = all(contains(\"feature\"), token(\"int\", \"main\"))\n"
+                "solution = <<END\n#include <iostream>\n\nint main() {\n"
+                "    std::cout << \"Feature " + n + " mastered!\" << std::endl;\n"
+                "    return 0;\n}\nEND\n";
+    }
+    return text;
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// The old Level: every field a separately allocated string
+struct OwnedLevel {
+    std::string title, story, character, dialogue, conceptName, explanation, challenge, reward, hint,
+        solution, rule;
+};
+
+template<typename Fn>
+std::size_t allocationsOf(Fn&& fn) {
+    const std::size_t before = allocations.load();
+    Benchmark::doNotOptimize(fn());
+    return allocations.load() - before;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    namespace fs = std::filesystem;
+    const std::size_t levels = 500;
+    const std::string text = makeCatalog(levels);
+    const std::string textPath = (fs::temp_directory_path() / "cq-bench-levels.catalog").string();
+    const std::string packPath = (fs::temp_directory_path() / "cq-bench-levels.pack").string();
+    std::string error;
+    const auto source = LevelCatalog::parse(text, error);
+    if (!source) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    writeFile(textPath, text);
+    writeFile(packPath, source->toPack());
+
+    std::cout << "Level catalog startup benchmark (" << levels << " levels, " << text.size() << " bytes)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    auto copyLevels = [&] {
+        std::vector<OwnedLevel> owned;
+        for (const auto& e : *source) {
+            owned.push_back({std::string(e.title), std::string(e.story), std::string(e.character),
+                             std::string(e.dialogue), std::string(e.conceptName), std::string(e.explanation),
+                             std::string(e.challenge), std::string(e.reward), std::string(e.hint),
+                             std::string(e.solution), std::string(e.rule)});
+        }
+        return owned.size();
+    };
+    auto loadText = [&] { return LevelCatalog::load(textPath)->size(); };
+    auto loadPack = [&] { return LevelCatalog::load(packPath)->size(); };
+
+    auto copied = Benchmark::run("std::string fields per level", 500, text.size(), copyLevels);
+    auto parsed = Benchmark::run("load() text catalog", 500, text.size(), loadText);
+    auto mapped = Benchmark::run("load() binary pack", 500, text.size(), loadPack);
+    Benchmark::printSpeedup(copied, mapped);
+    Benchmark::printSpeedup(parsed, mapped);
+
+    std::cout << "Heap allocations per load: strings " << allocationsOf(copyLevels)
+              << ", text " << allocationsOf(loadText) << ", pack " << allocationsOf(loadPack) << "\n";
+
+    std::remove(textPath.c_str());
+    std::remove(packPath.c_str());
+    return 0;
+}
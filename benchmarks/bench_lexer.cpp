@@ -0,0 +1,97 @@
+/**
+ * Benchmark: CppLexer throughput on large submissions, and validator checks
+ * as token queries vs. raw substring scans.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "CppLexer.hpp"
+#include "StringUtils.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string makeSubmission(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "#include <memory>\n",
+        "// Level 3: prefer make_unique over raw new\n",
+        "template<typename T, typename... Args>\n",
+        "auto wrapper(Args&&... args) { return std::make_unique<T>(std::forward<Args>(args)...); }\n",
+        "/* structured bindings: auto [key, value] = entry; */\n",
+        "for (const auto& [name, score] : scores) { total += score * 1'000 / 3.5e2; }\n",
+        "const char* banner = \"if constexpr (sizeof(T) > 4) { return; }\";\n",
+        "auto lambda = [ptr = std::move(owner)](int x) mutable -> int { return x << 2; };\n",
+    };
+
+    std::string code;
+    for (std::size_t i = 0; code.size() < targetBytes; ++i) {
+        code += lines[i % lines.size()];
+    }
+    return code;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "CppLexer benchmark\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t size : {std::size_t{64 * 1024}, std::size_t{8 * 1024 * 1024}}) {
+        const std::string code = makeSubmission(size);
+        const std::size_t iterations = size > 1024 * 1024 ? 10 : 500;
+        std::cout << "submission of " << code.size() / 1024 << " KiB\n";
+
+        std::vector<Token> tokens;
+        auto lex = Benchmark::run("CppLexer::tokenize (reused vector)", iterations, code.size(), [&] {
+            tokens.clear();
+            CppLexer::tokenize(code, tokens);
+            return tokens.size();
+        });
+        std::cout << "  " << tokens.size() << " tokens, "
+                  << static_cast<double>(tokens.size()) / lex.secondsTotal * static_cast<double>(lex.iterations) / 1e6
+                  << " M tokens/s\n\n";
+    }
+
+    // The same five checks as raw substring scans and as token queries. The
+    // token queries cost about the same but skip matches in comments and
+    // string literals, which the scans report as false positives.
+    const std::string code = makeSubmission(16 * 1024);
+    const std::size_t iterations = 20000;
+    const TokenStream stream = CppLexer::tokenize(code);
+    std::cout << "five validator checks on a " << code.size() / 1024 << " KiB submission\n";
+
+    for (bool absent : {false, true}) {
+        const std::string suffix = absent ? "_absent" : "";
+        const std::vector<std::string> needles = {"std::move", "make_unique", "if constexpr", "auto [", "forward"};
+        std::vector<std::string> words;
+        for (const auto& needle : needles) {
+            words.push_back(needle + suffix);
+        }
+
+        auto scans = Benchmark::run(absent ? "5 substring scans (no hits)" : "5 substring scans",
+                                    iterations, code.size(), [&] {
+            int hits = 0;
+            for (const auto& word : words) {
+                hits += StringUtils::contains(code, word);
+            }
+            return hits;
+        });
+        auto queries = Benchmark::run(absent ? "5 token queries (no hits)" : "5 token queries",
+                                      iterations, code.size(), [&] {
+            int hits = 0;
+            hits += stream.containsSequence({"std", "::", "move" + suffix});
+            hits += stream.containsToken(words[1]);
+            hits += stream.containsSequence({"if", words[2].substr(3)});
+            hits += stream.containsSequence({"auto", "[" + suffix});
+            hits += stream.containsToken(words[4]);
+            return hits;
+        });
+        Benchmark::printSpeedup(scans, queries);
+        if (!absent) {
+            std::cout << "  (the scans stop at the first hit, often inside a comment or string literal;\n"
+                         "   the token queries reject those and keep looking)\n\n";
+        }
+    }
+
+    return 0;
+}
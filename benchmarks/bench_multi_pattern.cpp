@@ -0,0 +1,95 @@
+/**
+ * Benchmark: per-needle std::string::find loop vs. the precompiled
+ * MultiPatternMatcher behind StringUtils::containsAll / containsAny.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "MultiPatternMatcher.hpp"
+#include "StringUtils.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+// The pre-matcher implementation, kept here as the baseline
+bool legacyContainsAll(const std::string& str, const std::vector<std::string>& substrings) {
+    for (const auto& substr : substrings) {
+        if (str.find(substr) == std::string::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string makeSubmission(std::size_t targetBytes) {
+    const std::string chunk =
+        "#include <iostream>\n"
+        "int compute(int value) {\n"
+        "    int total = value * 2; // accumulate the running total\n"
+        "    for (int i = 0; i < value; ++i) { total += i; }\n"
+        "    return total;\n"
+        "}\n";
+
+    std::string code;
+    while (code.size() < targetBytes) {
+        code += chunk;
+    }
+    // Put the last needles at the very end so every scan covers the whole input
+    code += "auto lambda = [](auto x) { return x; }; std::forward template && make_shared\n";
+    return code;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::vector<std::string>> needleSets = {
+        {"auto", "lambda", "[]"},
+        {"auto", "std::move", "unique_ptr"},
+        {"make_unique", "make_shared"},
+        {"std::forward", "&&", "forward", "template"},
+        {"auto [", "] =", "if constexpr"},
+    };
+
+    std::vector<MultiPatternMatcher> matchers;
+    for (const auto& needles : needleSets) {
+        matchers.emplace_back(needles);
+    }
+
+    std::cout << "Multi-pattern containsAll benchmark (all five level needle sets per op)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t size : {std::size_t{4} * 1024, std::size_t{256} * 1024}) {
+        const std::string code = makeSubmission(size);
+        const std::size_t iterations = size < 64 * 1024 ? 20000 : 300;
+        std::cout << "input: " << code.size() << " bytes\n";
+
+        auto legacy = Benchmark::run("find() per needle", iterations, code.size(), [&] {
+            int hits = 0;
+            for (const auto& needles : needleSets) {
+                hits += legacyContainsAll(code, needles);
+            }
+            return hits;
+        });
+
+        auto adhoc = Benchmark::run("StringUtils::containsAll(vector)", iterations, code.size(), [&] {
+            int hits = 0;
+            for (const auto& needles : needleSets) {
+                hits += StringUtils::containsAll(code, needles);
+            }
+            return hits;
+        });
+
+        auto compiled = Benchmark::run("precompiled MultiPatternMatcher", iterations, code.size(), [&] {
+            int hits = 0;
+            for (const auto& matcher : matchers) {
+                hits += StringUtils::containsAll(code, matcher);
+            }
+            return hits;
+        });
+
+        Benchmark::printSpeedup(legacy, adhoc);
+        Benchmark::printSpeedup(legacy, compiled);
+    }
+
+    return 0;
+}
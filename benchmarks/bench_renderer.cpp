@@ -0,0 +1,155 @@
+/**
+ * Benchmark: drawing a level's screens (story, concept, challenge, attempt
+ * banner, feedback). The old code streamed many small << chunks into
+ * std::cout with std::string(n, c) temporaries for every border; on a
+ * terminal stdout is line-buffered, so every line is a write(2). Renderer
+ * composes the whole screen and writes it once. Both write to /dev/null;
+ * write calls are counted per screen.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "LevelCatalog.hpp"
+#include "Renderer.hpp"
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Line-buffered stdout on a terminal: one write per completed line
+class LineBufferedFile : public std::streambuf {
+public:
+    explicit LineBufferedFile(std::FILE* file) : file_(file) {}
+    size_t writes = 0;
+
+protected:
+    int_type overflow(int_type c) override {
+        if (c == traits_type::eof()) {
+            return traits_type::not_eof(c);
+        }
+        line_ += static_cast<char>(c);
+        if (c == '\n') {
+            flushLine();
+        }
+        return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        for (std::streamsize i = 0; i < n; ++i) {
+            overflow(traits_type::to_int_type(s[i]));
+        }
+        return n;
+    }
+
+    int sync() override {
+        flushLine();
+        return 0;
+    }
+
+private:
+    std::FILE* file_;
+    std::string line_;
+
+    void flushLine() {
+        if (line_.empty()) {
+            return;
+        }
+        ++writes;
+        std::fwrite(line_.data(), 1, line_.size(), file_);
+        std::fflush(file_);
+        line_.clear();
+    }
+};
+
+// The old Level display functions, minus their sleeps
+void drawWithStreams(std::ostream& out, const LevelCatalog::Entry& level) {
+    out << "\n" << std::string(60, '=') << "\n";
+    out << "📖 " << level.title << "\n";
+    out << std::string(60, '=') << "\n";
+    out << level.story << "\n\n";
+    out << level.character << ": \"" << level.dialogue << "\"\n";
+    out << std::string(60, '=') << "\n";
+    out << "\n🧠 C++ Concept: " << level.conceptName << "\n";
+    out << std::string(50, '-') << "\n";
+    out << level.explanation << "\n";
+    out << "\n⚔️ Your Challenge:\n";
+    out << std::string(30, '-') << "\n";
+    out << level.challenge << "\n";
+    out << "\n" << std::string(50, '=') << "\n";
+    out << "⚔️ Attempt " << 1 << "/" << 3 << "\n";
+    out << std::string(50, '=') << "\n";
+    out << "\n📝 Enter your C++ code (type 'DONE' on a new line when finished):\n";
+    out << std::string(50, '-') << "\n";
+    out.flush();
+}
+
+void drawWithRenderer(Renderer& out, const LevelCatalog::Entry& level) {
+    out << "\n";
+    out.rule(60, "═") << "📖 " << level.title << "\n";
+    out.rule(60, "═") << level.story << "\n\n";
+    out << level.character << ": \"" << level.dialogue << "\"\n";
+    out.rule(60, "═");
+    out.pause(std::chrono::milliseconds(1000));
+    out << "\n🧠 C++ Concept: " << level.conceptName << "\n";
+    out.rule(50, "-") << level.explanation << "\n";
+    out << "\n⚔️ Your Challenge:\n";
+    out.rule(30, "-") << level.challenge << "\n";
+    out << "\n";
+    out.rule(50, "=") << "⚔️ Attempt " << 1 << "/" << 3 << "\n";
+    out.rule(50, "=");
+    out << "\n📝 Enter your C++ code (type 'DONE' on a new line when finished):\n";
+    out.rule(50, "-");
+    out.drain();
+}
+
+} // namespace
+
+int main() {
+    std::FILE* devNull = std::fopen("/dev/null", "w");
+    if (!devNull) {
+        std::cerr << "Error: Could not open /dev/null\n";
+        return 1;
+    }
+    const auto& level = LevelCatalog::builtin()[0];
+    const std::size_t iterations = 20000;
+
+    std::cout << "Screen rendering benchmark (one level's opening screens)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    LineBufferedFile lines(devNull);
+    std::ostream streamed(&lines);
+    auto baseline = Benchmark::run("std::ostream, line-buffered", iterations, 0, [&] {
+        drawWithStreams(streamed, level);
+        return lines.writes;
+    });
+
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open("/dev/null", O_WRONLY);
+    Renderer renderer(Renderer::toDescriptor(fd));
+#else
+    Renderer renderer(Renderer::toStream(streamed));
+#endif
+    // A driver fast-forwarding through the pause; a terminal would wait it out
+    renderer.setPacing(false);
+    auto result = Benchmark::run("Renderer, one write per frame", iterations, 0, [&] {
+        drawWithRenderer(renderer, level);
+        return renderer.writeCalls();
+    });
+    Benchmark::printSpeedup(baseline, result);
+
+    const std::size_t runs = iterations + iterations / 10 + 1;
+    std::cout << "write(2) calls per screen: streams " << lines.writes / runs
+              << ", Renderer " << renderer.writeCalls() / runs << "\n";
+
+    std::fclose(devNull);
+#if defined(__unix__) || defined(__APPLE__)
+    ::close(fd);
+#endif
+    return 0;
+}
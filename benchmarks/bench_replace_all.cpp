@@ -0,0 +1,74 @@
+/**
+ * Benchmark: the in-place replace() loop replaceAll used to run, and chains
+ * of replaceAll calls, vs. the single-pass MultiReplacer.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "MultiReplacer.hpp"
+#include "StringUtils.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string makeWindowsSubmission(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "\tauto ptr = std::make_unique<Widget>(42);\r\n",
+        "\tfor (auto& [key, value] : inventory) {\r\n",
+        "\t\ttotal += value;\r\n",
+        "\t}\r\n",
+    };
+
+    std::string code;
+    for (std::size_t i = 0; code.size() < targetBytes; ++i) {
+        code += lines[i % lines.size()];
+    }
+    return code;
+}
+
+// The pre-MultiReplacer replaceAll, kept as the baseline
+std::string legacyReplaceAll(const std::string& str, const std::string& from, const std::string& to) {
+    if (from.empty()) {
+        return str;
+    }
+
+    std::string result = str;
+    size_t pos = 0;
+    while ((pos = result.find(from, pos)) != std::string::npos) {
+        result.replace(pos, from.length(), to);
+        pos += to.length();
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "replaceAll benchmark\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t size : {std::size_t{4 * 1024}, std::size_t{64 * 1024}}) {
+        const std::string code = makeWindowsSubmission(size);
+        const std::size_t bytes = code.size();
+        const std::size_t iterations = size > 16 * 1024 ? 20 : 500;
+        std::cout << "CRLF submission of " << bytes / 1024 << " KiB\n";
+
+        auto legacy = Benchmark::run("in-place replace() loop", iterations, bytes,
+                                     [&] { return legacyReplaceAll(code, "\r\n", "\n"); });
+        auto linear = Benchmark::run("StringUtils::replaceAll", iterations, bytes,
+                                     [&] { return StringUtils::replaceAll(code, "\r\n", "\n"); });
+        Benchmark::printSpeedup(legacy, linear);
+
+        // Normalization: CRLF -> LF, tab -> four spaces, "auto&" -> "auto &"
+        auto chained = Benchmark::run("3 chained replace() loops", iterations, bytes, [&] {
+            return legacyReplaceAll(legacyReplaceAll(legacyReplaceAll(code, "\r\n", "\n"), "\t", "    "),
+                                    "auto&", "auto &");
+        });
+        const MultiReplacer normalizer({{"\r\n", "\n"}, {"\t", "    "}, {"auto&", "auto &"}});
+        auto batched = Benchmark::run("MultiReplacer (3 rules)", iterations, bytes,
+                                      [&] { return normalizer.apply(code); });
+        Benchmark::printSpeedup(chained, batched);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * Benchmark: memory and construction time per GameEngine when every engine
+ * builds its own levels (compiling each rule and allocating its own
+ * validation cache, as engines used to) vs. engines sharing one read-only
+ * LevelSet and keeping only the player's progress. Live heap bytes are
+ * counted for 1000 engines at once, as a server holding that many sessions
+ * would; the built-in catalog and a 100-level one are measured.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "GameEngine.hpp"
+#include "LevelCatalog.hpp"
+#include "LevelSet.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> liveBytes{0};
+
+// Every block carries its size in front, so unsized deletes can be counted
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+std::string makeCatalog(std::size_t levels) {
+    std::string text;
+    for (std::size_t id = 1; id <= levels; ++id) {
+        const std::string n = std::to_string(id);
+        text += "[level " + n + "]\n"
+                "title = The Hall of Feature " + n + "\n"
+                "story = You walk into a hall lined with compilers, each one humming a different standard.\n"
+                "character = Keeper of the Hall\ndialogue = Show me what you have learned.\n"
+                "concept = Feature " + n + "\nexplanation = Feature " + n + " makes everyday code shorter.\n"
+                "challenge = Use feature " + n + " in a small program.\nreward = Token " + n + "\n"
+                "hint = Use feature " + n + " the way the keeper showed you.\n"
+                "rule = all(contains(\"feature\"), token(\"int\", \"main\"), not(contains(\"goto\")))\n"
+                "solution = <<END\nint main() { return 0; }\nEND\n";
+    }
+    return text;
+}
+
+void measure(const LevelCatalog& catalog, const std::string& name) {
+    const std::size_t engines = 1000;
+    InputReader input{InputReader::Options()};
+    std::ostringstream sink;
+    Renderer output(Renderer::toStream(sink));
+    const std::shared_ptr<const LevelSet> shared = LevelSet::create(catalog, name);
+
+    auto ownLevels = [&] {
+        return std::make_unique<GameEngine>(input, output, LevelSet::create(catalog, name));
+    };
+    auto sharedLevels = [&] { return std::make_unique<GameEngine>(input, output, shared); };
+
+    // Live bytes while all of them exist
+    auto bytesPerEngine = [&](auto&& make) {
+        std::vector<std::unique_ptr<GameEngine>> held;
+        held.reserve(engines);
+        const std::size_t before = liveBytes.load();
+        for (std::size_t i = 0; i < engines; ++i) {
+            held.push_back(make());
+        }
+        return (liveBytes.load() - before) / engines;
+    };
+
+    std::cout << name << " (" << catalog.size() << " levels)\n";
+    std::cout << std::string(72, '-') << "\n";
+    auto owned = Benchmark::run("engine with its own levels", 2000, 0, ownLevels);
+    auto sharing = Benchmark::run("engine sharing a LevelSet", 2000, 0, sharedLevels);
+    Benchmark::printSpeedup(owned, sharing);
+    std::cout << "Heap bytes per engine (" << engines << " alive): own levels " << bytesPerEngine(ownLevels)
+              << ", shared " << bytesPerEngine(sharedLevels) << "\n\n";
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* p = std::malloc(size + kHeader)) {
+        *static_cast<std::size_t*>(p) = size;
+        liveBytes.fetch_add(size, std::memory_order_relaxed);
+        return static_cast<char*>(p) + kHeader;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    if (p) {
+        void* block = static_cast<char*>(p) - kHeader;
+        liveBytes.fetch_sub(*static_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+int main() {
+    measure(LevelCatalog::builtin(), "built-in catalog");
+
+    std::string error;
+    const auto large = LevelCatalog::parse(makeCatalog(100), error);
+    if (!large) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    measure(*large, "generated catalog");
+    return 0;
+}
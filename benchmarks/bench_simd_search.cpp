@@ -0,0 +1,80 @@
+/**
+ * Benchmark: std::string::find vs. the SimdSearch kernels (scalar, SSE2,
+ * AVX2) on a multi-megabyte log-like haystack.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "SimdSearch.hpp"
+#include "StringUtils.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string makeLogDump(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "[info] grading submission for level 3: auto unique = std::make_unique<int>(42);\n",
+        "[info] attempt 2 accepted after 14 ms, inventory updated\n",
+        "[warn] submission contains no lambda capture, falling back to hint text\n",
+        "[info] template<typename T> auto wrapper(T&& arg) { return std::forward<T>(arg); }\n",
+    };
+
+    std::string dump;
+    for (std::size_t i = 0; dump.size() < targetBytes; ++i) {
+        dump += lines[i % lines.size()];
+    }
+    return dump;
+}
+
+// The pre-SIMD countOccurrences, kept as the baseline
+int legacyCountOccurrences(const std::string& str, const std::string& substr) {
+    int count = 0;
+    size_t pos = 0;
+    while ((pos = str.find(substr, pos)) != std::string::npos) {
+        count++;
+        pos += substr.length();
+    }
+    return count;
+}
+
+} // namespace
+
+int main() {
+    const std::string haystack = makeLogDump(8 * 1024 * 1024) + "[fatal] segmentation fault in level 5\n";
+    const std::size_t iterations = 20;
+
+    std::cout << "SimdSearch benchmark (haystack " << haystack.size() / (1024 * 1024) << " MiB, best level: "
+              << SimdSearch::levelName(SimdSearch::bestSupportedLevel()) << ")\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    const std::vector<SimdSearch::Level> levels = {
+        SimdSearch::Level::Scalar, SimdSearch::Level::SSE2, SimdSearch::Level::AVX2
+    };
+
+    for (const std::string needle : {"segmentation fault", "fatal", "e;"}) {
+        std::cout << "needle \"" << needle << "\" (match at the very end)\n";
+
+        auto baseline = Benchmark::run("std::string::find", iterations, haystack.size(),
+                                       [&] { return haystack.find(needle); });
+
+        for (auto level : levels) {
+            if (!SimdSearch::setLevel(level)) {
+                continue;
+            }
+            auto result = Benchmark::run(std::string("SimdSearch::find [") + SimdSearch::levelName(level) + "]",
+                                         iterations, haystack.size(),
+                                         [&] { return SimdSearch::find(haystack, needle); });
+            Benchmark::printSpeedup(baseline, result);
+        }
+        SimdSearch::setLevel(SimdSearch::bestSupportedLevel());
+    }
+
+    std::cout << "countOccurrences(\"std::\")\n";
+    auto legacyCount = Benchmark::run("find() loop", iterations, haystack.size(),
+                                      [&] { return legacyCountOccurrences(haystack, "std::"); });
+    auto simdCount = Benchmark::run("StringUtils::countOccurrences", iterations, haystack.size(),
+                                    [&] { return StringUtils::countOccurrences(haystack, "std::"); });
+    Benchmark::printSpeedup(legacyCount, simdCount);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * Benchmark: validating a stream of resubmissions directly vs. through the
+ * ValidationCache, for a substring rule and for a token rule (which has to
+ * lex every submission). Each distinct submission arrives 16 times with
+ * different indentation.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "ValidationCache.hpp"
+#include "ValidationRule.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kDistinct = 64;
+constexpr std::size_t kResubmissions = 16;
+
+std::vector<std::string> makeResubmissions(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "// attempt %: structured bindings over the inventory\n",
+        "std::map<std::string, int> inventory = {{\"sword\", 1}, {\"potion\", 3}};\n",
+        "for (const auto& entry : inventory) {\n",
+        "    std::cout << entry.first << \": \" << entry.second << \"\\n\";\n",
+        "}\n",
+    };
+
+    std::vector<std::string> distinct;
+    for (std::size_t d = 0; d < kDistinct; ++d) {
+        std::string code;
+        for (std::size_t i = 0; code.size() < targetBytes; ++i) {
+            std::string line = lines[i % lines.size()];
+            const auto marker = line.find('%');
+            if (marker != std::string::npos) {
+                line.replace(marker, 1, std::to_string(d));
+            }
+            code += line;
+        }
+        distinct.push_back(code);
+    }
+
+    // Same code, re-indented differently on every resubmission
+    std::vector<std::string> stream;
+    for (std::size_t r = 0; r < kResubmissions; ++r) {
+        for (const auto& code : distinct) {
+            std::string variant(r % 4, ' ');
+            for (char c : code) {
+                variant += c;
+                if (c == '\n') {
+                    variant.append(r % 4, ' ');
+                }
+            }
+            stream.push_back(variant);
+        }
+    }
+    return stream;
+}
+
+ValidationRule compile(const char* source) {
+    std::string error;
+    return *ValidationRule::parse(source, error);
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::pair<const char*, const char*>> rules = {
+        {"substring rule", R"(any(all(contains("auto ["), contains("] =")), contains("if constexpr")))"},
+        {"token rule", R"(any(token("auto", "["), token("if", "constexpr")))"},
+    };
+
+    std::cout << "Validation cache benchmark (" << kDistinct << " submissions x " << kResubmissions
+              << " resubmissions)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t bytes : {std::size_t{2 * 1024}, std::size_t{16 * 1024}}) {
+        const auto stream = makeResubmissions(bytes);
+        std::size_t streamBytes = 0;
+        for (const auto& code : stream) {
+            streamBytes += code.size();
+        }
+
+        for (const auto& [name, source] : rules) {
+            const ValidationRule rule = compile(source);
+            const auto levelKey = ValidationCache::levelKey(0, rule.source());
+            const std::string label = std::string(name) + " " + std::to_string(bytes / 1024) + " KiB";
+
+            auto baseline = Benchmark::run(label + " direct", 5, streamBytes, [&] {
+                std::size_t passed = 0;
+                for (const auto& code : stream) {
+                    passed += rule(code) ? 1u : 0u;
+                }
+                return passed;
+            });
+
+            ValidationCache cache;
+            auto result = Benchmark::run(label + " cached", 5, streamBytes, [&] {
+                cache.clear();
+                std::size_t passed = 0;
+                for (const auto& code : stream) {
+                    passed += cache.validate(levelKey, code, rule) ? 1u : 0u;
+                }
+                return passed;
+            });
+            Benchmark::printSpeedup(baseline, result);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * Benchmark: the hand-written per-level validator lambdas (one matcher scan
+ * per all-of group, plus a plain substring search) vs. the same checks as
+ * compiled ValidationRules, which settle every substring in one scan.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "MultiPatternMatcher.hpp"
+#include "StringUtils.hpp"
+#include "ValidationRule.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Validator = std::function<bool(const std::string&)>;
+
+// The validators as the engine hard-coded them before rules
+std::vector<Validator> legacyValidators() {
+    return {
+        [lambdaWords = MultiPatternMatcher({"auto", "lambda", "[]"}),
+         autoCapture = MultiPatternMatcher({"auto", "[", "auto"})](const std::string& code) {
+            return StringUtils::containsAll(code, lambdaWords) ||
+                   StringUtils::containsAll(code, autoCapture);
+        },
+        [moveCapture = MultiPatternMatcher({"auto", "std::move", "unique_ptr"})](const std::string& code) {
+            return StringUtils::containsAll(code, moveCapture) ||
+                   StringUtils::contains(code, "= std::move");
+        },
+        [factories = MultiPatternMatcher({"make_unique", "make_shared"})](const std::string& code) {
+            return StringUtils::containsAll(code, factories) ||
+                   StringUtils::contains(code, "std::make_unique");
+        },
+        [forwardRef = MultiPatternMatcher({"std::forward", "&&"}),
+         forwardTemplate = MultiPatternMatcher({"forward", "template"})](const std::string& code) {
+            return StringUtils::containsAll(code, forwardRef) ||
+                   StringUtils::containsAll(code, forwardTemplate);
+        },
+        [bindings = MultiPatternMatcher({"auto [", "] ="})](const std::string& code) {
+            return StringUtils::containsAll(code, bindings) ||
+                   StringUtils::contains(code, "if constexpr");
+        },
+    };
+}
+
+std::vector<Validator> compiledRules() {
+    const char* const sources[] = {
+        R"(any(all(contains("auto"), contains("lambda"), contains("[]")), all(contains("auto"), contains("["))))",
+        R"(any(all(contains("auto"), contains("std::move"), contains("unique_ptr")), contains("= std::move")))",
+        R"(any(all(contains("make_unique"), contains("make_shared")), contains("std::make_unique")))",
+        R"(any(all(contains("std::forward"), contains("&&")), all(contains("forward"), contains("template"))))",
+        R"(any(all(contains("auto ["), contains("] =")), contains("if constexpr")))",
+    };
+
+    std::vector<Validator> rules;
+    std::string error;
+    for (const char* source : sources) {
+        rules.emplace_back(*ValidationRule::parse(source, error));
+    }
+    return rules;
+}
+
+// A wrong answer of realistic size: most needles are missing, so every
+// validator has to read the whole submission
+std::string makeSubmission(std::size_t targetBytes) {
+    const std::vector<std::string> lines = {
+        "// Player attempt: still using raw loops and explicit types\n",
+        "int sumInventory(const std::vector<int>& counts) {\n",
+        "    int total = 0;\n",
+        "    for (std::size_t i = 0; i < counts.size(); ++i) {\n",
+        "        total += counts[i];\n",
+        "    }\n",
+        "    return total;\n",
+        "}\n",
+    };
+
+    std::string code;
+    for (std::size_t i = 0; code.size() < targetBytes; ++i) {
+        code += lines[i % lines.size()];
+    }
+    return code;
+}
+
+std::size_t countPasses(const std::vector<Validator>& validators, const std::string& code) {
+    std::size_t passed = 0;
+    for (const auto& validator : validators) {
+        passed += validator(code) ? 1u : 0u;
+    }
+    return passed;
+}
+
+} // namespace
+
+int main() {
+    const auto legacy = legacyValidators();
+    const auto rules = compiledRules();
+
+    std::cout << "Validation rule benchmark (all five levels per submission)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t bytes : {std::size_t{2 * 1024}, std::size_t{64 * 1024}}) {
+        const std::string code = makeSubmission(bytes);
+        const std::size_t iterations = (8 * 1024 * 1024) / bytes;
+
+        auto baseline = Benchmark::run("lambdas " + std::to_string(bytes / 1024) + " KiB", iterations, code.size(),
+                                       [&] { return countPasses(legacy, code); });
+        auto result = Benchmark::run("ValidationRule " + std::to_string(bytes / 1024) + " KiB", iterations,
+                                     code.size(), [&] { return countPasses(rules, code); });
+        Benchmark::printSpeedup(baseline, result);
+    }
+
+    return 0;
+}
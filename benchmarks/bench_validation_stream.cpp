@@ -0,0 +1,92 @@
+/**
+ * Benchmark: live feedback while a submission is typed or pasted line by
+ * line. Re-running ValidationRule::matches() on the whole buffer after every
+ * line (quadratic in the paste) vs. a ValidationRule::Session fed the same
+ * lines, plus the verdict once DONE arrives: a full rescan vs. reading the
+ * session's current state.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "ValidationRule.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Most predicates never match, so a full rescan reads every byte
+const char* const kRule =
+    R"(any(all(token("auto", "["), contains("] =")), all(contains("std::forward"), token("&&")), contains("if constexpr")))";
+
+std::vector<std::string> makeLines(std::size_t count) {
+    const std::vector<std::string> lines = {
+        "// Player attempt: still using raw loops and explicit types\n",
+        "int sumInventory(const std::vector<int>& counts) {\n",
+        "    int total = 0; /* running sum */\n",
+        "    for (std::size_t i = 0; i < counts.size(); ++i) {\n",
+        "        total += counts[i];\n",
+        "    }\n",
+        "    return total;\n",
+        "}\n",
+    };
+    std::vector<std::string> out;
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(lines[i % lines.size()]);
+    }
+    return out;
+}
+
+} // namespace
+
+int main() {
+    std::string error;
+    const auto rule = *ValidationRule::parse(kRule, error);
+
+    std::cout << "Streaming validation benchmark (feedback after every line)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (std::size_t count : {std::size_t{50}, std::size_t{500}}) {
+        const auto lines = makeLines(count);
+        std::size_t bytes = 0;
+        for (const auto& line : lines) {
+            bytes += line.size();
+        }
+        const std::size_t iterations = count < 100 ? 2000 : 40;
+        const std::string label = std::to_string(count) + " lines";
+
+        auto baseline = Benchmark::run("rescan per line, " + label, iterations, bytes, [&] {
+            std::string code;
+            std::size_t met = 0;
+            for (const auto& line : lines) {
+                code += line;
+                met += rule.matches(code) ? 1u : 0u;
+            }
+            return met;
+        });
+        auto result = Benchmark::run("Session per line, " + label, iterations, bytes, [&] {
+            ValidationRule::Session session(rule);
+            std::string code;
+            std::size_t met = 0;
+            for (const auto& line : lines) {
+                code += line;
+                session.advance(code);
+                met += session.progress().met;
+            }
+            return met;
+        });
+        Benchmark::printSpeedup(baseline, result);
+
+        ValidationRule::Session done(rule);
+        std::string code;
+        for (const auto& line : lines) {
+            code += line;
+            done.advance(code);
+        }
+        auto rescan = Benchmark::run("verdict at DONE, rescan, " + label, iterations * 20, bytes,
+                                     [&] { return rule.matches(code); });
+        auto ready = Benchmark::run("verdict at DONE, Session, " + label, iterations * 20, bytes,
+                                    [&] { return done.matches(); });
+        Benchmark::printSpeedup(rescan, ready);
+    }
+
+    return 0;
+}
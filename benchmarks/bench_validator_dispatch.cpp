@@ -0,0 +1,78 @@
+/**
+ * Benchmark: calling a level's validator once per submission in a batch,
+ * with the submissions held as views into one buffer as the batch grader
+ * sees them. The old path stored every validator in a
+ * std::function<bool(const std::string&)>, so each call copied the view
+ * into a std::string and went through the type-erased call. Level now
+ * keeps a ValidationRule as itself and takes string_views.
+ * visitValidator() goes further and compiles the whole loop for the
+ * concrete validator type. The rule is cheap, so call overhead dominates.
+ */
+
+#include "BenchmarkUtils.hpp"
+#include "Level.hpp"
+#include "LevelCatalog.hpp"
+#include "ValidationRule.hpp"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main() {
+    std::string error;
+    const auto rule = *ValidationRule::parse(R"(contains("auto"))", error);
+    const Level level(LevelCatalog::builtin()[0], rule);
+
+    // Short submissions, the common case for early levels
+    const std::vector<std::string> samples = {
+        "int x = 42;\n",
+        "auto x = 42;\n",
+        "for (int i = 0; i < n; ++i) { total += counts[i]; }\n",
+        "auto lambda = [](auto v) { return v * 2; };\n",
+        "std::vector<int> values{1, 2, 3};\n",
+    };
+    std::string buffer;
+    std::vector<std::pair<std::size_t, std::size_t>> spans;
+    for (std::size_t i = 0; i < 4096; ++i) {
+        const auto& sample = samples[i % samples.size()];
+        spans.emplace_back(buffer.size(), sample.size());
+        buffer += sample;
+    }
+    std::vector<std::string_view> submissions;
+    for (const auto& [offset, size] : spans) {
+        submissions.push_back(std::string_view(buffer).substr(offset, size));
+    }
+
+    std::cout << "Validator dispatch benchmark (" << submissions.size() << " submissions per batch)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    const std::function<bool(const std::string&)> erased = [&rule](const std::string& code) {
+        return rule.matches(code);
+    };
+    auto baseline = Benchmark::run("std::function, string copies", 2000, buffer.size(), [&] {
+        std::size_t passed = 0;
+        for (auto code : submissions) {
+            passed += erased(std::string(code)) ? 1u : 0u;
+        }
+        return passed;
+    });
+    auto viaLevel = Benchmark::run("Level::validateSolution(view)", 2000, buffer.size(), [&] {
+        std::size_t passed = 0;
+        for (auto code : submissions) {
+            passed += level.validateSolution(code) ? 1u : 0u;
+        }
+        return passed;
+    });
+    auto visited = Benchmark::run("Level::visitValidator loop", 2000, buffer.size(), [&] {
+        return level.visitValidator([&](const auto& validator) {
+            std::size_t passed = 0;
+            for (auto code : submissions) {
+                passed += validator(code) ? 1u : 0u;
+            }
+            return passed;
+        });
+    });
+    Benchmark::printSpeedup(baseline, viaLevel);
+    Benchmark::printSpeedup(baseline, visited);
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "BatchGrader.hpp"
+#include "GameEngine.hpp"
+#include "../utils/BatchRunner.hpp"
+#include "../utils/FileUtils.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct GradeResult {
+    size_t level = 0;       // 1-based, 0 when unknown
+    bool passed = false;
+    size_t bytes = 0;
+    std::string error;
+};
+
+// First run of digits in the file name, e.g. "level3_alice.cpp" -> 3
+size_t levelNumberOf(const fs::path& file) {
+    const std::string name = file.filename().string();
+    const auto start = name.find_first_of("0123456789");
+    if (start == std::string::npos) {
+        return 0;
+    }
+    size_t number = 0;
+    for (size_t i = start; i < name.size() && name[i] >= '0' && name[i] <= '9' && number < 1000000; ++i) {
+        number = number * 10 + static_cast<size_t>(name[i] - '0');
+    }
+    return number;
+}
+
+GradeResult grade(const GameEngine& engine, const fs::path& file) {
+    GradeResult result;
+    result.level = levelNumberOf(file);
+    const Level* level = result.level <= LevelCatalog::kMaxId
+                             ? engine.findLevel(static_cast<std::uint32_t>(result.level))
+                             : nullptr;
+    if (!level) {
+        result.error = result.level == 0 ? "no level number in file name"
+                                         : "no level " + std::to_string(result.level) + " in the catalog";
+        return result;
+    }
+
+    const auto code = GameUtils::FileUtils::read_file(file.string());
+    if (!code) {
+        result.error = "could not read file";
+        return result;
+    }
+
+    result.bytes = code->size();
+    result.passed = level->validateSolution(*code);
+    return result;
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    static const char* const kHex = "0123456789abcdef";
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += kHex[(c >> 4) & 0xF];
+                    out += kHex[c & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendRow(std::string& out, BatchGrader::Format format, const std::string& file,
+               const GradeResult& result, long long micros) {
+    const std::string level = result.level ? std::to_string(result.level) : "";
+    const char* status = !result.error.empty() ? "error" : (result.passed ? "pass" : "fail");
+
+    if (format == BatchGrader::Format::Csv) {
+        BatchRunner::appendCsvField(out, file);
+        out += ',' + level + ',' + status + ',' + std::to_string(result.bytes) + ',' + std::to_string(micros) + ',';
+        BatchRunner::appendCsvField(out, result.error);
+        out += '\n';
+        return;
+    }
+
+    out += "{\"file\":";
+    appendJsonString(out, file);
+    out += ",\"level\":" + (level.empty() ? std::string("null") : level);
+    out += ",\"status\":\"" + std::string(status) + "\"";
+    out += ",\"bytes\":" + std::to_string(result.bytes);
+    out += ",\"micros\":" + std::to_string(micros);
+    out += ",\"error\":";
+    appendJsonString(out, result.error);
+    out += "}\n";
+}
+
+} // namespace
+
+std::optional<BatchGrader::Summary> BatchGrader::run(const Options& options, std::ostream& report) const {
+    const auto files = BatchRunner::listFiles(options.directory, "submissions");
+    if (!files) {
+        return std::nullopt;
+    }
+
+    Summary summary;
+    summary.submissions = files->size();
+    summary.threads = BatchRunner::threadCount(options.threads, files->size());
+
+    if (options.format == Format::Csv) {
+        report << "file,level,status,bytes,micros,error\n";
+    }
+
+    std::vector<Summary> tallies(summary.threads);
+    const auto cacheBefore = engine_.getValidationCache().stats();
+    const auto start = std::chrono::steady_clock::now();
+    const auto latencies = BatchRunner::run(
+        files->size(), summary.threads, report,
+        [&](size_t index) { return grade(engine_, (*files)[index]); },
+        [&](size_t worker, size_t index, const GradeResult& result, double micros, std::string& rows) {
+            Summary& tally = tallies[worker];
+            tally.bytes += result.bytes;
+            if (!result.error.empty()) {
+                ++tally.errors;
+            } else if (result.passed) {
+                ++tally.passed;
+            } else {
+                ++tally.failed;
+            }
+            appendRow(rows, options.format, (*files)[index].lexically_relative(options.directory).generic_string(),
+                      result, static_cast<long long>(micros));
+        });
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const Summary& tally : tallies) {
+        summary.passed += tally.passed;
+        summary.failed += tally.failed;
+        summary.errors += tally.errors;
+        summary.bytes += tally.bytes;
+    }
+    const auto cacheAfter = engine_.getValidationCache().stats();
+    summary.cacheHits = cacheAfter.hits - cacheBefore.hits;
+    summary.cacheMisses = cacheAfter.misses - cacheBefore.misses;
+
+    summary.p50Micros = BatchRunner::percentile(latencies, 0.50);
+    summary.p99Micros = BatchRunner::percentile(latencies, 0.99);
+    summary.maxMicros = latencies.empty() ? 0.0 : latencies.back();
+    return summary;
+}
+
+void BatchGrader::Summary::print(std::ostream& out) const {
+    const double mib = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    out << std::fixed << std::setprecision(1)
+        << "Graded " << submissions << " submissions (" << passed << " passed, " << failed << " failed, "
+        << errors << " errors) on " << threads << " thread(s)\n"
+        << "  wall time " << std::setprecision(3) << seconds << " s, " << std::setprecision(1)
+        << submissionsPerSecond() << " submissions/s, " << (seconds > 0.0 ? mib / seconds : 0.0) << " MiB/s\n"
+        << "  latency p50 " << p50Micros << " us, p99 " << p99Micros << " us, max " << maxMicros << " us\n"
+        << "  validation cache " << cacheHits << " hits, " << cacheMisses << " misses\n";
+}
+
+std::optional<BatchGrader::Options> BatchGrader::parseOptions(const std::vector<std::string>& args) {
+    Options options;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--format" && hasValue) {
+            const std::string& value = args[++i];
+            if (value == "csv") {
+                options.format = Format::Csv;
+            } else if (value == "jsonl") {
+                options.format = Format::JsonLines;
+            } else {
+                std::cerr << "Error: Unknown report format '" << value << "' (expected csv or jsonl)" << std::endl;
+                return std::nullopt;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            std::istringstream value(args[++i]);
+            if (!(value >> options.threads) || options.threads == 0) {
+                std::cerr << "Error: --threads expects a positive number" << std::endl;
+                return std::nullopt;
+            }
+        } else if (arg == "--output" && hasValue) {
+            options.outputPath = args[++i];
+        } else if (options.directory.empty() && !arg.empty() && arg[0] != '-') {
+            options.directory = arg;
+        } else {
+            std::cerr << "Error: Unexpected argument '" << arg << "'" << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    if (options.directory.empty()) {
+        std::cerr << "Error: --grade needs a submissions directory" << std::endl;
+        return std::nullopt;
+    }
+    return options;
+}
+
+void BatchGrader::printUsage(std::ostream& out) {
+    out << "Usage: cpp-code-quest --grade <dir> [--format csv|jsonl] [--threads N] [--output FILE] [--catalog FILE] [--rules FILE] [--cache FILE] [--compile]\n"
+        << "  Grades every file under <dir>; the first number in each file name is its level.\n"
+        << "  One report row per submission goes to FILE (default stdout), the summary to stderr.\n"
+        << "  --catalog FILE grades against the levels in FILE instead of the built-in ones.\n"
+        << "  --rules FILE replaces level validators with \"levelN = <rule>\" lines from FILE.\n"
+        << "  --cache FILE loads validation results from FILE if it exists and saves them back.\n"
+        << "  --compile also compiles and runs each submission ($CXX, default c++) and compares\n"
+        << "  its output with the level's reference solution.\n";
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+class GameEngine;
+
+/**
+ * Headless grading of submission files (`cpp-code-quest --grade <dir>`).
+ *
+ * Every regular file under the directory is one submission. Its level is
+ * the first number in the file name (level3_alice.cpp -> level 3). Files are
+ * handed to a pool of worker threads through a shared atomic cursor, each
+ * result row is written to the report as soon as it is ready, and the
+ * summary collects throughput and latency percentiles.
+ */
+class BatchGrader {
+public:
+    enum class Format {
+        Csv,
+        JsonLines
+    };
+
+    struct Options {
+        std::string directory;
+        Format format = Format::Csv;
+        size_t threads = 0;         // 0 = one per hardware thread
+        std::string outputPath;     // empty = stdout
+    };
+
+    struct Summary {
+        size_t submissions = 0;
+        size_t passed = 0;
+        size_t failed = 0;
+        size_t errors = 0;          // unreadable files or no valid level number
+        size_t bytes = 0;
+        size_t threads = 0;
+        double seconds = 0.0;
+        double p50Micros = 0.0;     // per-submission read + validate latency
+        double p99Micros = 0.0;
+        double maxMicros = 0.0;
+        size_t cacheHits = 0;       // validation cache, during this run only
+        size_t cacheMisses = 0;
+
+        double submissionsPerSecond() const { return seconds > 0.0 ? static_cast<double>(submissions) / seconds : 0.0; }
+        void print(std::ostream& out) const;
+    };
+
+    explicit BatchGrader(const GameEngine& engine) : engine_(engine) {}
+
+    // Grades every file under options.directory and writes one row per file
+    // to `report`. Returns nullopt if the directory cannot be listed.
+    std::optional<Summary> run(const Options& options, std::ostream& report) const;
+
+    // Parses the arguments that follow --grade; nullopt (with a message on
+    // stderr) on bad usage
+    static std::optional<Options> parseOptions(const std::vector<std::string>& args);
+    static void printUsage(std::ostream& out);
+
+private:
+    const GameEngine& engine_;
+};
@@ -0,0 +1,551 @@
+#include "CompileRunner.hpp"
+#include "../utils/FileUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define CQ_COMPILE_RUN_POSIX 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Status = CompileRunner::Status;
+
+// Included into every submission through the precompiled header
+constexpr const char* kPreludeHeaders[] = {
+    "algorithm", "array", "functional", "iostream", "map", "memory", "optional",
+    "string", "string_view", "tuple", "type_traits", "unordered_map", "utility", "vector",
+};
+
+std::string_view trimTrailingSpace(std::string_view text) {
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' ||
+                             text.back() == '\n' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+double microsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+} // namespace
+
+#if defined(CQ_COMPILE_RUN_POSIX)
+
+namespace {
+
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;    // a dead peer is an error, not SIGPIPE
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+bool sendAll(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t sent = ::send(fd, p, size, kSendFlags);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool receiveAll(int fd, void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        const ssize_t received = ::recv(fd, p, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        p += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool sendString(int fd, std::string_view text) {
+    const std::uint64_t length = text.size();
+    return sendAll(fd, &length, sizeof(length)) && sendAll(fd, text.data(), text.size());
+}
+
+bool receiveString(int fd, std::string& text) {
+    std::uint64_t length = 0;
+    if (!receiveAll(fd, &length, sizeof(length))) {
+        return false;
+    }
+    text.resize(length);
+    return receiveAll(fd, text.data(), text.size());
+}
+
+// Worker -> pool reply; both ends are the same binary
+struct ReplyHeader {
+    Status status;
+    double compileMicros;
+    double runMicros;
+};
+
+bool sendResult(int fd, const CompileRunner::Result& result) {
+    const ReplyHeader header{result.status, result.compileMicros, result.runMicros};
+    return sendAll(fd, &header, sizeof(header)) && sendString(fd, result.output) &&
+           sendString(fd, result.message);
+}
+
+bool receiveResult(int fd, CompileRunner::Result& result) {
+    ReplyHeader header{};
+    if (!receiveAll(fd, &header, sizeof(header))) {
+        return false;
+    }
+    result.status = header.status;
+    result.compileMicros = header.compileMicros;
+    result.runMicros = header.runMicros;
+    return receiveString(fd, result.output) && receiveString(fd, result.message);
+}
+
+void setCloseOnExec(int fd) {
+    ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+struct ChildLimits {
+    unsigned cpuSeconds = 0;
+    unsigned wallSeconds = 0;
+    size_t addressBytes = 0;    // 0 = unlimited
+    bool sandboxed = false;     // empty environment, no file writes, few descriptors
+    bool captureStderr = false; // capture stderr instead of stdout
+    size_t outputBytes = 0;
+};
+
+struct ChildOutcome {
+    int status = 0;
+    bool started = false;
+    bool timedOut = false;
+    bool overflowed = false;
+    std::string output;
+};
+
+// The resource type differs between C libraries (int or an enum)
+template<typename Resource>
+void setLimit(Resource resource, rlim_t value) {
+    rlimit limit{value, value};
+    ::setrlimit(resource, &limit);
+}
+
+// Runs args[0] in `directory` in its own process group, collecting one
+// output stream up to limits.outputBytes and killing the group on timeout
+ChildOutcome runChild(const std::vector<std::string>& args, const std::string& directory, const ChildLimits& limits) {
+    ChildOutcome outcome;
+
+    // Everything the child needs is prepared before fork
+    std::vector<char*> argv;
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    char* emptyEnvironment[] = {nullptr};
+
+    int pipeFds[2];
+    if (::pipe(pipeFds) != 0) {
+        return outcome;
+    }
+    setCloseOnExec(pipeFds[0]);
+    setCloseOnExec(pipeFds[1]);
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        ::setpgid(0, 0);
+        const int devNull = ::open("/dev/null", O_RDWR | O_CLOEXEC);
+        ::dup2(devNull, STDIN_FILENO);
+        ::dup2(pipeFds[1], limits.captureStderr ? STDERR_FILENO : STDOUT_FILENO);
+        ::dup2(devNull, limits.captureStderr ? STDOUT_FILENO : STDERR_FILENO);
+        if (::chdir(directory.c_str()) != 0) {
+            ::_exit(126);
+        }
+
+        if (limits.cpuSeconds) {
+            rlimit cpu{limits.cpuSeconds, limits.cpuSeconds + 1};
+            ::setrlimit(RLIMIT_CPU, &cpu);
+        }
+        if (limits.addressBytes) {
+            setLimit(RLIMIT_AS, limits.addressBytes);
+        }
+        setLimit(RLIMIT_CORE, 0);
+        if (limits.sandboxed) {
+            setLimit(RLIMIT_FSIZE, 0);
+            setLimit(RLIMIT_NOFILE, 16);
+            ::execve(argv[0], argv.data(), emptyEnvironment);
+        } else {
+            ::execvp(argv[0], argv.data());
+        }
+        ::_exit(127);
+    }
+
+    ::close(pipeFds[1]);
+    if (pid < 0) {
+        ::close(pipeFds[0]);
+        return outcome;
+    }
+    ::setpgid(pid, pid);    // also from this side, so the kill below never races the child
+    outcome.started = true;
+
+    const auto deadline = Clock::now() + std::chrono::seconds(limits.wallSeconds);
+    auto killGroup = [pid] {
+        ::kill(-pid, SIGKILL);
+        ::kill(pid, SIGKILL);
+    };
+
+    char buffer[4096];
+    pollfd readable{pipeFds[0], POLLIN, 0};
+    bool killed = false;
+    while (!killed) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        const int ready = left > 0 ? ::poll(&readable, 1, static_cast<int>(left)) : 0;
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready == 0) {
+            outcome.timedOut = killed = true;
+            killGroup();
+            break;
+        }
+        const ssize_t count = ::read(pipeFds[0], buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        const size_t room = limits.outputBytes - outcome.output.size();
+        outcome.output.append(buffer, std::min(room, static_cast<size_t>(count)));
+        if (static_cast<size_t>(count) > room) {
+            outcome.overflowed = killed = true;
+            killGroup();
+        }
+    }
+    ::close(pipeFds[0]);
+
+    // stdout closed, but the process may still be running
+    int status = 0;
+    for (;;) {
+        const pid_t done = ::waitpid(pid, &status, killed ? 0 : WNOHANG);
+        if (done == pid || (done < 0 && errno != EINTR)) {
+            break;
+        }
+        if (done == 0 && Clock::now() >= deadline) {
+            outcome.timedOut = killed = true;
+            killGroup();
+        } else if (done == 0) {
+            ::usleep(1000);
+        }
+    }
+    outcome.status = status;
+    return outcome;
+}
+
+std::string describeExit(int status) {
+    if (WIFSIGNALED(status)) {
+        return "terminated by signal " + std::to_string(WTERMSIG(status));
+    }
+    return "exit code " + std::to_string(WEXITSTATUS(status));
+}
+
+bool exitedCleanly(const ChildOutcome& outcome) {
+    return outcome.started && !outcome.timedOut && !outcome.overflowed &&
+           WIFEXITED(outcome.status) && WEXITSTATUS(outcome.status) == 0;
+}
+
+std::vector<std::string> compilerCommand(const CompileRunner::Options& options) {
+    std::vector<std::string> command{options.compiler};
+    command.insert(command.end(), options.compilerArgs.begin(), options.compilerArgs.end());
+    command.insert(command.end(), {"-std=" + options.standard, "-O0", "-w", "-fdiagnostics-color=never"});
+    return command;
+}
+
+// One request in a worker: compile main.cpp, then run the binary
+CompileRunner::Result compileAndRun(const std::string& source, const std::string& directory,
+                                    const CompileRunner::Options& options, const std::string& prelude) {
+    CompileRunner::Result result;
+    if (!GameUtils::FileUtils::write_file(directory + "/main.cpp", source)) {
+        result.message = "could not write the submission";
+        return result;
+    }
+    ::unlink((directory + "/submission").c_str());
+
+    auto command = compilerCommand(options);
+    if (!prelude.empty()) {
+        command.insert(command.end(), {"-include", prelude});
+    }
+    command.insert(command.end(), {"main.cpp", "-o", "submission"});
+
+    ChildLimits compileLimits;
+    compileLimits.cpuSeconds = options.compileSeconds;
+    compileLimits.wallSeconds = options.compileSeconds;
+    compileLimits.captureStderr = true;
+    compileLimits.outputBytes = options.outputBytes;
+
+    auto start = Clock::now();
+    const ChildOutcome compiled = runChild(command, directory, compileLimits);
+    result.compileMicros = microsSince(start);
+    if (!exitedCleanly(compiled)) {
+        result.status = compiled.timedOut ? Status::TimedOut : Status::CompileError;
+        result.output = compiled.output;
+        result.message = compiled.timedOut ? "compiler timed out" : "compilation failed (" + describeExit(compiled.status) + ")";
+        return result;
+    }
+
+    ChildLimits runLimits;
+    runLimits.cpuSeconds = options.runSeconds;
+    runLimits.wallSeconds = options.runSeconds + 1;
+    runLimits.addressBytes = options.memoryBytes;
+    runLimits.sandboxed = true;
+    runLimits.outputBytes = options.outputBytes;
+
+    start = Clock::now();
+    ChildOutcome ran = runChild({directory + "/submission"}, directory, runLimits);
+    result.runMicros = microsSince(start);
+    result.output = std::move(ran.output);
+
+    const bool cpuExceeded = WIFSIGNALED(ran.status) && (WTERMSIG(ran.status) == SIGXCPU || WTERMSIG(ran.status) == SIGKILL);
+    if (ran.timedOut || (cpuExceeded && !ran.overflowed)) {
+        result.status = Status::TimedOut;
+        result.message = "time limit of " + std::to_string(options.runSeconds) + " s exceeded";
+    } else if (ran.overflowed) {
+        result.status = Status::RuntimeError;
+        result.message = "more than " + std::to_string(options.outputBytes) + " bytes of output";
+    } else if (!exitedCleanly(ran)) {
+        result.status = Status::RuntimeError;
+        result.message = ran.started ? describeExit(ran.status) : "could not start the program";
+    } else {
+        result.status = Status::Passed;
+    }
+    return result;
+}
+
+[[noreturn]] void workerMain(int channel, const std::string& directory, const CompileRunner::Options& options,
+                             const std::string& prelude) {
+    for (std::string source;;) {
+        if (!receiveString(channel, source)) {
+            ::_exit(0);
+        }
+        if (!sendResult(channel, compileAndRun(source, directory, options, prelude))) {
+            ::_exit(0);
+        }
+    }
+}
+
+} // namespace
+
+CompileRunner::CompileRunner(Options options) : options_(std::move(options)) {
+    std::string pattern = (fs::temp_directory_path() / "cpp-code-quest-XXXXXX").string();
+    if (!::mkdtemp(pattern.data())) {
+        std::cerr << "Error: Could not create a compile directory: " << std::strerror(errno) << std::endl;
+        return;
+    }
+    workDir_ = pattern;
+
+    // The compiler must work at all before any worker is started
+    ChildLimits limits;
+    limits.cpuSeconds = options_.compileSeconds;
+    limits.wallSeconds = options_.compileSeconds;
+    limits.captureStderr = true;
+    limits.outputBytes = options_.outputBytes;
+    auto probe = compilerCommand(options_);
+    probe.resize(1 + options_.compilerArgs.size());
+    probe.push_back("--version");
+    if (!exitedCleanly(runChild(probe, workDir_, limits))) {
+        std::cerr << "Error: Compiler '" << options_.compilerCommand() << "' is not available" << std::endl;
+        return;
+    }
+
+    if (options_.precompiledHeader) {
+        std::string prelude;
+        for (const char* header : kPreludeHeaders) {
+            prelude += std::string("#include <") + header + ">\n";
+        }
+        auto command = compilerCommand(options_);
+        command.insert(command.end(), {"-x", "c++-header", "prelude.hpp", "-o", "prelude.hpp.gch"});
+        pchReady_ = GameUtils::FileUtils::write_file(workDir_ + "/prelude.hpp", prelude) &&
+                    exitedCleanly(runChild(command, workDir_, limits));
+    }
+
+    startWorkers();
+}
+
+void CompileRunner::startWorkers() {
+    const std::string prelude = pchReady_ ? workDir_ + "/prelude.hpp" : "";
+    for (size_t i = 0; i < options_.workers; ++i) {
+        const std::string directory = workDir_ + "/worker" + std::to_string(i);
+        std::error_code error;
+        fs::create_directory(directory, error);
+
+        int fds[2];
+        if (error || ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            break;
+        }
+        setCloseOnExec(fds[0]);
+        setCloseOnExec(fds[1]);
+
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::close(fds[0]);
+            for (const Worker& worker : workers_) {
+                ::close(worker.channel);
+            }
+            workerMain(fds[1], directory, options_, prelude);
+        }
+        ::close(fds[1]);
+        if (pid < 0) {
+            ::close(fds[0]);
+            break;
+        }
+        idle_.push_back(workers_.size());
+        workers_.push_back({fds[0], pid});
+    }
+    liveWorkers_ = workers_.size();
+}
+
+CompileRunner::~CompileRunner() {
+    // Closing a channel makes its worker exit after the current request
+    for (const Worker& worker : workers_) {
+        ::close(worker.channel);
+    }
+    for (const Worker& worker : workers_) {
+        int status = 0;
+        while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+        }
+    }
+    if (!workDir_.empty()) {
+        std::error_code error;
+        fs::remove_all(workDir_, error);
+    }
+}
+
+CompileRunner::Result CompileRunner::execute(std::string_view source) {
+    Result result;
+    size_t index = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        workerFreed_.wait(lock, [&] { return !idle_.empty() || liveWorkers_ == 0; });
+        if (idle_.empty()) {
+            result.message = "no compile worker is running";
+            return result;
+        }
+        index = idle_.back();
+        idle_.pop_back();
+    }
+
+    const int channel = workers_[index].channel;
+    const bool answered = sendString(channel, source) && receiveResult(channel, result);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (answered) {
+            idle_.push_back(index);
+        } else {
+            --liveWorkers_;     // never handed out again
+        }
+    }
+    workerFreed_.notify_all();
+
+    if (!answered) {
+        result = Result();
+        result.message = "compile worker stopped unexpectedly";
+    }
+    return result;
+}
+
+bool CompileRunner::isSupported() {
+    return true;
+}
+
+#else // !CQ_COMPILE_RUN_POSIX
+
+CompileRunner::CompileRunner(Options options) : options_(std::move(options)) {}
+
+CompileRunner::~CompileRunner() = default;
+
+void CompileRunner::startWorkers() {}
+
+CompileRunner::Result CompileRunner::execute(std::string_view) {
+    Result result;
+    result.message = "compile-and-run validation needs a POSIX system";
+    return result;
+}
+
+bool CompileRunner::isSupported() {
+    return false;
+}
+
+#endif // CQ_COMPILE_RUN_POSIX
+
+void CompileRunner::Options::setCompilerCommand(std::string_view command) {
+    std::vector<std::string> words;
+    size_t pos = 0;
+    while (true) {
+        pos = command.find_first_not_of(" \t\n", pos);
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        const size_t end = std::min(command.find_first_of(" \t\n", pos), command.size());
+        words.emplace_back(command.substr(pos, end - pos));
+        pos = end;
+    }
+    if (words.empty()) {
+        return;
+    }
+    compiler = std::move(words.front());
+    compilerArgs.assign(std::make_move_iterator(words.begin() + 1), std::make_move_iterator(words.end()));
+}
+
+std::string CompileRunner::Options::compilerCommand() const {
+    std::string command = compiler;
+    for (const auto& arg : compilerArgs) {
+        command += ' ' + arg;
+    }
+    return command;
+}
+
+CompileRunner::CompileRunner() : CompileRunner(Options()) {}
+
+CompileRunner::Result CompileRunner::run(std::string_view source, std::string_view expectedOutput) {
+    Result result = execute(source);
+    if (result.status == Status::Passed && trimTrailingSpace(result.output) != trimTrailingSpace(expectedOutput)) {
+        result.status = Status::WrongOutput;
+        result.message = "output differs from the expected output";
+    }
+    return result;
+}
+
+const char* CompileRunner::statusName(Status status) {
+    switch (status) {
+        case Status::Passed: return "passed";
+        case Status::WrongOutput: return "wrong output";
+        case Status::CompileError: return "compile error";
+        case Status::RuntimeError: return "runtime error";
+        case Status::TimedOut: return "timed out";
+        case Status::Unavailable: return "unavailable";
+    }
+    return "unknown";
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Compile-and-run validation backend with a pool of pre-forked workers.
+ *
+ * The constructor builds a precompiled header of the common standard headers
+ * in a private temporary directory and then forks the worker processes, each
+ * connected to the pool by a socket pair. A submission is sent to an idle
+ * worker, which compiles it against the PCH and runs the binary with rlimits
+ * (CPU time, address space, no file writes, few descriptors), /dev/null as
+ * stdin, an empty environment and its own process group, killed after a
+ * wall-clock timeout. Only stdout comes back.
+ *
+ * Workers fork straight from the constructing process, catalog and cache
+ * and all, so build the pool before starting any threads: a child forked
+ * while another thread holds a lock would deadlock on it. The limits
+ * keep honest mistakes (infinite loops, runaway allocations, output floods)
+ * contained; they are not a security boundary for hostile code.
+ *
+ * POSIX only: elsewhere ready() is false and every call is Unavailable.
+ */
+class CompileRunner {
+public:
+    struct Options {
+        std::string compiler = "c++";
+        std::vector<std::string> compilerArgs;      // passed before the runner's own flags
+        std::string standard = "c++17";
+        size_t workers = 2;
+        unsigned compileSeconds = 30;
+        unsigned runSeconds = 2;
+        size_t memoryBytes = 512u * 1024 * 1024;   // address space of the program
+        size_t outputBytes = 64 * 1024;             // stdout (or diagnostics) kept
+        bool precompiledHeader = true;
+
+        // Sets compiler and compilerArgs from a command such as $CXX
+        // ("ccache g++", "g++ -m64"), split on whitespace without quoting.
+        // A blank command keeps the defaults.
+        void setCompilerCommand(std::string_view command);
+        // The compiler and its arguments as one line, for messages and keys
+        std::string compilerCommand() const;
+    };
+
+    enum class Status : std::uint8_t {
+        Passed,         // compiled, ran, and printed the expected output
+        WrongOutput,
+        CompileError,
+        RuntimeError,   // non-zero exit, signal, or too much output
+        TimedOut,
+        Unavailable     // no pool, or the worker died
+    };
+
+    struct Result {
+        Status status = Status::Unavailable;
+        std::string output;         // program stdout, or compiler diagnostics
+        std::string message;        // why it did not pass; empty when it did
+        double compileMicros = 0.0;
+        double runMicros = 0.0;
+    };
+
+    CompileRunner();
+    explicit CompileRunner(Options options);
+    ~CompileRunner();
+
+    CompileRunner(const CompileRunner&) = delete;
+    CompileRunner& operator=(const CompileRunner&) = delete;
+
+    // False when the pool could not start (no fork, no compiler, ...)
+    bool ready() const { return liveWorkers_ > 0; }
+    bool usesPrecompiledHeader() const { return pchReady_; }
+    const Options& options() const { return options_; }
+
+    // Compiles and runs `source`; Passed means it exited cleanly (output
+    // is not compared). Thread-safe; blocks until a worker is free.
+    Result execute(std::string_view source);
+
+    // execute() plus a comparison of stdout with `expectedOutput`, ignoring
+    // trailing whitespace
+    Result run(std::string_view source, std::string_view expectedOutput);
+
+    static bool isSupported();
+    static const char* statusName(Status status);
+
+private:
+    struct Worker {
+        int channel;    // parent end of the socket pair
+        int pid;
+    };
+
+    Options options_;
+    std::string workDir_;
+    bool pchReady_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable workerFreed_;
+    std::vector<Worker> workers_;
+    std::vector<size_t> idle_;          // indices into workers_
+    std::atomic<size_t> liveWorkers_{0};
+
+    void startWorkers();
+};
@@ -1,152 +1,123 @@
 #include "GameEngine.hpp"
+#include "../utils/InputReader.hpp"
+#include "../utils/Renderer.hpp"
 #include "../utils/StringUtils.hpp"
-#include "../utils/FileUtils.hpp"
 #include <iostream>
 #include <algorithm>
-#include <thread>
 #include <chrono>
+#include <stdexcept>
 
-GameEngine::GameEngine() : currentLevel_(0) {
-    initializeLevels();
+GameEngine::GameEngine() : GameEngine(InputReader::standardInput(), Renderer::standardOutput()) {}
+
+GameEngine::GameEngine(InputReader& input, Renderer& output)
+    : GameEngine(input, output, LevelSet::builtin()) {}
+
+GameEngine::GameEngine(InputReader& input, Renderer& output, std::shared_ptr<const LevelSet> levels)
+    : currentLevel_(0), input_(&input), output_(&output) {
+    useLevels(std::move(levels));
 }
 
 void GameEngine::run() {
+    // Reads block inside the awaits, so the game never suspends
+    auto game = play();
+    game.start();
+    if (!game.done()) {
+        throw std::logic_error("GameEngine::run() needs an input reader with a source");
+    }
+    game.result();
+}
+
+Task<> GameEngine::play() {
     showWelcome();
+    co_await waitForInput();
     
     while (!isGameComplete()) {
-        playLevel(currentLevel_);
+        co_await playLevel(currentLevel_);
         
-        if (currentLevel_ < levels_.size()) {
-            std::cout << "\n🎯 Progress: " << getProgressPercentage() << "%\n";
+        if (currentLevel_ < levels_->size()) {
+            *output_ << "\n🎯 Progress: " << getProgressPercentage() << "%\n";
             showInventory();
             
-            if (askYesNo("Continue to next level?")) {
+            const bool next = co_await askYesNo("Continue to next level?");
+            if (next) {
                 currentLevel_++;
                 clearScreen();
             } else {
-                std::cout << "💾 Game saved! Thanks for playing!\n";
-                return;
+                *output_ << "💾 Game saved! Thanks for playing!\n";
+                output_->drain();
+                co_return;
             }
         }
     }
     
     showVictory();
+    output_->drain();
 }
 
-void GameEngine::initializeLevels() {
-    // Level 1: Temple of Auto
-    levels_.push_back(std::make_unique<Level>(
-        "The Temple of Auto",
-        "🏛️ You enter an ancient temple where the Oracle of Types dwells. "
-        "The walls are covered with cryptic C++ symbols, and the air shimmers with template magic.",
-        "🔮 Oracle of Types",
-        "Welcome, young programmer! The age of verbose type declarations is ending. "
-        "I shall teach you the power of 'auto' - let the compiler deduce types for you!",
-        "Auto Type Deduction (C++14)",
-        "The 'auto' keyword lets the compiler automatically deduce variable types. "
-        "C++14 extended this to function return types and lambda parameters.",
-        "Create variables using auto and show a generic lambda with auto parameters.",
-        "📜 Auto Deduction Scroll",
-        [](const std::string& code) {
-            return StringUtils::containsAll(code, {"auto", "lambda", "[]"}) ||
-                   StringUtils::containsAll(code, {"auto", "[", "auto"});
-        }
-    ));
-    
-    // Level 2: Lambda Sanctuary
-    levels_.push_back(std::make_unique<Level>(
-        "The Lambda Sanctuary",
-        "🌟 Deep in the Lambda Sanctuary, you find a mysterious altar surrounded by floating code fragments. "
-        "The Guardian of Closures materializes before you.",
-        "👻 Guardian of Closures",
-        "Ah, a seeker of functional wisdom! Lambdas are the soul of modern C++. "
-        "Show me you understand capture by value, reference, and generalized capture!",
-        "Advanced Lambdas (C++14)",
-        "C++14 introduced generalized capture (init capture) allowing you to move variables into lambdas.",
-        "Create a lambda with generalized capture that moves a unique_ptr.",
-        "🏅 Lambda Mastery Badge",
-        [](const std::string& code) {
-            return StringUtils::containsAll(code, {"auto", "std::move", "unique_ptr"}) ||
-                   StringUtils::contains(code, "= std::move");
-        }
-    ));
-    
-    // Level 3: Smart Pointer Forge
-    levels_.push_back(std::make_unique<Level>(
-        "The Smart Pointer Forge",
-        "🔨 You arrive at an ancient forge where Smart Pointers are crafted. "
-        "The Master Smith challenges you to prove your worth.",
-        "🧙‍♂️ Master Smith",
-        "Raw pointers are the bane of C++! Here we craft smart pointers that manage memory automatically. "
-        "Show me you can wield unique_ptr, shared_ptr, and make_unique!",
-        "Smart Pointers & make_unique (C++14)",
-        "C++14 introduced std::make_unique. Smart pointers automatically manage memory.",
-        "Create and use smart pointers with make_unique and make_shared.",
-        "🛡️ Memory Guardian Shield",
-        [](const std::string& code) {
-            return StringUtils::containsAll(code, {"make_unique", "make_shared"}) ||
-                   StringUtils::contains(code, "std::make_unique");
-        }
-    ));
-    
-    // Level 4: Valley of Move Semantics
-    levels_.push_back(std::make_unique<Level>(
-        "The Valley of Move Semantics",
-        "🏔️ In the Valley of Move Semantics, you encounter the Spirit of Efficiency. "
-        "Ancient runes speak of perfect forwarding and std::forward.",
-        "⚡ Spirit of Efficiency",
-        "Performance is everything! Learn to move resources instead of copying them. "
-        "Master std::move, std::forward, and perfect forwarding!",
-        "Move Semantics & Perfect Forwarding (C++14/17)",
-        "Move semantics transfer resources instead of copying. Perfect forwarding preserves value categories.",
-        "Implement a function template with perfect forwarding using std::forward.",
-        "🚀 Move Semantics Mastery",
-        [](const std::string& code) {
-            return StringUtils::containsAll(code, {"std::forward", "&&"}) ||
-                   StringUtils::containsAll(code, {"forward", "template"});
-        }
-    ));
-    
-    // Level 5: Citadel of Structured Bindings
-    levels_.push_back(std::make_unique<Level>(
-        "The Citadel of Structured Bindings",
-        "🏰 At the peak of your journey, you reach the Citadel of Structured Bindings. "
-        "The C++17 Archmaster awaits with the most modern features.",
-        "👑 C++17 Archmaster",
-        "Welcome to the pinnacle of modern C++! Here we unpack tuples, decompose pairs, "
-        "and use structured bindings with elegant syntax!",
-        "Modern C++17 Features",
-        "C++17 introduced structured bindings, if constexpr, and fold expressions.",
-        "Use structured bindings to unpack a pair and if constexpr for compile-time conditionals.",
-        "👑 C++17 Grandmaster Crown",
-        [](const std::string& code) {
-            return StringUtils::containsAll(code, {"auto [", "] ="}) ||
-                   StringUtils::contains(code, "if constexpr");
-        }
-    ));
+void GameEngine::recordInput(const std::string& path) {
+    recorder_.reset();
+    recorder_ = std::make_unique<SessionRecorder>(*input_, path);
 }
 
-void GameEngine::playLevel(size_t levelIndex) {
-    if (levelIndex >= levels_.size()) {
-        return;
+bool GameEngine::loadCatalog(const std::string& path) {
+    const auto catalog = LevelCatalog::load(path);
+    if (!catalog) {
+        return false;
+    }
+    // A fresh set, without the compile pool: its checks were built for the
+    // old levels' solutions
+    auto levels = LevelSet::create(*catalog, path);
+    if (!levels) {
+        return false;
+    }
+    useLevels(std::move(levels));
+    return true;
+}
+
+bool GameEngine::loadValidationRules(const std::string& path) {
+    auto levels = std::make_shared<LevelSet>(*levels_);
+    if (!levels->applyValidationRules(path)) {
+        return false;
+    }
+    levels_ = std::move(levels);
+    return true;
+}
+
+bool GameEngine::enableCompileAndRun(const CompileRunner::Options& options) {
+    auto levels = std::make_shared<LevelSet>(*levels_);
+    if (!levels->enableCompileAndRun(options)) {
+        return false;
+    }
+    levels_ = std::move(levels);
+    return true;
+}
+
+void GameEngine::useLevels(std::shared_ptr<const LevelSet> levels) {
+    levels_ = std::move(levels);
+    completed_.assign(levels_->size(), false);
+    inventory_.clear();     // ids belong to the old catalog's rewards
+    currentLevel_ = 0;
+}
+
+Task<> GameEngine::playLevel(size_t levelIndex) {
+    if (levelIndex >= levels_->size()) {
+        co_return;
     }
     
-    auto& level = levels_[levelIndex];
-    level->play();
+    const Level& level = getLevel(levelIndex);
+    const bool completed = co_await level.play(*input_, *output_);
     
-    if (level->isCompleted()) {
-        addToInventory(level->getReward());
-        std::cout << "\n🎉 Level completed! You earned: " << level->getReward() << "\n";
-        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    if (completed) {
+        completed_[levelIndex] = true;
+        addToInventory(getCatalog().rewardOf(levelIndex));
+        auto& out = *output_;
+        out << "\n🎉 Level completed! You earned: " << level.getReward() << "\n";
+        out.pause(std::chrono::milliseconds(1500));
     }
 }
 
 bool GameEngine::isGameComplete() const {
-    return currentLevel_ >= levels_.size();
-}
-
-void GameEngine::addToInventory(const std::string& item) {
-    inventory_.push_back(item);
+    return currentLevel_ >= levels_->size();
 }
 
 void GameEngine::showInventory() const {
@@ -154,19 +125,18 @@ void GameEngine::showInventory() const {
         return;
     }
     
-    std::cout << "\n🛠️ Your C++ Arsenal:\n";
-    for (const auto& item : inventory_) {
-        std::cout << "  ✨ " << item << "\n";
-    }
+    auto& out = *output_;
+    out << "\n🛠️ Your C++ Arsenal:\n";
+    inventory_.forEach([&](Inventory::ItemId item) { out << "  ✨ " << getCatalog().rewardName(item) << "\n"; });
 }
 
 double GameEngine::getProgressPercentage() const {
-    if (levels_.empty()) return 0.0;
-    return (static_cast<double>(currentLevel_) / levels_.size()) * 100.0;
+    if (levels_->size() == 0) return 0.0;
+    return (static_cast<double>(currentLevel_) / levels_->size()) * 100.0;
 }
 
 void GameEngine::showWelcome() const {
-    std::cout << R"(
+    *output_ << R"(
     🏰⚔️ C++ CODE QUEST ⚔️🏰
     ═══════════════════════════
     
@@ -184,11 +154,11 @@ void GameEngine::showWelcome() const {
     Your quest begins now...
     
 )";
-    waitForInput();
 }
 
 void GameEngine::showVictory() const {
-    std::cout << R"(
+    auto& out = *output_;
+    out << R"(
     🏆 CONGRATULATIONS! 🏆
     ═══════════════════════
     
@@ -197,11 +167,9 @@ void GameEngine::showVictory() const {
     Your Arsenal:
 )";
     
-    for (const auto& item : inventory_) {
-        std::cout << "    ✨ " << item << "\n";
-    }
+    inventory_.forEach([&](Inventory::ItemId item) { out << "    ✨ " << getCatalog().rewardName(item) << "\n"; });
     
-    std::cout << R"(
+    out << R"(
     You've mastered the advanced concepts of modern C++!
     Now go forth and build amazing applications!
     
@@ -212,24 +180,25 @@ void GameEngine::showVictory() const {
 
 void GameEngine::clearScreen() const {
     // Simple screen clearing (works on most terminals)
-    std::cout << "\033[2J\033[1;1H";
+    *output_ << "\033[2J\033[1;1H";
 }
 
-void GameEngine::waitForInput() const {
-    std::cout << "Press Enter to continue...";
-    std::cin.ignore();
+Task<> GameEngine::waitForInput() const {
+    *output_ << "Press Enter to continue...";
+    std::string ignored;
+    co_await input_->line(ignored);
 }
 
-bool GameEngine::askYesNo(const std::string& question) const {
+Task<bool> GameEngine::askYesNo(const std::string& question) const {
     std::string response;
-    std::cout << question << " (y/n): ";
-    std::getline(std::cin, response);
-    return !response.empty() && (response[0] == 'y' || response[0] == 'Y');
+    *output_ << question << " (y/n): ";
+    co_await input_->line(response);
+    co_return !response.empty() && (response[0] == 'y' || response[0] == 'Y');
 }
 
-std::string GameEngine::getUserInput(const std::string& prompt) const {
+Task<std::string> GameEngine::getUserInput(const std::string& prompt) const {
     std::string input;
-    std::cout << prompt;
-    std::getline(std::cin, input);
-    return input;
+    *output_ << prompt;
+    co_await input_->line(input);
+    co_return input;
 }
\ No newline at end of file
@@ -1,26 +1,79 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include "Level.hpp"
+#include "LevelCatalog.hpp"
+#include "LevelSet.hpp"
+#include "SessionLog.hpp"
+#include "CompileRunner.hpp"
+#include "ValidationCache.hpp"
+#include "../utils/InputReader.hpp"
+#include "../utils/Inventory.hpp"
+#include "../utils/Renderer.hpp"
+#include "../utils/Task.hpp"
 
 class GameEngine {
 public:
+    // Plays the built-in levels on stdin/stdout
     GameEngine();
+    // Plays the built-in levels through `input` and `output`, which must
+    // outlive the engine
+    GameEngine(InputReader& input, Renderer& output);
+    // Plays `levels`, shared with any other engine; the engine itself keeps
+    // only the player's progress
+    GameEngine(InputReader& input, Renderer& output, std::shared_ptr<const LevelSet> levels);
     ~GameEngine() = default;
     
-    // Core game loop
+    // Core game loop. play() suspends while a fed reader waits for the
+    // player; run() plays to the end on a reader with a source.
     void run();
+    Task<> play();
+
+    // Records everything the player types from now on, with timestamps,
+    // and saves it as a SessionLog to `path` when the engine is destroyed
+    void recordInput(const std::string& path);
     
     // Level management
-    void initializeLevels();
-    void playLevel(size_t levelIndex);
+    Task<> playLevel(size_t levelIndex);
     bool isGameComplete() const;
+    size_t getLevelCount() const { return levels_->size(); }
+    const Level& getLevel(size_t index) const { return (*levels_)[index]; }
+    bool isLevelCompleted(size_t index) const { return completed_[index]; }
+
+    // By catalog id; nullptr if there is none
+    const Level* findLevel(std::uint32_t id) const { return levels_->find(id); }
+
+    // What this engine plays, to hand to further engines
+    const std::shared_ptr<const LevelSet>& getLevels() const { return levels_; }
+
+    // The calls below edit a copy of the levels and switch to it, leaving
+    // other engines as they were. Make them before play starts.
+
+    // Replaces every level with those of a catalog file (the default is
+    // compiled in) and restarts from the first. All-or-nothing, reporting
+    // on stderr. Drops compile-and-run checks, so call it first.
+    bool loadCatalog(const std::string& path);
+    const LevelCatalog& getCatalog() const { return levels_->catalog(); }
+
+    // Replaces level validators with rules from a "levelN = <rule>" file.
+    // All-or-nothing: on any error nothing changes and false is returned.
+    bool loadValidationRules(const std::string& path);
+
+    // Makes every level also compile and run solutions, comparing stdout with
+    // the reference solution's. Reports on stderr and changes nothing if the
+    // pool or any reference solution fails. Call before starting threads.
+    bool enableCompileAndRun(const CompileRunner::Options& options);
+
+    // Shared by every level whose validator is a ValidationRule with token()
+    // predicates or a compile check, and by every engine sharing the levels
+    ValidationCache& getValidationCache() const { return levels_->validationCache(); }
     
-    // Player progress
-    void addToInventory(const std::string& item);
+    // Player progress. Items are the catalog's reward ids.
+    void addToInventory(Inventory::ItemId item) { inventory_.add(item); }
+    const Inventory& getInventory() const { return inventory_; }
     void showInventory() const;
     double getProgressPercentage() const;
     
@@ -30,12 +83,17 @@ public:
     void clearScreen() const;
     
 private:
-    std::vector<std::unique_ptr<Level>> levels_;
-    std::vector<std::string> inventory_;
+    std::shared_ptr<const LevelSet> levels_;
+    std::vector<bool> completed_;                   // per level, in catalog order
+    Inventory inventory_;
     size_t currentLevel_;
+    InputReader* input_;
+    Renderer* output_;
+    std::unique_ptr<SessionRecorder> recorder_;
     
     // Helper methods
-    void waitForInput() const;
-    bool askYesNo(const std::string& question) const;
-    std::string getUserInput(const std::string& prompt) const;
+    void useLevels(std::shared_ptr<const LevelSet> levels);
+    Task<> waitForInput() const;
+    Task<bool> askYesNo(const std::string& question) const;
+    Task<std::string> getUserInput(const std::string& prompt) const;
 };
\ No newline at end of file
@@ -0,0 +1,446 @@
+#include "GameServer.hpp"
+#include "../utils/SocketAddress.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define CQ_SERVER_EPOLL 1
+#endif
+
+namespace {
+
+#ifdef CQ_SERVER_EPOLL
+size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+double cpuSeconds() {
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    const auto seconds = [](const timeval& t) {
+        return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_usec) / 1e6;
+    };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+#endif
+
+// Typed lines are short; a small block keeps idle sessions small. Answers
+// to prompts are a word or two, so a long line is dropped early.
+InputReader::Options sessionInput() {
+    InputReader::Options options;
+    options.blockSize = 4096;
+    options.maxLineBytes = 4096;
+    return options;
+}
+
+// Typed-ahead input kept while the game is busy; past this the socket is
+// left unread, so a flooding client waits in its own send buffer
+constexpr size_t kMaxUnreadInput = 64 * 1024;
+
+} // namespace
+
+struct GameServer::Session {
+    Session(int socket, std::uint64_t id)
+        : fd(socket), serial(id), input(sessionInput()),
+          output([this](std::string_view frame) {
+              if (!peerGone) {
+                  sending += frame;
+              }
+          }) {}
+
+    const int fd;
+    const std::uint64_t serial;
+
+    // The game's streams: the loop feeds `input`, and `output` collects
+    // frames in `sending`. No waiter, so draining never blocks the loop.
+    InputReader input;
+    Renderer output;
+    std::unique_ptr<GameEngine> engine;
+    std::optional<Task<>> game;     // destroyed before the engine it runs on
+    bool finished = false;
+
+    std::string sending;
+    size_t sent = 0;
+    Renderer::Clock::time_point timer = Renderer::Clock::time_point::max();
+    std::uint32_t events = 0;       // epoll interest
+    bool registered = false;
+    bool readClosed = false;        // the player sent EOF
+    bool peerGone = false;          // the socket failed; output is dropped
+};
+
+double GameServer::Stats::sessionsPerCpuSecond() const {
+    return cpuSeconds > 0.0 ? static_cast<double>(sessionsServed) / cpuSeconds : 0.0;
+}
+
+size_t GameServer::Stats::bytesPerSession() const {
+    if (peakSessions == 0 || peakRssBytes < baselineRssBytes) {
+        return 0;
+    }
+    return (peakRssBytes - baselineRssBytes) / peakSessions;
+}
+
+void GameServer::Stats::print(std::ostream& out) const {
+    out << "Sessions served: " << sessionsServed << " (" << peakSessions << " at once)\n"
+        << "CPU time: " << cpuSeconds << " s, " << sessionsPerCpuSecond() << " sessions per CPU second\n"
+        << "Resident memory: " << baselineRssBytes / 1024 << " KiB idle, " << peakRssBytes / 1024
+        << " KiB peak, ~" << bytesPerSession() / 1024 << " KiB per session\n";
+}
+
+GameServer::GameServer(Options options, EngineFactory factory)
+    : options_(std::move(options)), factory_(std::move(factory)) {}
+
+GameServer::~GameServer() {
+    closeAll();
+#ifdef CQ_SERVER_EPOLL
+    for (const int fd : {listenFd_, epollFd_, wakeFd_}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    if (boundAddress_.rfind("unix:", 0) == 0) {
+        ::unlink(boundAddress_.c_str() + 5);
+    }
+#endif
+}
+
+bool GameServer::start() {
+#ifdef CQ_SERVER_EPOLL
+    std::string error;
+    const auto address = SocketAddress::parse(options_.address, error);
+    if (!address) {
+        std::cerr << "Error: " << error << std::endl;
+        return false;
+    }
+    listenFd_ = address->listen(SOMAXCONN);
+    if (listenFd_ < 0) {
+        std::cerr << "Error: Could not listen on " << address->text() << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    boundAddress_ = SocketAddress::boundTo(listenFd_);
+
+    epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        std::cerr << "Error: Could not create the event loop: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    for (const int fd : {listenFd_, wakeFd_}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event);
+    }
+    stats_.baselineRssBytes = residentBytes();
+    return true;
+#else
+    std::cerr << "Error: --serve needs Linux (epoll)" << std::endl;
+    return false;
+#endif
+}
+
+void GameServer::stop() {
+    stopping_.store(true);
+#ifdef CQ_SERVER_EPOLL
+    if (wakeFd_ >= 0) {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = ::write(wakeFd_, &one, sizeof(one));
+    }
+#endif
+}
+
+void GameServer::run() {
+#ifdef CQ_SERVER_EPOLL
+    const double cpuAtStart = cpuSeconds();
+    epoll_event events[64];
+
+    while (!(stopping_.load() && sessions_.empty())) {
+        if (stopping_.load() && listenFd_ >= 0) {
+            // New players are refused; current ones see end of input and
+            // their games wind down
+            ::close(listenFd_);
+            listenFd_ = -1;
+            std::vector<int> open;
+            for (const auto& [fd, session] : sessions_) {
+                open.push_back(fd);
+            }
+            for (const int fd : open) {
+                Session& session = *sessions_.at(fd);
+                session.input.closeInput();
+                settle(session);
+            }
+            continue;
+        }
+
+        const int count = ::epoll_wait(epollFd_, events, 64, pollTimeout());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error: epoll_wait: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wakeFd_) {
+                std::uint64_t wakes = 0;
+                [[maybe_unused]] const auto got = ::read(wakeFd_, &wakes, sizeof(wakes));
+                continue;
+            }
+            if (fd == listenFd_) {
+                acceptSessions();
+                continue;
+            }
+            const auto it = sessions_.find(fd);
+            if (it == sessions_.end()) {
+                continue;
+            }
+            Session& session = *it->second;
+            const std::uint32_t ready = events[i].events;
+            // A hangup after EOF means both directions are closed
+            if ((ready & EPOLLERR) || ((ready & EPOLLHUP) && session.readClosed)) {
+                session.peerGone = true;
+                session.input.closeInput();
+                settle(session);
+                continue;
+            }
+            if (ready & EPOLLOUT) {
+                send(session);
+            }
+            if (ready & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+                receive(session);
+            }
+            settle(session);
+        }
+        expireTimers();
+    }
+
+    closeAll();
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    stats_.peakRssBytes = static_cast<size_t>(usage.ru_maxrss) * 1024;
+    stats_.cpuSeconds = cpuSeconds() - cpuAtStart;
+#endif
+}
+
+void GameServer::acceptSessions() {
+#ifdef CQ_SERVER_EPOLL
+    while (sessions_.size() < options_.maxSessions) {
+        const int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "Error: accept: " << std::strerror(errno) << std::endl;
+            }
+            break;
+        }
+
+        auto owned = std::make_unique<Session>(fd, nextSerial_++);
+        Session& session = *owned;
+        sessions_.emplace(fd, std::move(owned));
+        ++stats_.sessionsServed;
+        stats_.peakSessions = std::max(stats_.peakSessions, sessions_.size());
+
+        session.output.setPacing(options_.pacing);
+        try {
+            session.engine = factory_(session.input, session.output);
+            if (session.engine) {
+                session.game.emplace(session.engine->play());
+                session.game->start();     // up to the first prompt
+            }
+        } catch (const std::exception& e) {
+            session.output << "❌ Game Error: " << e.what() << "\n";
+            session.game.reset();
+        }
+        settle(session);
+    }
+    if (sessions_.size() >= options_.maxSessions) {
+        setAccepting(false);
+    }
+#endif
+}
+
+void GameServer::receive(Session& session) {
+#ifdef CQ_SERVER_EPOLL
+    // One read per wakeup; epoll is level-triggered, so the rest comes next
+    // round and a fast sender cannot starve the others
+    char buffer[16 * 1024];
+    const ssize_t count = ::recv(session.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (count > 0) {
+        // Typing ahead ends a pause, as on the terminal
+        session.output.drain();
+        session.input.feed(std::string_view(buffer, static_cast<size_t>(count)));
+    } else if (count == 0) {
+        session.readClosed = true;
+        session.input.closeInput();
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        session.peerGone = true;
+        session.input.closeInput();
+    }
+#else
+    (void)session;
+#endif
+}
+
+void GameServer::send(Session& session) {
+#ifdef CQ_SERVER_EPOLL
+    while (session.sent < session.sending.size()) {
+        const ssize_t count = ::send(session.fd, session.sending.data() + session.sent,
+                                     session.sending.size() - session.sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (count > 0) {
+            session.sent += static_cast<size_t>(count);
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                session.peerGone = true;
+                session.input.closeInput();
+            }
+            return;
+        }
+    }
+    session.sending.clear();
+    session.sent = 0;
+#else
+    (void)session;
+#endif
+}
+
+void GameServer::settle(Session& session) {
+    if (!session.finished && (!session.game || session.game->done())) {
+        if (session.game) {
+            try {
+                session.game->result();
+            } catch (const std::exception& e) {
+                session.output << "❌ Game Error: " << e.what() << "\n";
+            }
+        }
+        session.finished = true;
+        session.output.drain();
+    } else if (!session.finished) {
+        // The game awaits input: show the prompt, or queue it behind a pause
+        session.output.present();
+        const auto deadline = session.output.nextDeadline();
+        if (deadline != Renderer::Clock::time_point::max() && deadline != session.timer) {
+            timers_.push(Timer{deadline, session.fd, session.serial});
+            session.timer = deadline;
+        }
+    }
+    if (session.peerGone) {
+        session.sending.clear();
+        session.sent = 0;
+    }
+    send(session);
+    watch(session);
+}
+
+void GameServer::expireTimers() {
+    const auto now = Renderer::Clock::now();
+    while (!timers_.empty() && timers_.top().at <= now) {
+        const Timer timer = timers_.top();
+        timers_.pop();
+        const auto it = sessions_.find(timer.fd);
+        if (it == sessions_.end() || it->second->serial != timer.serial || it->second->timer != timer.at) {
+            continue;
+        }
+        Session& session = *it->second;
+        session.timer = Renderer::Clock::time_point::max();
+        session.output.pump(now);
+        settle(session);
+    }
+}
+
+int GameServer::pollTimeout() const {
+    if (timers_.empty()) {
+        return -1;
+    }
+    const auto left = std::chrono::ceil<std::chrono::milliseconds>(timers_.top().at - Renderer::Clock::now());
+    return static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(left.count(), 0, 60 * 1000));
+}
+
+void GameServer::watch(Session& session) {
+#ifdef CQ_SERVER_EPOLL
+    if (session.finished && (session.sending.empty() || session.peerGone)) {
+        closeSession(session.fd);
+        return;
+    }
+
+    // A waiting game bounds what its reader holds; otherwise input only
+    // piles up, and a finished game reads none
+    const bool reading = !session.readClosed && !session.finished &&
+                         (session.input.waiting() || session.input.buffered() < kMaxUnreadInput);
+    std::uint32_t wanted = 0;
+    if (!session.peerGone) {
+        wanted = (reading ? EPOLLIN | EPOLLRDHUP : 0u) | (session.sending.empty() ? 0u : EPOLLOUT);
+    }
+    if (session.peerGone && session.registered) {
+        ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, session.fd, nullptr);
+        session.registered = false;
+    } else if (!session.peerGone && (!session.registered || wanted != session.events)) {
+        epoll_event event{};
+        event.events = wanted;
+        event.data.fd = session.fd;
+        ::epoll_ctl(epollFd_, session.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, session.fd, &event);
+        session.registered = true;
+    }
+    session.events = wanted;
+#else
+    (void)session;
+#endif
+}
+
+void GameServer::closeSession(int fd) {
+#ifdef CQ_SERVER_EPOLL
+    const auto it = sessions_.find(fd);
+    if (it == sessions_.end()) {
+        return;
+    }
+    ::close(fd);
+    sessions_.erase(it);
+    if (!accepting_ && sessions_.size() < options_.maxSessions) {
+        setAccepting(true);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+void GameServer::closeAll() {
+#ifdef CQ_SERVER_EPOLL
+    for (const auto& [fd, session] : sessions_) {
+        ::close(fd);
+    }
+#endif
+    sessions_.clear();
+}
+
+void GameServer::setAccepting(bool accepting) {
+#ifdef CQ_SERVER_EPOLL
+    if (accepting == accepting_ || listenFd_ < 0) {
+        return;
+    }
+    // Waiting connections stay in the kernel's backlog meanwhile
+    epoll_event event{};
+    event.events = accepting ? EPOLLIN : 0u;
+    event.data.fd = listenFd_;
+    ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, listenFd_, &event);
+    accepting_ = accepting;
+#else
+    (void)accepting;
+#endif
+}
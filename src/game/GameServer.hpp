@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GameEngine.hpp"
+#include "../utils/InputReader.hpp"
+#include "../utils/Renderer.hpp"
+
+/**
+ * Serves one game per connection over a TCP or Unix socket.
+ *
+ * Everything runs on the thread that calls run(). A single epoll loop
+ * accepts connections, feeds what players type to their session's
+ * InputReader and sends what the session's Renderer writes. Each game is a
+ * coroutine (GameEngine::play()). Feeding input resumes it, and it runs
+ * until it awaits the player's next line. An idle session costs its
+ * coroutine frames and buffers, not a thread. Pauses between story screens
+ * are timers in the same loop, and a player who types ahead skips them.
+ *
+ * Linux only (epoll, eventfd); start() reports an error elsewhere.
+ */
+class GameServer {
+public:
+    // Builds a session's engine; nullptr ends the session after sending what
+    // was written to `output`. `input` and `output` outlive the engine.
+    using EngineFactory = std::function<std::unique_ptr<GameEngine>(InputReader& input, Renderer& output)>;
+
+    struct Options {
+        std::string address;            // see SocketAddress
+        size_t maxSessions = 1024;      // further connections wait in the backlog
+        bool pacing = true;             // keep the pauses between story screens
+    };
+
+    struct Stats {
+        size_t sessionsServed = 0;
+        size_t peakSessions = 0;        // open at the same time
+        double cpuSeconds = 0.0;        // user + system, whole process, while running
+        size_t baselineRssBytes = 0;    // resident after start()
+        size_t peakRssBytes = 0;        // highest resident size while running
+
+        double sessionsPerCpuSecond() const;
+        size_t bytesPerSession() const;
+        void print(std::ostream& out) const;
+    };
+
+    GameServer(Options options, EngineFactory factory);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Binds and listens; reports on stderr
+    bool start();
+
+    // Serves until stop(); then ends every session as if its player had
+    // disconnected, sends what the games print and returns
+    void run();
+
+    // Safe from any thread and from signal handlers
+    void stop();
+
+    // Where start() is listening, e.g. with the port tcp:0 picked
+    const std::string& boundAddress() const { return boundAddress_; }
+
+    // Complete once run() has returned
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Session;
+
+    // A session's pause ends; stale once the session moved on or closed
+    struct Timer {
+        Renderer::Clock::time_point at;
+        int fd;
+        std::uint64_t serial;
+        bool operator>(const Timer& other) const { return at > other.at; }
+    };
+
+    Options options_;
+    EngineFactory factory_;
+    int listenFd_ = -1;
+    int epollFd_ = -1;
+    int wakeFd_ = -1;           // eventfd written by stop()
+    std::string boundAddress_;
+    std::unordered_map<int, std::unique_ptr<Session>> sessions_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    std::uint64_t nextSerial_ = 0;
+    bool accepting_ = true;
+    std::atomic<bool> stopping_{false};
+    Stats stats_;
+
+    void acceptSessions();
+    void receive(Session& session);
+    void send(Session& session);
+    void expireTimers();
+    int pollTimeout() const;
+
+    // After the game ran: schedules its pause, sends its output and closes
+    // the session once the game is over and everything is sent
+    void settle(Session& session);
+    void watch(Session& session);
+    void closeSession(int fd);
+    void closeAll();
+    void setAccepting(bool accepting);
+};
@@ -1,234 +1,155 @@
 #include "Level.hpp"
+#include "CompileRunner.hpp"
+#include "ValidationCache.hpp"
+#include "ValidationRule.hpp"
+#include "../utils/InputReader.hpp"
+#include "../utils/Renderer.hpp"
 #include "../utils/StringUtils.hpp"
-#include <iostream>
-#include <thread>
 #include <chrono>
 
-Level::Level(const std::string& title,
-             const std::string& story,
-             const std::string& character,
-             const std::string& dialogue,
-             const std::string& conceptName,
-             const std::string& conceptExplanation,
-             const std::string& challenge,
-             const std::string& reward,
-             ValidationFunction validator)
-    : title_(title), story_(story), character_(character), dialogue_(dialogue),
-      concept_(conceptName), conceptExplanation_(conceptExplanation), challenge_(challenge),
-      reward_(reward), validator_(validator), completed_(false) {}
+Level::Level(const LevelCatalog::Entry& content, ValidationRule rule)
+    : content_(content), validator_(std::move(rule)) {}
 
-void Level::play() {
-    displayStory();
-    displayConcept();
-    showChallenge();
+Level::Level(const LevelCatalog::Entry& content, ValidationFunction validator)
+    : content_(content), validator_(std::move(validator)) {}
+
+Task<bool> Level::play(InputReader& input, Renderer& out) const {
+    displayStory(out);
+    displayConcept(out);
+    showChallenge(out);
     
     int attempts = 0;
     const int maxAttempts = 3;
     
-    while (attempts < maxAttempts && !completed_) {
-        std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << "⚔️ Attempt " << (attempts + 1) << "/" << maxAttempts << "\n";
-        std::cout << std::string(50, '=') << "\n";
+    while (attempts < maxAttempts) {
+        out << "\n";
+        out.rule(50, "=") << "⚔️ Attempt " << (attempts + 1) << "/" << maxAttempts << "\n";
+        out.rule(50, "=");
         
-        std::string userCode = getUserCode();
+        const Submission submission = co_await getUserCode(input, out);
+        // The streamed rule verdict is final unless a passing solution must
+        // still compile and run
+        const bool passed = submission.ruleVerdict && !(*submission.ruleVerdict && runner_)
+                                ? *submission.ruleVerdict
+                                : validateSolution(submission.code);
         
-        if (validateSolution(userCode)) {
-            showFeedback(true, "🎉 Excellent! You've mastered " + concept_ + "!");
-            completed_ = true;
-            return;
+        if (passed) {
+            showFeedback(out, true, "🎉 Excellent! You've mastered " + std::string(content_.conceptName) + "!");
+            co_return true;
         } else {
             attempts++;
             if (attempts < maxAttempts) {
-                showFeedback(false, "🔧 Not quite right. Try again!");
+                showFeedback(out, false, "🔧 Not quite right. Try again!");
                 
-                std::cout << "\nWould you like:\n";
-                std::cout << "1. Try again\n";
-                std::cout << "2. Get a hint\n";
-                std::cout << "3. See the solution\n";
-                std::cout << "Choose (1-3): ";
+                out << "\nWould you like:\n"
+                    << "1. Try again\n"
+                    << "2. Get a hint\n"
+                    << "3. See the solution\n"
+                    << "Choose (1-3): ";
                 
                 std::string choice;
-                std::getline(std::cin, choice);
+                co_await input.line(choice);
                 
                 if (choice == "2") {
-                    showHint();
+                    showHint(out);
                 } else if (choice == "3") {
-                    showSolution();
-                    completed_ = true;
-                    return;
+                    showSolution(out);
+                    co_return true;
                 }
             } else {
-                showFeedback(false, "🤔 Don't worry! Let's see the solution.");
-                showSolution();
-                completed_ = true;
+                showFeedback(out, false, "🤔 Don't worry! Let's see the solution.");
+                showSolution(out);
             }
         }
     }
+    co_return true;
 }
 
-void Level::displayStory() const {
-    std::cout << "\n" << std::string(60, '═') << "\n";
-    std::cout << "📖 " << title_ << "\n";
-    std::cout << std::string(60, '═') << "\n";
-    std::cout << story_ << "\n\n";
-    std::cout << character_ << ": \"" << dialogue_ << "\"\n";
-    std::cout << std::string(60, '═') << "\n";
+void Level::displayStory(Renderer& out) const {
+    out << "\n";
+    out.rule(60, "═") << "📖 " << content_.title << "\n";
+    out.rule(60, "═") << content_.story << "\n\n";
+    out << content_.character << ": \"" << content_.dialogue << "\"\n";
+    out.rule(60, "═");
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-}
-
-void Level::displayConcept() const {
-    std::cout << "\n🧠 C++ Concept: " << concept_ << "\n";
-    std::cout << std::string(50, '-') << "\n";
-    std::cout << conceptExplanation_ << "\n";
+    // Time to read the story before the lesson follows
+    out.pause(std::chrono::milliseconds(1000));
 }
 
-void Level::showChallenge() const {
-    std::cout << "\n⚔️ Your Challenge:\n";
-    std::cout << std::string(30, '-') << "\n";
-    std::cout << challenge_ << "\n";
+void Level::displayConcept(Renderer& out) const {
+    out << "\n🧠 C++ Concept: " << content_.conceptName << "\n";
+    out.rule(50, "-") << content_.explanation << "\n";
 }
 
-void Level::showHint() const {
-    std::cout << "\n💡 Hint: " << getHintText() << "\n";
+void Level::showChallenge(Renderer& out) const {
+    out << "\n⚔️ Your Challenge:\n";
+    out.rule(30, "-") << content_.challenge << "\n";
 }
 
-void Level::showSolution() const {
-    std::cout << "\n🔍 Solution:\n";
-    std::cout << std::string(30, '-') << "\n";
-    std::cout << getSolutionText() << "\n";
+void Level::showHint(Renderer& out) const {
+    out << "\n💡 Hint: " << content_.hint << "\n";
 }
 
-bool Level::validateSolution(const std::string& code) const {
-    return validator_(code);
+void Level::showSolution(Renderer& out) const {
+    out << "\n🔍 Solution:\n";
+    out.rule(30, "-") << getSolutionText() << "\n";
 }
 
-std::string Level::getUserCode() const {
-    std::cout << "\n📝 Enter your C++ code (type 'DONE' on a new line when finished):\n";
-    std::cout << std::string(50, '-') << "\n";
-    
-    std::string code;
-    std::string line;
-    
-    while (std::getline(std::cin, line) && line != "DONE") {
-        code += line + "\n";
+bool Level::validateSolution(std::string_view code) const {
+    auto check = [this](std::string_view text) {
+        return matchesValidator(text) &&
+               (!runner_ || runner_->run(text, expectedOutput_).status == CompileRunner::Status::Passed);
+    };
+    if (cache_) {
+        // Whitespace inside string literals changes what a program prints,
+        // and a contains() text with a space in it can see re-spacing
+        const auto* rule = getRule();
+        const bool exact = runner_ || !rule || rule->dependsOnWhitespace();
+        return cache_->validate(cacheKey_, code, check,
+                                exact ? ValidationCache::Keying::Exact : ValidationCache::Keying::Normalized);
     }
-    
-    return code;
-}
-
-void Level::showFeedback(bool success, const std::string& message) const {
-    std::cout << "\n" << std::string(40, (success ? '✨' : '🔧')) << "\n";
-    std::cout << message << "\n";
-    std::cout << std::string(40, (success ? '✨' : '🔧')) << "\n";
+    return check(code);
 }
 
-std::string Level::getHintText() const {
-    if (title_ == "The Temple of Auto") {
-        return "Use 'auto' for variable declarations and create a lambda like: auto lambda = [](auto x) { return x * 2; };";
-    } else if (title_ == "The Lambda Sanctuary") {
-        return "Use generalized capture: [p = std::move(ptr)](auto x) { return *p * x; }";
-    } else if (title_ == "The Smart Pointer Forge") {
-        return "Use std::make_unique<int>(42) and std::make_shared<string>(\"Hello\")";
-    } else if (title_ == "The Valley of Move Semantics") {
-        return "Create a template function with T&& parameter and use std::forward<T>(arg)";
-    } else if (title_ == "The Citadel of Structured Bindings") {
-        return "Use auto [a, b] = std::make_pair(42, \"Hello\"); and if constexpr (condition)";
+Task<Level::Submission> Level::getUserCode(InputReader& input, Renderer& out) const {
+    out << "\n📝 Enter your C++ code (type 'DONE' on a new line when finished):\n";
+    out.rule(50, "-");
+    
+    // Rules are checked as lines arrive, with feedback whenever the count
+    // of criteria met changes
+    std::optional<ValidationRule::Session> session;
+    InputReader::LineCallback onLine;
+    size_t shown = 0;
+    if (const auto* rule = getRule()) {
+        session.emplace(*rule);
+        onLine = [&](std::string_view code) {
+            session->advance(code);
+            const auto progress = session->progress();
+            if (progress.met != shown) {
+                shown = progress.met;
+                out << "   ✓ criteria met " << progress.met << "/" << progress.total << "\n";
+            }
+        };
     }
-    return "Think about the modern C++ features introduced in C++14/17!";
-}
-
-std::string Level::getSolutionText() const {
-    if (title_ == "The Temple of Auto") {
-        return R"(#include <iostream>
-#include <string>
-
-int main() {
-    auto number = 42;
-    auto text = "Hello C++14";
-    auto lambda = [](auto x) { return x * 2; };
-    auto result = lambda(5);
-    
-    std::cout << "Number: " << number << std::endl;
-    std::cout << "Text: " << text << std::endl;
-    std::cout << "Lambda result: " << result << std::endl;
-    
-    return 0;
-})";
-    } else if (title_ == "The Lambda Sanctuary") {
-        return R"(#include <iostream>
-#include <memory>
 
-int main() {
-    auto ptr = std::make_unique<int>(42);
-    auto lambda = [p = std::move(ptr)](auto multiplier) {
-        return *p * multiplier;
-    };
-    auto result = lambda(3);
-    
-    std::cout << "Result: " << result << std::endl;
-    
-    return 0;
-})";
-    } else if (title_ == "The Smart Pointer Forge") {
-        return R"(#include <iostream>
-#include <memory>
-#include <string>
-
-int main() {
-    auto unique = std::make_unique<int>(42);
-    auto shared1 = std::make_shared<std::string>("Hello");
-    auto shared2 = shared1; // shared ownership
-    
-    std::cout << *unique << " " << *shared1 << std::endl;
-    std::cout << "Shared count: " << shared1.use_count() << std::endl;
-    
-    return 0;
-})";
-    } else if (title_ == "The Valley of Move Semantics") {
-        return R"(#include <iostream>
-#include <utility>
-#include <string>
-
-template<typename T>
-auto wrapper(T&& arg) {
-    return std::forward<T>(arg);
-}
-
-int main() {
-    auto result = wrapper(std::string("moved"));
-    auto moved = std::move(result);
-    
-    std::cout << "Forwarded: " << moved << std::endl;
-    
-    return 0;
-})";
-    } else if (title_ == "The Citadel of Structured Bindings") {
-        return R"(#include <iostream>
-#include <utility>
-#include <type_traits>
-
-template<typename T>
-auto process(T value) {
-    if constexpr (std::is_integral_v<T>) {
-        return value * 2;
-    } else {
-        return value;
+    Submission submission;
+    const auto status = co_await input.submission(submission.code, "DONE", onLine);
+    if (status == InputReader::Status::TooLarge) {
+        out << "⚠️ Submissions are limited to " << input.options().maxSubmissionBytes / 1024
+                  << " KiB; that one was skipped.\n";
+        submission.ruleVerdict = false;
+        co_return submission;
     }
+    if (session) {
+        session->advance(submission.code);   // a last line without DONE
+        submission.ruleVerdict = session->matches();
+    }
+    co_return submission;
 }
 
-int main() {
-    auto pair = std::make_pair(42, "Hello");
-    auto [number, text] = pair;
-    
-    std::cout << "Number: " << number << std::endl;
-    std::cout << "Text: " << text << std::endl;
-    
-    auto processed = process(number);
-    std::cout << "Processed: " << processed << std::endl;
-    
-    return 0;
-})";
-    }
-    return "// Solution not available for this level";
-}
\ No newline at end of file
+void Level::showFeedback(Renderer& out, bool success, const std::string& message) const {
+    const std::string_view border = success ? "✨" : "🔧";
+    out << "\n";
+    out.rule(40, border) << message << "\n";
+    out.rule(40, border);
+}
@@ -1,60 +1,121 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
 #include <vector>
+#include "LevelCatalog.hpp"
+#include "ValidationRule.hpp"
+#include "../utils/Task.hpp"
+
+class CompileRunner;
+class InputReader;
+class Renderer;
+class ValidationCache;
 
 class Level {
 public:
-    using ValidationFunction = std::function<bool(const std::string&)>;
+    // Validators registered at runtime. A ValidationRule is stored as
+    // itself and called directly, with no type erasure.
+    using ValidationFunction = std::function<bool(std::string_view)>;
     
-    Level(const std::string& title,
-          const std::string& story,
-          const std::string& character,
-          const std::string& dialogue,
-          const std::string& conceptName,
-          const std::string& conceptExplanation,
-          const std::string& challenge,
-          const std::string& reward,
-          ValidationFunction validator);
+    // `content` views the catalog's text, which must outlive the level
+    Level(const LevelCatalog::Entry& content, ValidationRule rule);
+    Level(const LevelCatalog::Entry& content, ValidationFunction validator);
     
     ~Level() = default;
     
-    // Main level gameplay
-    void play();
+    // Main level gameplay, talking to the player through `input` and `out`.
+    // Suspends while a fed reader waits for the player's next line. Yields
+    // whether the level was completed; progress is the caller's to keep, so
+    // one Level can be played by many players at once.
+    Task<bool> play(InputReader& input, Renderer& out) const;
     
     // Getters
-    const std::string& getTitle() const { return title_; }
-    const std::string& getStory() const { return story_; }
-    const std::string& getReward() const { return reward_; }
-    const std::string& getConcept() const { return concept_; }
-    bool isCompleted() const { return completed_; }
+    std::uint32_t getId() const { return content_.id; }
+    std::string_view getTitle() const { return content_.title; }
+    std::string_view getStory() const { return content_.story; }
+    std::string_view getReward() const { return content_.reward; }
+    std::string_view getConcept() const { return content_.conceptName; }
     
     // Challenge management
-    void showChallenge() const;
-    void showHint() const;
-    void showSolution() const;
-    bool validateSolution(const std::string& code) const;
+    void showChallenge(Renderer& out) const;
+    void showHint(Renderer& out) const;
+    void showSolution(Renderer& out) const;
+    bool validateSolution(std::string_view code) const;
+
+    // Calls `visitor` with the validator itself, a ValidationRule or a
+    // ValidationFunction, without the cache or compile check. A loop over
+    // many submissions inside the visitor is compiled once per validator
+    // type instead of dispatching on every call.
+    template<typename Visitor>
+    decltype(auto) visitValidator(Visitor&& visitor) const {
+        return std::visit(std::forward<Visitor>(visitor), validator_);
+    }
+
+    // nullptr when the validator is a function
+    const ValidationRule* getRule() const { return std::get_if<ValidationRule>(&validator_); }
+
+    // Replacing the validator detaches the cache, whose keys describe the old one
+    void setValidator(ValidationRule rule) {
+        validator_ = std::move(rule);
+        cache_ = nullptr;
+    }
+    void setValidator(ValidationFunction validator) {
+        validator_ = std::move(validator);
+        cache_ = nullptr;
+    }
+
+    // Results are looked up under `levelKey`, which must identify this
+    // level's validator and compile check; pass nullptr to detach
+    void setValidationCache(ValidationCache* cache, std::uint64_t levelKey) {
+        cache_ = cache;
+        cacheKey_ = levelKey;
+    }
+
+    // Once set, a solution must also compile and print `expectedOutput`;
+    // the validator still runs first, so wrong answers never reach the
+    // compiler. Pass nullptr to remove the check.
+    void setCompileCheck(CompileRunner* runner, std::string expectedOutput) {
+        runner_ = runner;
+        expectedOutput_ = std::move(expectedOutput);
+        cache_ = nullptr;
+    }
+    bool hasCompileCheck() const { return runner_ != nullptr; }
+    const std::string& getExpectedOutput() const { return expectedOutput_; }
+
+    // The reference solution shown to players; its output is what the
+    // compile check expects
+    std::string_view getSolutionText() const { return content_.solution; }
     
 private:
-    std::string title_;
-    std::string story_;
-    std::string character_;
-    std::string dialogue_;
-    std::string concept_;
-    std::string conceptExplanation_;
-    std::string challenge_;
-    std::string reward_;
-    ValidationFunction validator_;
-    bool completed_;
+    LevelCatalog::Entry content_;
+    std::variant<ValidationRule, ValidationFunction> validator_;
+    ValidationCache* cache_ = nullptr;
+    std::uint64_t cacheKey_ = 0;
+    CompileRunner* runner_ = nullptr;
+    std::string expectedOutput_;
     
     // Helper methods
-    void displayStory() const;
-    void displayConcept() const;
-    std::string getUserCode() const;
-    void showFeedback(bool success, const std::string& message = "") const;
-    
-    // Default hints and solutions for each level
-    std::string getHintText() const;
-    std::string getSolutionText() const;
+    bool matchesValidator(std::string_view code) const {
+        if (const auto* rule = std::get_if<ValidationRule>(&validator_)) {
+            return rule->matches(code);
+        }
+        return std::get<ValidationFunction>(validator_)(code);
+    }
+    void displayStory(Renderer& out) const;
+    void displayConcept(Renderer& out) const;
+    // The typed code and, when the validator is a ValidationRule, its
+    // verdict, worked out line by line as the code arrived
+    struct Submission {
+        std::string code;
+        std::optional<bool> ruleVerdict;
+    };
+    Task<Submission> getUserCode(InputReader& input, Renderer& out) const;
+    void showFeedback(Renderer& out, bool success, const std::string& message = "") const;
+
 };
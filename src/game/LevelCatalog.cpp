@@ -0,0 +1,418 @@
+#include "LevelCatalog.hpp"
+#include "../utils/FileUtils.hpp"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CQ_CATALOG_MMAP 1
+#endif
+
+// Generated by CMake from assets/levels/default.catalog
+extern const unsigned char kDefaultCatalogData[];
+extern const std::size_t kDefaultCatalogSize;
+
+namespace {
+
+using Field = std::string_view LevelCatalog::Entry::*;
+
+struct FieldName {
+    std::string_view name;
+    Field field;
+};
+
+constexpr std::array<FieldName, 11> kFields = {{
+    {"title", &LevelCatalog::Entry::title},
+    {"story", &LevelCatalog::Entry::story},
+    {"character", &LevelCatalog::Entry::character},
+    {"dialogue", &LevelCatalog::Entry::dialogue},
+    {"concept", &LevelCatalog::Entry::conceptName},
+    {"explanation", &LevelCatalog::Entry::explanation},
+    {"challenge", &LevelCatalog::Entry::challenge},
+    {"reward", &LevelCatalog::Entry::reward},
+    {"hint", &LevelCatalog::Entry::hint},
+    {"solution", &LevelCatalog::Entry::solution},
+    {"rule", &LevelCatalog::Entry::rule},
+}};
+
+std::string_view trim(std::string_view text) {
+    const size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+// Line-at-a-time cursor that remembers line numbers for errors
+class LineCursor {
+public:
+    explicit LineCursor(std::string_view text) : text_(text) {}
+
+    bool next(std::string_view& line) {
+        if (pos_ >= text_.size()) {
+            return false;
+        }
+        lineStart_ = pos_;
+        const size_t newline = text_.find('\n', pos_);
+        const size_t end = newline == std::string_view::npos ? text_.size() : newline;
+        line = text_.substr(pos_, end - pos_);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        pos_ = end + 1;
+        ++number_;
+        return true;
+    }
+
+    size_t lineStart() const { return lineStart_; }
+    size_t number() const { return number_; }
+
+private:
+    std::string_view text_;
+    size_t pos_ = 0;
+    size_t lineStart_ = 0;
+    size_t number_ = 0;
+};
+
+bool fail(std::string& error, size_t line, const std::string& message) {
+    error = "line " + std::to_string(line) + ": " + message;
+    return false;
+}
+
+bool parseId(std::string_view header, std::uint32_t& id) {
+    // "[level <id>]"
+    if (header.size() < 9 || header.substr(0, 7) != "[level " || header.back() != ']') {
+        return false;
+    }
+    const std::string_view digits = trim(header.substr(7, header.size() - 8));
+    if (digits.empty() || digits.size() > 5 || digits.find_first_not_of("0123456789") != std::string_view::npos) {
+        return false;
+    }
+    id = 0;
+    for (char c : digits) {
+        id = id * 10 + static_cast<std::uint32_t>(c - '0');
+    }
+    return id >= 1 && id <= LevelCatalog::kMaxId;
+}
+
+constexpr std::string_view kPackMagic("CQLPACK\0", 8);
+constexpr std::uint32_t kPackVersion = 1;
+constexpr size_t kPackHeaderSize = 16;                          // magic, version, count
+constexpr size_t kPackRecordSize = 4 + kFields.size() * 8;      // id, offset/length pairs
+
+std::uint32_t readU32(std::string_view bytes, size_t at) {
+    std::uint32_t value = 0;
+    for (size_t i = 4; i-- > 0;) {
+        value = (value << 8) | static_cast<unsigned char>(bytes[at + i]);
+    }
+    return value;
+}
+
+void appendU32(std::string& out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out += static_cast<char>(value & 0xff);
+        value >>= 8;
+    }
+}
+
+// The whole file, read-only. The returned owner keeps `bytes` valid; a
+// mapped file must not be truncated while a catalog views it.
+std::shared_ptr<const void> mapFile(const std::string& path, std::string_view& bytes) {
+#ifdef CQ_CATALOG_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        const auto size = static_cast<size_t>(info.st_size);
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            ::close(fd);
+            bytes = std::string_view(static_cast<const char*>(data), size);
+            return std::shared_ptr<const void>(data, [size](const void* mapped) {
+                ::munmap(const_cast<void*>(mapped), size);
+            });
+        }
+    }
+    ::close(fd);
+#endif
+    // Empty files, pipes and platforms without mmap
+    auto text = GameUtils::FileUtils::read_file(path);
+    if (!text) {
+        return nullptr;
+    }
+    auto owned = std::make_shared<const std::string>(std::move(*text));
+    bytes = *owned;
+    return owned;
+}
+
+} // namespace
+
+std::optional<LevelCatalog> LevelCatalog::parse(std::string text, std::string& error) {
+    auto owned = std::make_shared<const std::string>(std::move(text));
+    auto catalog = parseView(*owned, error);
+    if (catalog) {
+        catalog->owned_ = std::move(owned);
+    }
+    return catalog;
+}
+
+std::optional<LevelCatalog> LevelCatalog::parsePack(std::string bytes, std::string& error) {
+    auto owned = std::make_shared<const std::string>(std::move(bytes));
+    auto catalog = parsePackView(*owned, error);
+    if (catalog) {
+        catalog->owned_ = std::move(owned);
+    }
+    return catalog;
+}
+
+bool LevelCatalog::isPack(std::string_view bytes) {
+    return bytes.substr(0, kPackMagic.size()) == kPackMagic;
+}
+
+std::optional<LevelCatalog> LevelCatalog::load(const std::string& path) {
+    std::string_view bytes;
+    auto file = mapFile(path, bytes);
+    if (!file) {
+        std::cerr << "Error: Could not read level catalog " << path << std::endl;
+        return std::nullopt;
+    }
+    std::string error;
+    auto catalog = isPack(bytes) ? parsePackView(bytes, error) : parseView(bytes, error);
+    if (!catalog) {
+        std::cerr << "Error: " << path << ": " << error << std::endl;
+        return std::nullopt;
+    }
+    catalog->owned_ = std::move(file);
+    return catalog;
+}
+
+const LevelCatalog& LevelCatalog::builtin() {
+    static const LevelCatalog catalog = [] {
+        std::string error;
+        auto parsed = parseView({reinterpret_cast<const char*>(kDefaultCatalogData), kDefaultCatalogSize}, error);
+        if (!parsed) {
+            // Shipped with the binary, so a mistake is a build problem
+            throw std::logic_error("default level catalog: " + error);
+        }
+        return std::move(*parsed);
+    }();
+    return catalog;
+}
+
+std::optional<LevelCatalog> LevelCatalog::parseView(std::string_view text, std::string& error) {
+    LevelCatalog catalog;
+    LineCursor cursor(text);
+    std::string_view line;
+    Entry* entry = nullptr;
+    std::uint16_t seen = 0;         // one bit per kFields entry
+    size_t entryLine = 0;
+
+    auto finishEntry = [&] {
+        if (!entry) {
+            return true;
+        }
+        for (size_t i = 0; i < kFields.size(); ++i) {
+            if (!(seen & (1u << i))) {
+                return fail(error, entryLine, "level " + std::to_string(entry->id) + " has no " +
+                                                  std::string(kFields[i].name));
+            }
+        }
+        return true;
+    };
+
+    while (cursor.next(line)) {
+        const std::string_view content = trim(line);
+        if (content.empty() || content[0] == '#') {
+            continue;
+        }
+
+        if (content[0] == '[') {
+            std::uint32_t id = 0;
+            if (!finishEntry()) {
+                return std::nullopt;
+            }
+            if (!parseId(content, id)) {
+                fail(error, cursor.number(), "expected [level <id>] with an id from 1 to " + std::to_string(kMaxId));
+                return std::nullopt;
+            }
+            if (id < catalog.slots_.size() && catalog.slots_[id]) {
+                fail(error, cursor.number(), "level " + std::to_string(id) + " is defined twice");
+                return std::nullopt;
+            }
+            if (id >= catalog.slots_.size()) {
+                catalog.slots_.resize(id + 1, 0);
+            }
+            catalog.entries_.emplace_back();
+            catalog.slots_[id] = static_cast<std::uint32_t>(catalog.entries_.size());
+            entry = &catalog.entries_.back();
+            entry->id = id;
+            seen = 0;
+            entryLine = cursor.number();
+            continue;
+        }
+
+        const size_t equals = content.find('=');
+        if (equals == std::string_view::npos) {
+            fail(error, cursor.number(), "expected name = value");
+            return std::nullopt;
+        }
+        if (!entry) {
+            fail(error, cursor.number(), "field before the first [level <id>]");
+            return std::nullopt;
+        }
+        const std::string_view name = trim(content.substr(0, equals));
+        const auto known = std::find_if(kFields.begin(), kFields.end(),
+                                        [&](const FieldName& field) { return field.name == name; });
+        if (known == kFields.end()) {
+            fail(error, cursor.number(), "unknown field '" + std::string(name) + "'");
+            return std::nullopt;
+        }
+        const auto bit = static_cast<std::uint16_t>(1u << (known - kFields.begin()));
+        if (seen & bit) {
+            fail(error, cursor.number(), "field '" + std::string(name) + "' given twice");
+            return std::nullopt;
+        }
+        seen |= bit;
+
+        std::string_view value = trim(content.substr(equals + 1));
+        if (value.size() > 2 && value.substr(0, 2) == "<<") {
+            // Block value: the lines between this one and the terminator
+            const std::string_view terminator = value.substr(2);
+            const size_t opened = cursor.number();
+            size_t begin = SIZE_MAX;
+            size_t end = 0;
+            bool closed = false;
+            while (cursor.next(line)) {
+                if (begin == SIZE_MAX) {
+                    begin = cursor.lineStart();
+                }
+                if (line == terminator) {
+                    end = cursor.lineStart();
+                    closed = true;
+                    break;
+                }
+            }
+            if (!closed) {
+                fail(error, opened, "no line '" + std::string(terminator) + "' ends the " + std::string(name));
+                return std::nullopt;
+            }
+            // Without the newline before the terminator (and its '\r')
+            value = text.substr(begin, end - begin);
+            if (!value.empty() && value.back() == '\n') {
+                value.remove_suffix(1);
+            }
+            if (!value.empty() && value.back() == '\r') {
+                value.remove_suffix(1);
+            }
+        }
+        entry->*(known->field) = value;
+    }
+    if (!finishEntry()) {
+        return std::nullopt;
+    }
+
+    // Play order is id order
+    std::sort(catalog.entries_.begin(), catalog.entries_.end(),
+              [](const Entry& a, const Entry& b) { return a.id < b.id; });
+    catalog.buildIndex();
+    return catalog;
+}
+
+std::optional<LevelCatalog> LevelCatalog::parsePackView(std::string_view bytes, std::string& error) {
+    if (!isPack(bytes) || bytes.size() < kPackHeaderSize) {
+        error = "not a level pack";
+        return std::nullopt;
+    }
+    const std::uint32_t version = readU32(bytes, 8);
+    if (version != kPackVersion) {
+        error = "pack version " + std::to_string(version) + " is not supported";
+        return std::nullopt;
+    }
+    const std::uint32_t count = readU32(bytes, 12);
+    if (count > (bytes.size() - kPackHeaderSize) / kPackRecordSize) {
+        error = "level table runs past the end of the pack";
+        return std::nullopt;
+    }
+    const size_t tableEnd = kPackHeaderSize + count * kPackRecordSize;
+
+    LevelCatalog catalog;
+    catalog.entries_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t record = kPackHeaderSize + i * kPackRecordSize;
+        Entry& entry = catalog.entries_[i];
+        entry.id = readU32(bytes, record);
+        if (entry.id == 0 || entry.id > kMaxId || (i > 0 && entry.id <= catalog.entries_[i - 1].id)) {
+            error = "level record " + std::to_string(i + 1) + ": id " + std::to_string(entry.id) +
+                    " is out of range or out of order";
+            return std::nullopt;
+        }
+        for (size_t f = 0; f < kFields.size(); ++f) {
+            const size_t offset = readU32(bytes, record + 4 + f * 8);
+            const size_t length = readU32(bytes, record + 8 + f * 8);
+            if (offset < tableEnd || offset > bytes.size() || length > bytes.size() - offset) {
+                error = "level " + std::to_string(entry.id) + ": " + std::string(kFields[f].name) +
+                        " lies outside the pack";
+                return std::nullopt;
+            }
+            entry.*(kFields[f].field) = bytes.substr(offset, length);
+        }
+    }
+    catalog.buildIndex();
+    return catalog;
+}
+
+std::string LevelCatalog::toPack() const {
+    const size_t tableEnd = kPackHeaderSize + entries_.size() * kPackRecordSize;
+    std::string table(kPackMagic);
+    appendU32(table, kPackVersion);
+    appendU32(table, static_cast<std::uint32_t>(entries_.size()));
+    std::string data;
+    for (const auto& entry : entries_) {
+        appendU32(table, entry.id);
+        for (const auto& field : kFields) {
+            const std::string_view value = entry.*(field.field);
+            if (tableEnd + data.size() + value.size() > UINT32_MAX) {
+                throw std::length_error("level pack larger than 4 GiB");
+            }
+            appendU32(table, static_cast<std::uint32_t>(tableEnd + data.size()));
+            appendU32(table, static_cast<std::uint32_t>(value.size()));
+            data += value;
+        }
+    }
+    return table + data;
+}
+
+void LevelCatalog::buildIndex() {
+    slots_.assign(entries_.empty() ? 0 : entries_.back().id + 1, 0);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        slots_[entries_[i].id] = static_cast<std::uint32_t>(i + 1);
+    }
+
+    rewards_.clear();
+    rewardIds_.clear();
+    std::unordered_map<std::string_view, std::uint32_t> interned;
+    for (const auto& entry : entries_) {
+        const auto [it, added] = interned.emplace(entry.reward, static_cast<std::uint32_t>(rewards_.size()));
+        if (added) {
+            rewards_.push_back(entry.reward);
+        }
+        rewardIds_.push_back(it->second);
+    }
+}
+
+std::optional<std::uint32_t> LevelCatalog::findReward(std::string_view name) const {
+    const auto it = std::find(rewards_.begin(), rewards_.end(), name);
+    if (it == rewards_.end()) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(it - rewards_.begin());
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Level content (story, dialogue, hint, reference solution and validation
+ * rule) parsed from a catalog file; see assets/levels/default.catalog for
+ * the format.
+ *
+ * The catalog keeps the file's text and every field is a view into it, so
+ * parsing copies nothing and solutions are handed out without allocating.
+ * Copies share the text. Levels are addressed by numeric id, and find() is
+ * one table lookup however many levels there are.
+ *
+ * builtin() is the catalog compiled into the binary from
+ * assets/levels/default.catalog; it borrows the embedded bytes.
+ *
+ * A catalog can also be stored as a binary pack (toPack(), written offline
+ * by the level-pack tool). load() maps either kind of file read-only and
+ * views it in place, so a pack costs one mmap and no text parsing, and every
+ * engine and process using the file shares one copy of its pages.
+ *
+ * Pack layout, all integers little-endian u32:
+ *   "CQLPACK\0", version, level count,
+ *   per level: id, then offset and length of each field in Entry order,
+ *   then the field bytes. Offsets are from the start of the file; records
+ *   are in ascending id order.
+ */
+class LevelCatalog {
+public:
+    struct Entry {
+        std::uint32_t id = 0;
+        std::string_view title;
+        std::string_view story;
+        std::string_view character;
+        std::string_view dialogue;
+        std::string_view conceptName;
+        std::string_view explanation;
+        std::string_view challenge;
+        std::string_view reward;
+        std::string_view hint;
+        std::string_view solution;
+        std::string_view rule;
+    };
+
+    // Ids index a table, so they are kept small
+    static constexpr std::uint32_t kMaxId = 65535;
+
+    // nullopt with "line N: ..." in `error` if the text is malformed
+    static std::optional<LevelCatalog> parse(std::string text, std::string& error);
+
+    // Same for a binary pack
+    static std::optional<LevelCatalog> parsePack(std::string bytes, std::string& error);
+    static bool isPack(std::string_view bytes);
+
+    // Maps a catalog or pack file (mmap where available) and views it in
+    // place, reporting problems on stderr
+    static std::optional<LevelCatalog> load(const std::string& path);
+
+    static const LevelCatalog& builtin();
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    // Entries in play order (ascending id)
+    const Entry& operator[](size_t index) const { return entries_[index]; }
+    std::vector<Entry>::const_iterator begin() const { return entries_.begin(); }
+    std::vector<Entry>::const_iterator end() const { return entries_.end(); }
+
+    // The binary pack of this catalog, for parsePack() or load()
+    std::string toPack() const;
+
+    // nullptr if no level has this id
+    const Entry* find(std::uint32_t id) const {
+        return id < slots_.size() && slots_[id] ? &entries_[slots_[id] - 1] : nullptr;
+    }
+
+    // Rewards are interned to dense ids in order of first appearance, for
+    // Inventory bitsets; levels with the same reward text share an id
+    size_t rewardCount() const { return rewards_.size(); }
+    std::string_view rewardName(std::uint32_t rewardId) const { return rewards_[rewardId]; }
+    std::uint32_t rewardOf(size_t index) const { return rewardIds_[index]; }
+    // nullopt if no level gives this reward
+    std::optional<std::uint32_t> findReward(std::string_view name) const;
+
+private:
+    std::shared_ptr<const void> owned_;     // the text or mapping; null when static
+    std::vector<Entry> entries_;
+    std::vector<std::uint32_t> slots_;      // id -> entry index + 1, 0 = none
+    std::vector<std::string_view> rewards_; // reward id -> name
+    std::vector<std::uint32_t> rewardIds_;  // entry index -> reward id
+
+    static std::optional<LevelCatalog> parseView(std::string_view text, std::string& error);
+    static std::optional<LevelCatalog> parsePackView(std::string_view bytes, std::string& error);
+    // Id slots and reward ids, once the entries are in place
+    void buildIndex();
+};
@@ -0,0 +1,141 @@
+#include "LevelSet.hpp"
+#include "ValidationRule.hpp"
+#include "../utils/BatchRunner.hpp"
+#include "../utils/FileUtils.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+LevelSet::LevelSet(const LevelCatalog& catalog, std::vector<Level> levels)
+    : catalog_(catalog), levels_(std::move(levels)), validationCache_(std::make_shared<ValidationCache>()) {
+    attachValidationCache();
+}
+
+LevelSet::LevelSet(const LevelSet& other)
+    : catalog_(other.catalog_), levels_(other.levels_), validationCache_(other.validationCache_),
+      compileRunner_(other.compileRunner_) {}
+
+std::shared_ptr<LevelSet> LevelSet::create(const LevelCatalog& catalog, const std::string& origin) {
+    if (catalog.empty()) {
+        std::cerr << "Error: " << origin << ": no levels" << std::endl;
+        return nullptr;
+    }
+
+    std::vector<Level> levels;
+    levels.reserve(catalog.size());
+    for (const auto& entry : catalog) {
+        std::string error;
+        auto rule = ValidationRule::parse(entry.rule, error);
+        if (!rule) {
+            std::cerr << "Error: " << origin << ": level " << entry.id << " rule: " << error << std::endl;
+            return nullptr;
+        }
+        levels.emplace_back(entry, std::move(*rule));
+    }
+    return std::shared_ptr<LevelSet>(new LevelSet(catalog, std::move(levels)));
+}
+
+std::shared_ptr<const LevelSet> LevelSet::builtin() {
+    static const std::shared_ptr<const LevelSet> levels = [] {
+        auto set = create(LevelCatalog::builtin(), "default level catalog");
+        // The shipped catalog is part of the binary, so a bad rule in it is
+        // a programming error
+        if (!set) {
+            throw std::logic_error("default level catalog has an invalid rule");
+        }
+        return set;
+    }();
+    return levels;
+}
+
+const Level* LevelSet::find(std::uint32_t id) const {
+    const auto* entry = catalog_.find(id);
+    return entry ? &levels_[static_cast<size_t>(entry - &catalog_[0])] : nullptr;
+}
+
+bool LevelSet::applyValidationRules(const std::string& path) {
+    const auto config = GameUtils::FileUtils::load_game_config(path);
+    if (!config) {
+        return false;
+    }
+
+    // Compile everything before touching any level
+    std::vector<std::pair<Level*, ValidationRule>> rules;
+    for (const auto& [key, source] : config->settings) {
+        const Level* level = nullptr;
+        if (key.size() > 5 && key.compare(0, 5, "level") == 0 &&
+            key.find_first_not_of("0123456789", 5) == std::string::npos && key.size() < 11) {
+            level = find(static_cast<std::uint32_t>(std::stoul(key.substr(5))));
+        }
+        if (!level) {
+            std::cerr << "Error: " << path << ": unknown key '" << key << "' (expected levelN for a level id N)"
+                      << std::endl;
+            return false;
+        }
+
+        std::string error;
+        auto rule = ValidationRule::parse(source, error);
+        if (!rule) {
+            std::cerr << "Error: " << path << ": " << key << ": " << error << std::endl;
+            return false;
+        }
+        rules.emplace_back(&levels_[static_cast<size_t>(level - levels_.data())], std::move(*rule));
+    }
+
+    for (auto& [level, rule] : rules) {
+        level->setValidator(std::move(rule));
+    }
+    attachValidationCache();
+    return true;
+}
+
+bool LevelSet::enableCompileAndRun(const CompileRunner::Options& options) {
+    auto runner = std::make_shared<CompileRunner>(options);
+    if (!runner->ready()) {
+        std::cerr << "Error: Could not start the compile-and-run workers" << std::endl;
+        return false;
+    }
+
+    // Expected outputs come from the reference solutions, built in parallel
+    // by one thread per worker process, since more would only wait for one
+    std::vector<CompileRunner::Result> references(levels_.size());
+    BatchRunner::forEach(levels_.size(), BatchRunner::threadCount(options.workers, levels_.size()),
+                         [&](size_t, size_t i) { references[i] = runner->execute(levels_[i].getSolutionText()); });
+    for (size_t i = 0; i < levels_.size(); ++i) {
+        if (references[i].status != CompileRunner::Status::Passed) {
+            std::cerr << "Error: Reference solution for level " << levels_[i].getId() << ": "
+                      << CompileRunner::statusName(references[i].status) << ", " << references[i].message
+                      << "\n" << references[i].output << std::endl;
+            return false;
+        }
+    }
+
+    compileRunner_ = std::move(runner);
+    for (size_t i = 0; i < levels_.size(); ++i) {
+        levels_[i].setCompileCheck(compileRunner_.get(), references[i].output);
+    }
+    attachValidationCache();
+    return true;
+}
+
+void LevelSet::attachValidationCache() {
+    // Rules are keyed by their source text; other validators have no stable
+    // identity to key a persistent cache on. Substring-only rules search
+    // faster than a submission can be normalized and hashed, so only rules
+    // that lex or levels that compile are cached.
+    for (auto& level : levels_) {
+        const auto* rule = level.getRule();
+        if (!rule || !(rule->needsLexer() || level.hasCompileCheck())) {
+            level.setValidationCache(nullptr, 0);
+            continue;
+        }
+
+        std::string identity = rule->source();
+        if (level.hasCompileCheck()) {
+            const auto& options = compileRunner_->options();
+            identity += "\ncompile: " + options.compilerCommand() + " -std=" + options.standard + "\nexpect: " +
+                        level.getExpectedOutput();
+        }
+        level.setValidationCache(validationCache_.get(), ValidationCache::levelKey(level.getId(), identity));
+    }
+}
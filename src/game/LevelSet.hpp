@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Level.hpp"
+#include "LevelCatalog.hpp"
+#include "CompileRunner.hpp"
+#include "ValidationCache.hpp"
+
+/**
+ * The levels of one catalog, ready to play: content, validators, the
+ * validation cache and compile-and-run checks.
+ *
+ * A LevelSet is built and edited once, then shared read-only by every
+ * GameEngine playing it through a shared_ptr<const LevelSet>; an engine
+ * keeps only the player's progress. builtin() is the set of the
+ * compiled-in catalog, built on first use.
+ *
+ * Editing copies: the copy's levels are its own, but it shares the
+ * compile pool and validation cache with the original. Cache keys cover
+ * each level's rule and compile check, so the two never see each other's
+ * results for a changed level. Sharing a set between threads is safe;
+ * validation only reads the levels, and the cache and pool lock.
+ */
+class LevelSet {
+public:
+    // Compiles every level's rule; nullptr, reporting on stderr with
+    // `origin`, if the catalog is empty or any rule is invalid
+    static std::shared_ptr<LevelSet> create(const LevelCatalog& catalog, const std::string& origin);
+
+    static std::shared_ptr<const LevelSet> builtin();
+
+    LevelSet(const LevelSet& other);
+    LevelSet& operator=(const LevelSet&) = delete;
+
+    size_t size() const { return levels_.size(); }
+    const Level& operator[](size_t index) const { return levels_[index]; }
+    const LevelCatalog& catalog() const { return catalog_; }
+
+    // By catalog id; nullptr if there is none
+    const Level* find(std::uint32_t id) const;
+
+    // Replaces level validators with rules from a "levelN = <rule>" file.
+    // All-or-nothing: on any error nothing changes and false is returned.
+    bool applyValidationRules(const std::string& path);
+
+    // Makes every level also compile and run solutions, comparing stdout with
+    // the reference solution's. Reports on stderr and changes nothing if the
+    // pool or any reference solution fails.
+    bool enableCompileAndRun(const CompileRunner::Options& options);
+
+    // Used by every level whose validator is a ValidationRule with token()
+    // predicates or a compile check. Thread-safe, so handed out from a
+    // const set.
+    ValidationCache& validationCache() const { return *validationCache_; }
+
+private:
+    LevelCatalog catalog_;                          // levels_ view its text
+    std::vector<Level> levels_;                     // in catalog order
+    std::shared_ptr<ValidationCache> validationCache_;
+    std::shared_ptr<CompileRunner> compileRunner_;
+
+    LevelSet(const LevelCatalog& catalog, std::vector<Level> levels);
+    void attachValidationCache();
+};
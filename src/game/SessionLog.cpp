@@ -0,0 +1,123 @@
+#include "SessionLog.hpp"
+#include "../utils/InputReader.hpp"
+#include "../utils/FileUtils.hpp"
+#include <charconv>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+constexpr std::string_view kHeader = "cq-session 1\n";
+
+// Parses "<number><terminator>" at `pos`; false on anything else
+bool readNumber(std::string_view text, size_t& pos, char terminator, std::uint32_t& value) {
+    const char* first = text.data() + pos;
+    const char* last = text.data() + text.size();
+    const auto [end, error] = std::from_chars(first, last, value);
+    if (error != std::errc() || end == first || end == last || *end != terminator) {
+        return false;
+    }
+    pos = static_cast<size_t>(end - text.data()) + 1;
+    return true;
+}
+
+} // namespace
+
+void SessionLog::append(std::chrono::milliseconds delay, std::string_view bytes) {
+    constexpr auto kMax = std::numeric_limits<std::uint32_t>::max();
+    const auto millis = delay.count() < 0 ? 0 : delay.count();
+    delays_.push_back(millis > static_cast<long long>(kMax) ? kMax : static_cast<std::uint32_t>(millis));
+    input_ += bytes;
+    ends_.push_back(static_cast<std::uint32_t>(input_.size()));
+}
+
+SessionLog::Piece SessionLog::operator[](size_t index) const {
+    const size_t begin = index ? ends_[index - 1] : 0;
+    return {delays_[index], std::string_view(input_).substr(begin, ends_[index] - begin)};
+}
+
+std::chrono::milliseconds SessionLog::duration() const {
+    std::chrono::milliseconds total{0};
+    for (size_t i = 1; i < delays_.size(); ++i) {
+        total += std::chrono::milliseconds(delays_[i]);
+    }
+    return total;
+}
+
+std::string SessionLog::serialize() const {
+    std::string text(kHeader);
+    text.reserve(kHeader.size() + input_.size() + size() * 8);
+    for (size_t i = 0; i < size(); ++i) {
+        const Piece piece = (*this)[i];
+        text += std::to_string(piece.delayMillis);
+        text += ' ';
+        text += std::to_string(piece.bytes.size());
+        text += '\n';
+        text += piece.bytes;
+        text += '\n';
+    }
+    return text;
+}
+
+std::optional<SessionLog> SessionLog::parse(std::string_view text, std::string& error) {
+    if (text.substr(0, kHeader.size()) != kHeader) {
+        error = "not a session log (expected \"cq-session 1\")";
+        return std::nullopt;
+    }
+
+    SessionLog log;
+    size_t pos = kHeader.size();
+    while (pos < text.size()) {
+        std::uint32_t delay = 0;
+        std::uint32_t length = 0;
+        if (!readNumber(text, pos, ' ', delay) || !readNumber(text, pos, '\n', length)) {
+            error = "piece " + std::to_string(log.size() + 1) + ": expected \"<delay> <length>\"";
+            return std::nullopt;
+        }
+        if (text.size() - pos <= length || text[pos + length] != '\n') {
+            error = "piece " + std::to_string(log.size() + 1) + ": truncated";
+            return std::nullopt;
+        }
+        log.append(std::chrono::milliseconds(delay), text.substr(pos, length));
+        pos += length + 1;
+    }
+    return log;
+}
+
+bool SessionLog::save(const std::string& path) const {
+    // Piece lengths count raw bytes, so the file must not gain a '\r' per
+    // '\n'; write_file() is binary
+    if (!GameUtils::FileUtils::write_file(path, serialize())) {
+        std::cerr << "Error: Could not write session log " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::optional<SessionLog> SessionLog::load(const std::string& path) {
+    const auto text = GameUtils::FileUtils::read_file(path);
+    if (!text) {
+        std::cerr << "Error: Could not read session log " << path << std::endl;
+        return std::nullopt;
+    }
+    std::string error;
+    auto log = parse(*text, error);
+    if (!log) {
+        std::cerr << "Error: " << path << ": " << error << std::endl;
+    }
+    return log;
+}
+
+SessionRecorder::SessionRecorder(InputReader& input, std::string path)
+    : input_(input), path_(std::move(path)), last_(Clock::now()) {
+    input_.setTap([this](std::string_view bytes) {
+        const auto now = Clock::now();
+        log_.append(std::chrono::duration_cast<std::chrono::milliseconds>(now - last_), bytes);
+        last_ = now;
+    });
+}
+
+SessionRecorder::~SessionRecorder() {
+    input_.setTap({});
+    log_.save(path_);
+}
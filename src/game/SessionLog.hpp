@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class InputReader;
+
+/**
+ * What a player typed in one session, as the pieces of input arrived and
+ * when, for replaying the game exactly (see SessionReplay).
+ *
+ * Format: a "cq-session 1" line, then per piece "<delay> <length>\n"
+ * followed by the piece's bytes and "\n". The delay is milliseconds since
+ * the previous piece (the first: since the session started). Input is kept
+ * byte for byte, so a session log replays the same game however its lines
+ * were split into reads.
+ */
+class SessionLog {
+public:
+    struct Piece {
+        std::uint32_t delayMillis = 0;
+        std::string_view bytes;         // views input()
+    };
+
+    void append(std::chrono::milliseconds delay, std::string_view bytes);
+
+    // Everything typed, in order
+    const std::string& input() const { return input_; }
+    size_t size() const { return ends_.size(); }
+    bool empty() const { return ends_.empty(); }
+    Piece operator[](size_t index) const;
+
+    // From the first piece to the last
+    std::chrono::milliseconds duration() const;
+
+    std::string serialize() const;
+    // nullopt with "piece N: ..." in `error` if the text is malformed
+    static std::optional<SessionLog> parse(std::string_view text, std::string& error);
+
+    // Both report problems on stderr
+    bool save(const std::string& path) const;
+    static std::optional<SessionLog> load(const std::string& path);
+
+private:
+    std::string input_;
+    std::vector<std::uint32_t> ends_;           // end offset of each piece in input_
+    std::vector<std::uint32_t> delays_;         // milliseconds, per piece
+};
+
+/**
+ * Records a reader's input into a SessionLog and saves it to `path` when
+ * destroyed. The reader must outlive the recorder.
+ */
+class SessionRecorder {
+public:
+    SessionRecorder(InputReader& input, std::string path);
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    const SessionLog& log() const { return log_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    InputReader& input_;
+    std::string path_;
+    SessionLog log_;
+    Clock::time_point last_;
+};
@@ -0,0 +1,182 @@
+#include "SessionReplay.hpp"
+#include "GameEngine.hpp"
+#include "LevelSet.hpp"
+#include "SessionLog.hpp"
+#include "../utils/BatchRunner.hpp"
+#include "../utils/FileUtils.hpp"
+#include "../utils/InputReader.hpp"
+#include "../utils/Renderer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct ReplayResult {
+    size_t levels = 0;          // completed
+    bool complete = false;
+    size_t inputBytes = 0;
+    size_t outputBytes = 0;
+    std::uint64_t outputHash = 0;
+    double recordedSeconds = 0.0;
+    std::string error;
+};
+
+ReplayResult replay(const std::shared_ptr<const LevelSet>& levels, const fs::path& file) {
+    ReplayResult result;
+    std::string error;
+    const auto text = GameUtils::FileUtils::read_file(file.string());
+    if (!text) {
+        result.error = "could not read file";
+        return result;
+    }
+    const auto log = SessionLog::parse(*text, error);
+    if (!log) {
+        result.error = error;
+        return result;
+    }
+    result.inputBytes = log->input().size();
+    result.recordedSeconds = std::chrono::duration<double>(log->duration()).count();
+
+    // FNV-1a over everything printed
+    std::uint64_t hash = 14695981039346656037ull;
+    InputReader input(InputReader::fromText(log->input()));
+    Renderer output([&](std::string_view frame) {
+        result.outputBytes += frame.size();
+        for (const char c : frame) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+    });
+    output.setPacing(false);
+
+    try {
+        GameEngine engine(input, output, levels);
+        engine.run();
+        for (size_t i = 0; i < engine.getLevelCount(); ++i) {
+            result.levels += engine.isLevelCompleted(i) ? 1u : 0u;
+        }
+        result.complete = engine.isGameComplete();
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    result.outputHash = hash;
+    return result;
+}
+
+void appendRow(std::string& out, const std::string& file, const ReplayResult& result, long long micros) {
+    char hash[17];
+    std::snprintf(hash, sizeof hash, "%016llx", static_cast<unsigned long long>(result.outputHash));
+    const char* status = !result.error.empty() ? "error" : (result.complete ? "complete" : "stopped");
+
+    BatchRunner::appendCsvField(out, file);
+    out += ',' + std::string(status) + ',' + std::to_string(result.levels) + ',' +
+           std::to_string(result.inputBytes) + ',' + std::to_string(result.outputBytes) + ',' + hash + ',' +
+           std::to_string(micros) + ',';
+    BatchRunner::appendCsvField(out, result.error);
+    out += '\n';
+}
+
+} // namespace
+
+std::optional<SessionReplay::Summary> SessionReplay::run(const Options& options, std::ostream& report) const {
+    const auto files = BatchRunner::listFiles(options.directory, "session logs");
+    if (!files) {
+        return std::nullopt;
+    }
+
+    Summary summary;
+    summary.sessions = files->size();
+    summary.threads = BatchRunner::threadCount(options.threads, files->size());
+
+    report << "file,status,levels,input_bytes,output_bytes,output_hash,micros,error\n";
+
+    std::vector<Summary> tallies(summary.threads);
+    const auto start = std::chrono::steady_clock::now();
+    const auto latencies = BatchRunner::run(
+        files->size(), summary.threads, report,
+        [&](size_t index) { return replay(levels_, (*files)[index]); },
+        [&](size_t worker, size_t index, const ReplayResult& result, double micros, std::string& rows) {
+            Summary& tally = tallies[worker];
+            tally.inputBytes += result.inputBytes;
+            tally.outputBytes += result.outputBytes;
+            tally.recordedSeconds += result.recordedSeconds;
+            if (!result.error.empty()) {
+                ++tally.errors;
+            } else if (result.complete) {
+                ++tally.completed;
+            } else {
+                ++tally.stopped;
+            }
+            appendRow(rows, (*files)[index].lexically_relative(options.directory).generic_string(), result,
+                      static_cast<long long>(micros));
+        });
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const Summary& tally : tallies) {
+        summary.completed += tally.completed;
+        summary.stopped += tally.stopped;
+        summary.errors += tally.errors;
+        summary.inputBytes += tally.inputBytes;
+        summary.outputBytes += tally.outputBytes;
+        summary.recordedSeconds += tally.recordedSeconds;
+    }
+    summary.p50Micros = BatchRunner::percentile(latencies, 0.50);
+    summary.p99Micros = BatchRunner::percentile(latencies, 0.99);
+    summary.maxMicros = latencies.empty() ? 0.0 : latencies.back();
+    return summary;
+}
+
+void SessionReplay::Summary::print(std::ostream& out) const {
+    const double mib = static_cast<double>(outputBytes) / (1024.0 * 1024.0);
+    out << std::fixed << std::setprecision(1)
+        << "Replayed " << sessions << " sessions (" << completed << " completed, " << stopped << " stopped, "
+        << errors << " errors) on " << threads << " thread(s)\n"
+        << "  wall time " << std::setprecision(3) << seconds << " s for " << std::setprecision(1)
+        << recordedSeconds << " s of recorded play, " << sessionsPerSecond() << " sessions/s, "
+        << (seconds > 0.0 ? mib / seconds : 0.0) << " MiB/s of output\n"
+        << "  latency p50 " << p50Micros << " us, p99 " << p99Micros << " us, max " << maxMicros << " us\n";
+}
+
+std::optional<SessionReplay::Options> SessionReplay::parseOptions(const std::vector<std::string>& args) {
+    Options options;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--threads" && hasValue) {
+            std::istringstream value(args[++i]);
+            if (!(value >> options.threads) || options.threads == 0) {
+                std::cerr << "Error: --threads expects a positive number" << std::endl;
+                return std::nullopt;
+            }
+        } else if (arg == "--output" && hasValue) {
+            options.outputPath = args[++i];
+        } else if (options.directory.empty() && !arg.empty() && arg[0] != '-') {
+            options.directory = arg;
+        } else {
+            std::cerr << "Error: Unexpected argument '" << arg << "'" << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    if (options.directory.empty()) {
+        std::cerr << "Error: --replay needs a directory of session logs" << std::endl;
+        return std::nullopt;
+    }
+    return options;
+}
+
+void SessionReplay::printUsage(std::ostream& out) {
+    out << "Usage: cpp-code-quest --replay <dir> [--threads N] [--output FILE] [--catalog FILE] [--rules FILE]\n"
+        << "  Plays every session log under <dir> (written with --record) as fast as possible.\n"
+        << "  One CSV row per session goes to FILE (default stdout), the summary to stderr.\n"
+        << "  Rows hash the game's output, so two builds' reports differ only in timings\n"
+        << "  unless the game behaves differently.\n";
+}
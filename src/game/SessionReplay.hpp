@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class LevelSet;
+
+/**
+ * Headless replay of recorded sessions (`cpp-code-quest --replay <dir>`).
+ *
+ * Every regular file under the directory is a SessionLog. Each one is
+ * played through GameEngine::run() on its recorded input, with no pauses
+ * and no waiting between pieces, so the whole game loop runs as fast as it
+ * can. Logs are handed to a pool of worker threads through a shared atomic
+ * cursor. All engines share one LevelSet.
+ *
+ * One report row per log gives the levels completed and a hash of
+ * everything the game printed. Games are deterministic, so reports from
+ * two builds, sorted by file, differ only in timings unless the game's
+ * behavior changed.
+ */
+class SessionReplay {
+public:
+    struct Options {
+        std::string directory;
+        size_t threads = 0;         // 0 = one per hardware thread
+        std::string outputPath;     // empty = stdout
+    };
+
+    struct Summary {
+        size_t sessions = 0;
+        size_t completed = 0;       // played to the victory screen
+        size_t stopped = 0;         // input ended or the player quit first
+        size_t errors = 0;          // unreadable logs or games that threw
+        size_t inputBytes = 0;
+        size_t outputBytes = 0;
+        size_t threads = 0;
+        double seconds = 0.0;
+        double recordedSeconds = 0.0;   // how long the recorded sessions took to play
+        double p50Micros = 0.0;     // per-session load + replay latency
+        double p99Micros = 0.0;
+        double maxMicros = 0.0;
+
+        double sessionsPerSecond() const { return seconds > 0.0 ? static_cast<double>(sessions) / seconds : 0.0; }
+        void print(std::ostream& out) const;
+    };
+
+    explicit SessionReplay(std::shared_ptr<const LevelSet> levels) : levels_(std::move(levels)) {}
+
+    // Replays every log under options.directory and writes one row per log
+    // to `report`. Returns nullopt if the directory cannot be listed.
+    std::optional<Summary> run(const Options& options, std::ostream& report) const;
+
+    // Parses the arguments that follow --replay; nullopt (with a message on
+    // stderr) on bad usage
+    static std::optional<Options> parseOptions(const std::vector<std::string>& args);
+    static void printUsage(std::ostream& out);
+
+private:
+    std::shared_ptr<const LevelSet> levels_;
+};
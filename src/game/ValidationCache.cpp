@@ -0,0 +1,288 @@
+#include "ValidationCache.hpp"
+#include "../utils/BitUtils.hpp"
+#include "../utils/FileUtils.hpp"
+#include <array>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CQ_NORMALIZE_SSE2 1
+#endif
+
+namespace {
+
+// Cache file: magic, format version, entry count, then per entry the key
+// halves and the result. Integers are stored in host byte order.
+constexpr char kFileMagic[4] = {'C', 'Q', 'V', 'C'};
+constexpr std::uint32_t kFileVersion = 1;
+constexpr size_t kHeaderBytes = sizeof(kFileMagic) + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+constexpr size_t kEntryBytes = 2 * sizeof(std::uint64_t) + 1;
+
+constexpr std::uint64_t kSecret[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+// 64x64 -> 128-bit multiply, folded back to 64 bits
+std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Wide;
+    const Wide product = static_cast<Wide>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t aLow = a & 0xffffffffULL, aHigh = a >> 32;
+    const std::uint64_t bLow = b & 0xffffffffULL, bHigh = b >> 32;
+    const std::uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh;
+    const std::uint64_t highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    const std::uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffffULL) + (highLow & 0xffffffffULL);
+    const std::uint64_t low = (middle << 32) | (lowLow & 0xffffffffULL);
+    const std::uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+std::uint64_t read64(const char* data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Two multiply-mix lanes over 16-byte blocks, cross-mixed at the end
+ValidationCache::Key hash128(std::string_view data, std::uint64_t seed) {
+    std::uint64_t first = mix(seed ^ kSecret[0], kSecret[1]);
+    std::uint64_t second = mix(seed ^ kSecret[2], kSecret[3]);
+
+    auto step = [&](std::uint64_t a, std::uint64_t b) {
+        first = mix(a ^ kSecret[1] ^ first, b ^ kSecret[2]);
+        second = mix(b ^ kSecret[3] ^ second, a ^ kSecret[0]);
+    };
+
+    const char* p = data.data();
+    size_t remaining = data.size();
+    for (; remaining >= 16; p += 16, remaining -= 16) {
+        step(read64(p), read64(p + 8));
+    }
+    if (remaining) {
+        char tail[16] = {};
+        std::memcpy(tail, p, remaining);
+        step(read64(tail), read64(tail + 8));
+    }
+
+    const std::uint64_t size = data.size();
+    first = mix(first ^ size, kSecret[2] ^ second);
+    second = mix(second ^ kSecret[3], first ^ size);
+    return {first, second};
+}
+
+constexpr std::array<bool, 256> makeSpaceTable() {
+    std::array<bool, 256> table{};
+    for (char c : {' ', '\t', '\n', '\r', '\v', '\f'}) {
+        table[static_cast<unsigned char>(c)] = true;
+    }
+    return table;
+}
+
+constexpr std::array<bool, 256> kIsSpace = makeSpaceTable();
+
+bool isSpace(char c) {
+    return kIsSpace[static_cast<unsigned char>(c)];
+}
+
+} // namespace
+
+ValidationCache::ValidationCache(size_t capacity) : capacity_(capacity) {
+    stats_.capacity = capacity;
+}
+
+bool ValidationCache::validate(std::uint64_t levelKey, std::string_view code,
+                               FunctionRef<bool(std::string_view)> validator, Keying keying) {
+    thread_local std::string normalized;
+    std::string_view text = code;
+    if (keying == Keying::Normalized) {
+        normalize(code, normalized);
+        text = normalized;
+    }
+
+    const Key key = keyFor(levelKey, text);
+    if (const auto cached = lookup(key)) {
+        return *cached;
+    }
+
+    const bool passed = validator(code);
+    store(key, passed);
+    return passed;
+}
+
+std::optional<bool> ValidationCache::lookup(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++stats_.misses;
+        return std::nullopt;
+    }
+    ++stats_.hits;
+    Slot& slot = slots_[it->second];
+    slot.referenced = true;
+    return slot.passed;
+}
+
+void ValidationCache::store(const Key& key, bool passed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    storeLocked(key, passed);
+}
+
+void ValidationCache::storeLocked(const Key& key, bool passed) {
+    if (capacity_ == 0) {
+        return;
+    }
+
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+        slots_[it->second].passed = passed;
+        return;
+    }
+
+    if (slots_.size() < capacity_) {
+        index_.emplace(key, slots_.size());
+        slots_.push_back({key, passed, false});
+        stats_.entries = slots_.size();
+        return;
+    }
+
+    // Second chance: skip (and clear) recently hit slots
+    while (slots_[hand_].referenced) {
+        slots_[hand_].referenced = false;
+        hand_ = (hand_ + 1) % capacity_;
+    }
+    index_.erase(slots_[hand_].key);
+    index_.emplace(key, hand_);
+    slots_[hand_] = {key, passed, false};
+    hand_ = (hand_ + 1) % capacity_;
+    ++stats_.evictions;
+}
+
+void ValidationCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.clear();
+    index_.clear();
+    hand_ = 0;
+    stats_ = Stats();
+    stats_.capacity = capacity_;
+}
+
+ValidationCache::Stats ValidationCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool ValidationCache::save(const std::string& path) const {
+    std::string content;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::uint64_t count = slots_.size();
+        content.resize(kHeaderBytes + slots_.size() * kEntryBytes);
+
+        char* out = content.data();
+        std::memcpy(out, kFileMagic, sizeof(kFileMagic));
+        std::memcpy(out + sizeof(kFileMagic), &kFileVersion, sizeof(kFileVersion));
+        std::memcpy(out + sizeof(kFileMagic) + sizeof(kFileVersion), &count, sizeof(count));
+        out += kHeaderBytes;
+
+        for (const Slot& slot : slots_) {
+            std::memcpy(out, &slot.key.low, sizeof(slot.key.low));
+            std::memcpy(out + 8, &slot.key.high, sizeof(slot.key.high));
+            out[16] = slot.passed ? 1 : 0;
+            out += kEntryBytes;
+        }
+    }
+    // write_file() is binary, so key bytes that happen to be '\n' stay one byte
+    return GameUtils::FileUtils::write_file(path, content);
+}
+
+bool ValidationCache::load(const std::string& path) {
+    const auto content = GameUtils::FileUtils::read_file(path);
+    if (!content) {
+        return false;
+    }
+
+    std::uint32_t version = 0;
+    std::uint64_t count = 0;
+    if (content->size() >= kHeaderBytes) {
+        std::memcpy(&version, content->data() + sizeof(kFileMagic), sizeof(version));
+        std::memcpy(&count, content->data() + sizeof(kFileMagic) + sizeof(version), sizeof(count));
+    }
+    if (content->size() < kHeaderBytes || std::memcmp(content->data(), kFileMagic, sizeof(kFileMagic)) != 0 ||
+        version != kFileVersion || (content->size() - kHeaderBytes) / kEntryBytes != count ||
+        (content->size() - kHeaderBytes) % kEntryBytes != 0) {
+        std::cerr << "Error: " << path << " is not a validation cache file" << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const char* in = content->data() + kHeaderBytes;
+    for (std::uint64_t i = 0; i < count && slots_.size() < capacity_; ++i, in += kEntryBytes) {
+        Key key;
+        std::memcpy(&key.low, in, sizeof(key.low));
+        std::memcpy(&key.high, in + 8, sizeof(key.high));
+        storeLocked(key, in[16] != 0);
+    }
+    return true;
+}
+
+void ValidationCache::normalize(std::string_view code, std::string& out) {
+    out.resize(code.size());
+    const char* in = code.data();
+    const char* const end = in + code.size();
+    char* const begin = out.data();
+    char* write = begin;
+
+    while (in < end && isSpace(*in)) {
+        ++in;
+    }
+    while (in < end) {
+#if defined(CQ_NORMALIZE_SSE2)
+        // Blocks whose only whitespace is single spaces between words are
+        // already normalized and are copied whole; the output never runs
+        // ahead of the input, so the store is always in bounds
+        const __m128i limit = _mm_set1_epi8(0x20);
+        const __m128i space = _mm_set1_epi8(' ');
+        while (end - in > 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const auto low = static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(block, limit), block)));
+            const auto spaces = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, space)));
+            if (low != spaces || (spaces & (spaces >> 1)) || (spaces & 0x8001u)) {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(write), block);
+            in += 16;
+            write += 16;
+        }
+#endif
+        // Scalar path: one word, then the whitespace run after it
+        const char* const wordEnd = in + 16 < end ? in + 16 : end;
+        while (in < wordEnd && !isSpace(*in)) {
+            *write++ = *in++;
+        }
+        if (in == wordEnd) {
+            continue;
+        }
+
+        bool lineBreak = false;
+        for (; in < end && isSpace(*in); ++in) {
+            lineBreak |= *in == '\n';
+        }
+        if (in < end) {
+            *write++ = lineBreak ? '\n' : ' ';
+        }
+    }
+    out.resize(static_cast<size_t>(write - begin));
+}
+
+std::uint64_t ValidationCache::levelKey(std::uint32_t levelId, std::string_view ruleSource) {
+    return hash128(ruleSource, levelId).low;
+}
+
+ValidationCache::Key ValidationCache::keyFor(std::uint64_t levelKey, std::string_view normalizedCode) {
+    return hash128(normalizedCode, levelKey);
+}
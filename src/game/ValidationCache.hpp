@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../utils/FunctionRef.hpp"
+
+/**
+ * Bounded cache of validation results, keyed by content hash.
+ *
+ * Submissions are normalized first (leading and trailing whitespace dropped,
+ * each inner whitespace run collapsed to one '\n' if it spans a line break,
+ * otherwise to one ' '), so resubmitting the same code with different
+ * indentation is a hit. The key is a 128-bit hash of the normalized text
+ * seeded with a per-level key that covers the level and its rule, so a
+ * changed rule never sees stale results. On a miss the validator runs on the
+ * code as typed, so a cached verdict is always the uncached one; that makes
+ * normalized keys sound only for validators that whitespace cannot sway.
+ *
+ * Eviction is CLOCK (second chance): a hit only sets a flag, so lookups never
+ * reorder anything. All members are thread-safe.
+ */
+class ValidationCache {
+public:
+    struct Key {
+        std::uint64_t low = 0;
+        std::uint64_t high = 0;
+
+        bool operator==(const Key& other) const { return low == other.low && high == other.high; }
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+
+        double hitRate() const { return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+    };
+
+    // Exact keys hash the submission as typed, for validators whose result
+    // whitespace can change (e.g. by running it)
+    enum class Keying {
+        Normalized,
+        Exact
+    };
+
+    static constexpr size_t kDefaultCapacity = 16384;
+
+    // A capacity of 0 disables caching; every call then runs the validator
+    explicit ValidationCache(size_t capacity = kDefaultCapacity);
+
+    // Runs `validator` on `code` unless the result is cached
+    bool validate(std::uint64_t levelKey, std::string_view code,
+                  FunctionRef<bool(std::string_view)> validator,
+                  Keying keying = Keying::Normalized);
+
+    std::optional<bool> lookup(const Key& key);
+    void store(const Key& key, bool passed);
+    void clear();
+    Stats stats() const;
+
+    // Persistence; both report problems on stderr. load() keeps the current
+    // entries and adds the file's, up to capacity.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    static void normalize(std::string_view code, std::string& out);
+    static std::uint64_t levelKey(std::uint32_t levelId, std::string_view ruleSource);
+    static Key keyFor(std::uint64_t levelKey, std::string_view normalizedCode);
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return static_cast<size_t>(key.low); }
+    };
+
+    struct Slot {
+        Key key;
+        bool passed;
+        bool referenced;
+    };
+
+    void storeLocked(const Key& key, bool passed);
+
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    std::vector<Slot> slots_;
+    std::unordered_map<Key, size_t, KeyHash> index_;    // key -> slot
+    size_t hand_ = 0;
+    Stats stats_;
+};
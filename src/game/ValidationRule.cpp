@@ -0,0 +1,443 @@
+#include "ValidationRule.hpp"
+#include "../utils/CppLexer.hpp"
+#include "../utils/SimdSearch.hpp"
+#include <algorithm>
+#include <optional>
+
+// Recursive-descent parser; builds the node tables of a ValidationRule directly
+class RuleParser {
+public:
+    RuleParser(std::string_view text, ValidationRule& rule) : text_(text), rule_(rule) {}
+
+    bool parse(std::string& error) {
+        bool ok = parseRule(0);
+        if (ok) {
+            skipSpace();
+            ok = pos_ == text_.size() || fail("unexpected text after rule");
+        }
+        if (!ok) {
+            error = error_ + " at offset " + std::to_string(errorPos_);
+        }
+        return ok;
+    }
+
+private:
+    static constexpr size_t kMaxDepth = 64;
+
+    std::string_view text_;
+    ValidationRule& rule_;
+    size_t pos_ = 0;
+    std::string error_;
+    size_t errorPos_ = 0;
+
+    bool fail(const std::string& message) {
+        error_ = message;
+        errorPos_ = pos_;
+        return false;
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                                       text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool expect(char c) {
+        skipSpace();
+        if (pos_ >= text_.size() || text_[pos_] != c) {
+            return fail(std::string("expected '") + c + "'");
+        }
+        ++pos_;
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        skipSpace();
+        if (pos_ >= text_.size() || text_[pos_] != '"') {
+            return fail("expected a quoted string");
+        }
+        const size_t start = pos_++;
+        for (; pos_ < text_.size(); ++pos_) {
+            const char c = text_[pos_];
+            if (c == '"') {
+                ++pos_;
+                return true;
+            }
+            if (c == '\\') {
+                if (++pos_ == text_.size() || (text_[pos_] != '"' && text_[pos_] != '\\')) {
+                    return fail("only \\\" and \\\\ escapes are supported");
+                }
+            }
+            out += text_[pos_];
+        }
+        pos_ = start;
+        return fail("unterminated string");
+    }
+
+    // Appends a node and returns its index
+    std::uint32_t addNode(ValidationRule::NodeKind kind, std::uint32_t first, std::uint32_t count) {
+        rule_.nodes_.push_back({kind, first, count});
+        return static_cast<std::uint32_t>(rule_.nodes_.size() - 1);
+    }
+
+    std::uint32_t needleIndex(std::string needle) {
+        auto& needles = rule_.needles_;
+        const auto it = std::find(needles.begin(), needles.end(), needle);
+        if (it != needles.end()) {
+            return static_cast<std::uint32_t>(it - needles.begin());
+        }
+        needles.push_back(std::move(needle));
+        return static_cast<std::uint32_t>(needles.size() - 1);
+    }
+
+    bool parseRule(size_t depth) {
+        if (depth > kMaxDepth) {
+            return fail("rule nested too deeply");
+        }
+        skipSpace();
+        const size_t nameStart = pos_;
+        while (pos_ < text_.size() && text_[pos_] >= 'a' && text_[pos_] <= 'z') {
+            ++pos_;
+        }
+        const std::string_view name = text_.substr(nameStart, pos_ - nameStart);
+        using Kind = ValidationRule::NodeKind;
+
+        if (name == "contains") {
+            std::string needle;
+            if (!expect('(') || !parseString(needle)) {
+                return false;
+            }
+            if (needle.empty()) {
+                pos_ -= 2;
+                return fail("contains() needs a non-empty string");
+            }
+            addNode(Kind::Contains, needleIndex(std::move(needle)), 0);
+            return expect(')');
+        }
+
+        if (name == "token") {
+            std::vector<std::string> spellings;
+            if (!expect('(')) {
+                return false;
+            }
+            do {
+                std::string spelling;
+                if (!parseString(spelling)) {
+                    return false;
+                }
+                if (spelling.empty()) {
+                    pos_ -= 2;
+                    return fail("token() spellings must be non-empty");
+                }
+                spellings.push_back(std::move(spelling));
+                skipSpace();
+            } while (pos_ < text_.size() && text_[pos_] == ',' && ++pos_);
+            rule_.tokenSequences_.push_back(std::move(spellings));
+            addNode(Kind::Token, static_cast<std::uint32_t>(rule_.tokenSequences_.size() - 1), 0);
+            return expect(')');
+        }
+
+        if (name != "all" && name != "any" && name != "not") {
+            pos_ = nameStart;
+            return fail("expected all, any, not, contains or token");
+        }
+
+        const Kind kind = name == "all" ? Kind::All : (name == "any" ? Kind::Any : Kind::Not);
+        const std::uint32_t node = addNode(kind, 0, 0);
+        if (!expect('(')) {
+            return false;
+        }
+
+        // Children are parsed first (their subtrees go after `node`), then
+        // their root indices are listed contiguously in children_
+        std::vector<std::uint32_t> children;
+        do {
+            children.push_back(static_cast<std::uint32_t>(rule_.nodes_.size()));
+            if (!parseRule(depth + 1)) {
+                return false;
+            }
+            skipSpace();
+        } while (kind != Kind::Not && pos_ < text_.size() && text_[pos_] == ',' && ++pos_);
+
+        auto& entry = rule_.nodes_[node];
+        entry.first = static_cast<std::uint32_t>(rule_.children_.size());
+        entry.count = static_cast<std::uint32_t>(children.size());
+        rule_.children_.insert(rule_.children_.end(), children.begin(), children.end());
+        return expect(')');
+    }
+};
+
+std::optional<ValidationRule> ValidationRule::parse(std::string_view source, std::string& error) {
+    ValidationRule rule;
+    rule.source_ = std::string(source);
+    if (!RuleParser(source, rule).parse(error)) {
+        return std::nullopt;
+    }
+    if (rule.needles_.size() > kLazyNeedles) {
+        rule.matcher_ = MultiPatternMatcher(rule.needles_);
+    }
+    return rule;
+}
+
+bool ValidationRule::dependsOnWhitespace() const {
+    return std::any_of(needles_.begin(), needles_.end(), [](const std::string& needle) {
+        return needle.find_first_of(" \t\n\r\v\f") != std::string::npos;
+    });
+}
+
+// Per-call scratch: which needles are known to occur and, once needed, the
+// token stream
+struct ValidationRule::Evaluation {
+    std::string_view code;
+    std::uint64_t known = 0;
+    std::uint64_t found = 0;
+    std::vector<bool> scanned;      // one matcher pass, for rules above kLazyNeedles
+    std::optional<TokenStream> tokens;
+};
+
+bool ValidationRule::matches(std::string_view code) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    Evaluation state;
+    state.code = code;
+    if (needles_.size() > kLazyNeedles) {
+        state.scanned.assign(needles_.size(), false);
+        for (size_t index : matcher_.findMatched(code)) {
+            state.scanned[index] = true;
+        }
+    }
+    auto leaf = [&](const Node& node) {
+        if (node.kind == NodeKind::Contains) {
+            return hasNeedle(node.first, state);
+        }
+        if (!state.tokens) {
+            state.tokens = CppLexer::tokenize(state.code);
+        }
+        return state.tokens->containsSequence(tokenSequences_[node.first]);
+    };
+    return evaluate(0, leaf);
+}
+
+bool ValidationRule::hasNeedle(std::uint32_t index, Evaluation& state) const {
+    if (!state.scanned.empty()) {
+        return state.scanned[index];
+    }
+    const std::uint64_t bit = std::uint64_t{1} << index;
+    if (!(state.known & bit)) {
+        state.known |= bit;
+        if (SimdSearch::find(state.code, needles_[index]) != SimdSearch::npos) {
+            state.found |= bit;
+        }
+    }
+    return state.found & bit;
+}
+
+template<typename Leaf>
+bool ValidationRule::evaluate(std::uint32_t index, Leaf& leaf) const {
+    const Node& node = nodes_[index];
+    switch (node.kind) {
+        case NodeKind::Contains:
+        case NodeKind::Token:
+            return leaf(node);
+        case NodeKind::Not:
+            return !evaluate(children_[node.first], leaf);
+        case NodeKind::All:
+            for (std::uint32_t i = 0; i < node.count; ++i) {
+                if (!evaluate(children_[node.first + i], leaf)) {
+                    return false;
+                }
+            }
+            return true;
+        case NodeKind::Any:
+            for (std::uint32_t i = 0; i < node.count; ++i) {
+                if (evaluate(children_[node.first + i], leaf)) {
+                    return true;
+                }
+            }
+            return false;
+    }
+    return false;
+}
+
+template<typename Leaf>
+ValidationRule::Progress ValidationRule::progressOf(std::uint32_t index, Leaf& leaf) const {
+    const Node& node = nodes_[index];
+    switch (node.kind) {
+        case NodeKind::Contains:
+        case NodeKind::Token:
+            return {leaf(node) ? 1u : 0u, 1};
+        case NodeKind::Not:
+            // Counts as one predicate: whatever is inside must stay absent
+            return {evaluate(children_[node.first], leaf) ? 0u : 1u, 1};
+        case NodeKind::All: {
+            Progress sum;
+            for (std::uint32_t i = 0; i < node.count; ++i) {
+                const Progress child = progressOf(children_[node.first + i], leaf);
+                sum.met += child.met;
+                sum.total += child.total;
+            }
+            return sum;
+        }
+        case NodeKind::Any: {
+            // The branch with the largest share met
+            Progress best;
+            for (std::uint32_t i = 0; i < node.count; ++i) {
+                const Progress child = progressOf(children_[node.first + i], leaf);
+                if (i == 0 || child.met * best.total > best.met * child.total) {
+                    best = child;
+                }
+            }
+            return best;
+        }
+    }
+    return {};
+}
+
+// ============================================================================
+// Sessions
+// ============================================================================
+
+ValidationRule::Session::Session(const ValidationRule& rule)
+    : rule_(&rule),
+      needleFound_(rule.needles_.size(), false),
+      sequenceCommitted_(rule.tokenSequences_.size(), false),
+      sequenceFound_(rule.tokenSequences_.size(), false) {
+    for (const auto& needle : rule.needles_) {
+        needleOverlap_ = std::max(needleOverlap_, needle.size() - 1);
+    }
+    for (const auto& sequence : rule.tokenSequences_) {
+        recentLimit_ = std::max(recentLimit_, sequence.size() - 1);
+    }
+}
+
+void ValidationRule::Session::advance(std::string_view code) {
+    if (code.size() <= seen_) {
+        return;
+    }
+    code_ = code;
+    scanNeedles(seen_);
+    if (!rule_->tokenSequences_.empty()) {
+        scanTokens();
+    }
+    seen_ = code.size();
+    code_ = {};
+}
+
+bool ValidationRule::Session::matches() const {
+    if (rule_->nodes_.empty()) {
+        return false;
+    }
+    auto leaf = [this](const Node& node) {
+        return node.kind == NodeKind::Contains ? needleFound_[node.first] : sequenceFound_[node.first];
+    };
+    return rule_->evaluate(0, leaf);
+}
+
+ValidationRule::Progress ValidationRule::Session::progress() const {
+    if (rule_->nodes_.empty()) {
+        return {};
+    }
+    auto leaf = [this](const Node& node) {
+        return node.kind == NodeKind::Contains ? needleFound_[node.first] : sequenceFound_[node.first];
+    };
+    return rule_->progressOf(0, leaf);
+}
+
+void ValidationRule::Session::scanNeedles(size_t oldSize) {
+    const auto& needles = rule_->needles_;
+    if (needles.empty()) {
+        return;
+    }
+    // Needles that end in the new text may start up to needleOverlap_ earlier
+    const std::string_view window = code_.substr(oldSize > needleOverlap_ ? oldSize - needleOverlap_ : 0);
+    if (needles.size() > kLazyNeedles) {
+        for (size_t index : rule_->matcher_.findMatched(window)) {
+            needleFound_[index] = true;
+        }
+        return;
+    }
+    for (size_t i = 0; i < needles.size(); ++i) {
+        if (!needleFound_[i] && SimdSearch::find(window, needles[i]) != SimdSearch::npos) {
+            needleFound_[i] = true;
+        }
+    }
+}
+
+void ValidationRule::Session::scanTokens() {
+    scratch_.clear();
+    const std::string_view source = code_;
+    CppLexer::tokenize(source.substr(lexFrom_), scratch_);
+
+    // The last token, and anything reaching into its line, may still grow or
+    // change kind (an open comment or raw string, an unfinished identifier).
+    // Lexing restarts at the start of that line, where the lexer is in the
+    // same state as in a full pass.
+    size_t keep = scratch_.size();
+    size_t resume = code_.size();
+    if (keep > 0) {
+        --keep;
+        resume = lineStartBefore(lexFrom_ + scratch_[keep].offset);
+        while (keep > 0 && lexFrom_ + scratch_[keep - 1].offset + scratch_[keep - 1].length > resume) {
+            --keep;
+            resume = lineStartBefore(lexFrom_ + scratch_[keep].offset);
+        }
+    }
+
+    for (size_t i = 0; i < keep; ++i) {
+        if (scratch_[i].kind != TokenKind::Comment) {
+            pushToken(source.substr(lexFrom_ + scratch_[i].offset, scratch_[i].length), recent_, sequenceCommitted_);
+        }
+    }
+
+    // What the tail would add if the input ended here
+    sequenceFound_ = sequenceCommitted_;
+    std::vector<std::string> recent = recent_;
+    for (size_t i = keep; i < scratch_.size(); ++i) {
+        if (scratch_[i].kind != TokenKind::Comment) {
+            pushToken(source.substr(lexFrom_ + scratch_[i].offset, scratch_[i].length), recent, sequenceFound_);
+        }
+    }
+    lexFrom_ = resume;
+}
+
+// Start of the physical line holding `offset`, skipping back over spliced
+// ("\\\n") line breaks; never before lexFrom_, itself a line start
+size_t ValidationRule::Session::lineStartBefore(size_t offset) const {
+    while (offset > lexFrom_) {
+        const size_t newline = code_.rfind('\n', offset - 1);
+        if (newline == std::string_view::npos || newline < lexFrom_) {
+            return lexFrom_;
+        }
+        size_t last = newline;
+        while (last > lexFrom_ && (code_[last - 1] == '\r' || code_[last - 1] == ' ' || code_[last - 1] == '\t')) {
+            --last;
+        }
+        if (last == lexFrom_ || code_[last - 1] != '\\') {
+            return newline + 1;
+        }
+        offset = last - 1;
+    }
+    return lexFrom_;
+}
+
+// Records one code token, marking every sequence it completes
+void ValidationRule::Session::pushToken(std::string_view text, std::vector<std::string>& recent,
+                                        std::vector<bool>& found) const {
+    const auto& sequences = rule_->tokenSequences_;
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        const auto& words = sequences[i];
+        if (found[i] || words.back() != text || words.size() - 1 > recent.size()) {
+            continue;
+        }
+        found[i] = std::equal(words.begin(), words.end() - 1, recent.end() - static_cast<std::ptrdiff_t>(words.size() - 1));
+    }
+    if (recentLimit_ > 0) {
+        if (recent.size() == recentLimit_) {
+            recent.erase(recent.begin());
+        }
+        recent.emplace_back(text);
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../utils/CppLexer.hpp"
+#include "../utils/MultiPatternMatcher.hpp"
+
+/**
+ * Declarative level validation rule, compiled into one matching plan.
+ *
+ * Grammar (whitespace is free, strings use C-style \" and \\ escapes):
+ *
+ *   rule      := all(rule, ...) | any(rule, ...) | not(rule)
+ *              | contains("text")             substring anywhere in the code
+ *              | token("spelling", ...)       adjacent code tokens, ignoring
+ *                                             comments and literal contents
+ *
+ * Operators short-circuit, and each distinct contains() text is searched at
+ * most once per submission, only when the tree reaches it. Rules with many
+ * texts are compiled into one multi-pattern matcher and settled in a single
+ * scan instead. token() predicates share one CppLexer pass, which likewise
+ * only runs when a token predicate is reached.
+ */
+class ValidationRule {
+public:
+    ValidationRule() = default;
+
+    // nullopt with a message in `error` if the rule text is malformed
+    static std::optional<ValidationRule> parse(std::string_view source, std::string& error);
+
+    bool matches(std::string_view code) const;
+    bool operator()(std::string_view code) const { return matches(code); }
+
+    // How close code is to matching: leaf predicates met out of those needed,
+    // along the most advanced any() branch. met == total exactly when it matches.
+    struct Progress {
+        size_t met = 0;
+        size_t total = 0;
+    };
+
+    class Session;
+
+    const std::string& source() const { return source_; }
+
+    // token() predicates lex the submission, which costs far more than the
+    // substring searches; cheap rules are not worth caching
+    bool needsLexer() const { return !tokenSequences_.empty(); }
+
+    // Whether re-spacing the code can change the verdict: only a contains()
+    // text with whitespace in it can tell; token() never sees whitespace
+    bool dependsOnWhitespace() const;
+
+    enum class NodeKind : std::uint8_t {
+        All,
+        Any,
+        Not,
+        Contains,
+        Token
+    };
+
+    // Flattened tree: operators list their children in children_, leaves
+    // index into the needle or token-sequence tables
+    struct Node {
+        NodeKind kind;
+        std::uint32_t first;    // children_ offset, or leaf table index
+        std::uint32_t count;    // number of children (operators only)
+    };
+
+private:
+    // Up to this many distinct contains() texts are searched one at a time,
+    // on demand; larger rules resolve them all in one matcher pass
+    static constexpr size_t kLazyNeedles = 16;
+
+    struct Evaluation;
+    bool hasNeedle(std::uint32_t index, Evaluation& state) const;
+
+    // `leaf(node)` answers contains() and token() nodes
+    template<typename Leaf>
+    bool evaluate(std::uint32_t node, Leaf& leaf) const;
+    template<typename Leaf>
+    Progress progressOf(std::uint32_t node, Leaf& leaf) const;
+
+    std::string source_;
+    std::vector<Node> nodes_;                       // nodes_[0] is the root
+    std::vector<std::uint32_t> children_;
+    std::vector<std::string> needles_;              // distinct contains() texts
+    std::vector<std::vector<std::string>> tokenSequences_;
+    MultiPatternMatcher matcher_;                   // built above kLazyNeedles
+
+    friend class RuleParser;
+};
+
+/**
+ * Incremental evaluation of one rule over code that arrives in pieces, such
+ * as a paste read line by line.
+ *
+ * The caller owns the text and passes all of it so far to each advance();
+ * the session keeps only offsets and what it has found. Each call searches
+ * the new text (plus a needle-length overlap) and re-lexes the last line or
+ * so, carrying found predicates and the trailing code tokens forward, so it
+ * costs about the length of the new text and the verdict is always current.
+ * matches() agrees with ValidationRule::matches() on the last text passed.
+ *
+ * The rule must outlive the session.
+ */
+class ValidationRule::Session {
+public:
+    explicit Session(const ValidationRule& rule);
+
+    // `code` is the previous call's text with new text appended; it may
+    // live at a different address
+    void advance(std::string_view code);
+
+    bool matches() const;
+    Progress progress() const;
+
+private:
+    const ValidationRule* rule_;
+    std::string_view code_;                     // valid during advance() only
+    size_t seen_ = 0;
+
+    std::vector<bool> needleFound_;
+    size_t needleOverlap_ = 0;                  // longest needle - 1
+
+    // Tokens from lexFrom_ on may still change and are re-lexed on the next
+    // append; recent_ holds the last committed code tokens before it
+    size_t lexFrom_ = 0;
+    std::vector<Token> scratch_;
+    std::vector<std::string> recent_;
+    size_t recentLimit_ = 0;                    // longest sequence - 1
+    std::vector<bool> sequenceCommitted_;       // matched before lexFrom_
+    std::vector<bool> sequenceFound_;           // ... or in the tail as it stands
+
+    void scanNeedles(size_t oldSize);
+    void scanTokens();
+    size_t lineStartBefore(size_t offset) const;
+    void pushToken(std::string_view text, std::vector<std::string>& recent, std::vector<bool>& found) const;
+};
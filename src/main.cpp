@@ -1,22 +1,301 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <string>
+#include <thread>
 #include "game/GameEngine.hpp"
+#include "game/BatchGrader.hpp"
+#include "game/GameServer.hpp"
+#include "game/SessionReplay.hpp"
+#include "utils/Renderer.hpp"
+
+namespace {
+
+// Options shared by the interactive game, --grade, --replay and --serve
+struct EngineOptions {
+    std::string catalogPath;    // --catalog: levels instead of the built-in ones
+    std::string rulesPath;      // --rules: level validator overrides
+    std::string cachePath;      // --cache: persistent validation results
+    bool compileAndRun = false; // --compile: solutions must also build and run
+};
+
+// Removes "name VALUE" from args; false if the value is missing
+bool takeOption(std::vector<std::string>& args, const std::string& name, std::string& value) {
+    const auto it = std::find(args.begin(), args.end(), name);
+    if (it == args.end()) {
+        return true;
+    }
+    if (it + 1 == args.end()) {
+        std::cerr << "Error: " << name << " needs a file" << std::endl;
+        return false;
+    }
+    value = *(it + 1);
+    args.erase(it, it + 2);
+    return true;
+}
+
+// Removes a bare flag from args; true if it was there
+bool takeFlag(std::vector<std::string>& args, const std::string& name) {
+    const auto it = std::find(args.begin(), args.end(), name);
+    if (it == args.end()) {
+        return false;
+    }
+    args.erase(it);
+    return true;
+}
+
+bool prepareEngine(GameEngine& engine, const EngineOptions& options) {
+    if (!options.catalogPath.empty() && !engine.loadCatalog(options.catalogPath)) {
+        return false;
+    }
+    if (!options.rulesPath.empty() && !engine.loadValidationRules(options.rulesPath)) {
+        return false;
+    }
+    if (options.compileAndRun) {
+        CompileRunner::Options compile;
+        if (const char* compiler = std::getenv("CXX")) {
+            compile.setCompilerCommand(compiler);
+        }
+        compile.workers = std::max(1u, std::thread::hardware_concurrency());
+        if (!engine.enableCompileAndRun(compile)) {
+            return false;
+        }
+    }
+    // A missing cache file is normal on the first run
+    if (!options.cachePath.empty() && std::filesystem::exists(options.cachePath) &&
+        !engine.getValidationCache().load(options.cachePath)) {
+        return false;
+    }
+    return true;
+}
+
+void saveCache(const GameEngine& engine, const EngineOptions& options) {
+    if (!options.cachePath.empty()) {
+        engine.getValidationCache().save(options.cachePath);
+    }
+}
+
+// stdout when `path` is empty; nullptr if the file cannot be created
+std::ostream* openReport(const std::string& path, std::ofstream& file) {
+    if (path.empty()) {
+        return &std::cout;
+    }
+    file.open(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create report " << path << std::endl;
+        return nullptr;
+    }
+    return &file;
+}
+
+// Headless mode: cpp-code-quest --grade <dir> [options]
+int runBatchGrading(const std::vector<std::string>& args, const EngineOptions& engineOptions) {
+    const auto options = BatchGrader::parseOptions(args);
+    if (!options) {
+        BatchGrader::printUsage(std::cerr);
+        return 2;
+    }
+
+    std::ofstream file;
+    std::ostream* report = openReport(options->outputPath, file);
+    if (!report) {
+        return 1;
+    }
+
+    GameEngine engine;
+    if (!prepareEngine(engine, engineOptions)) {
+        return 1;
+    }
+    const auto summary = BatchGrader(engine).run(*options, *report);
+    if (!summary) {
+        return 1;
+    }
+    summary->print(std::cerr);
+    saveCache(engine, engineOptions);
+    return 0;
+}
+
+// Headless mode: cpp-code-quest --replay <dir> [options]
+int runReplay(const std::vector<std::string>& args, const EngineOptions& engineOptions) {
+    const auto options = SessionReplay::parseOptions(args);
+    if (!options) {
+        SessionReplay::printUsage(std::cerr);
+        return 2;
+    }
+
+    std::ofstream file;
+    std::ostream* report = openReport(options->outputPath, file);
+    if (!report) {
+        return 1;
+    }
+
+    GameEngine engine;
+    if (!prepareEngine(engine, engineOptions)) {
+        return 1;
+    }
+    const auto summary = SessionReplay(engine.getLevels()).run(*options, *report);
+    if (!summary) {
+        return 1;
+    }
+    summary->print(std::cerr);
+    saveCache(engine, engineOptions);
+    return 0;
+}
+
+void showBanner(Renderer& out) {
+    out << "🏰⚔️ Welcome to C++ Code Quest! 🏰⚔️\n"
+        << "═══════════════════════════════════════\n"
+        << "Learn modern C++14/17 through epic adventures!\n\n";
+}
+
+GameServer* activeServer = nullptr;
+
+// A second signal ends the process without waiting for sessions
+extern "C" void stopServer(int signal) {
+    std::signal(signal, SIG_DFL);
+    activeServer->stop();
+}
+
+// Server mode: cpp-code-quest --serve <address> [--max-sessions N] [--record DIR] [options]
+int runServer(std::vector<std::string> args, const EngineOptions& engineOptions, const std::string& recordDir) {
+    GameServer::Options options;
+    std::string maxSessions;
+    if (!takeOption(args, "--max-sessions", maxSessions)) {
+        return 2;
+    }
+    if (args.size() != 1) {
+        std::cerr << "Usage: cpp-code-quest --serve <tcp:[HOST:]PORT | unix:PATH> [--max-sessions N]\n"
+                  << "                      [--record DIR] [--catalog FILE] [--rules FILE] [--fast]" << std::endl;
+        return 2;
+    }
+    options.address = args[0];
+    if (!maxSessions.empty()) {
+        options.maxSessions = std::strtoul(maxSessions.c_str(), nullptr, 10);
+        if (options.maxSessions == 0) {
+            std::cerr << "Error: --max-sessions must be a positive number" << std::endl;
+            return 2;
+        }
+    }
+    // Sessions share nothing mutable, so per-player compile pools and one
+    // cache file written by many games are not offered here
+    if (engineOptions.compileAndRun || !engineOptions.cachePath.empty()) {
+        std::cerr << "Error: --compile and --cache cannot be used with --serve" << std::endl;
+        return 2;
+    }
+    options.pacing = Renderer::standardOutput().pacing();
+
+    // Levels are loaded once; every session plays the same read-only set
+    GameEngine prototype;
+    if (!prepareEngine(prototype, engineOptions)) {
+        return 1;
+    }
+    const auto levels = prototype.getLevels();
+
+    // One log per session, named by the server's start time and a counter
+    std::string recordPrefix;
+    if (!recordDir.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(recordDir, error);
+        if (error) {
+            std::cerr << "Error: Could not create " << recordDir << ": " << error.message() << std::endl;
+            return 1;
+        }
+        const auto started = std::chrono::system_clock::now().time_since_epoch();
+        recordPrefix = (std::filesystem::path(recordDir) /
+                        ("session-" + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(started).count())))
+                           .string();
+    }
+    size_t recorded = 0;
+
+    GameServer server(options, [&levels, &recordPrefix, &recorded](InputReader& input, Renderer& output) {
+        showBanner(output);
+        auto engine = std::make_unique<GameEngine>(input, output, levels);
+        if (!recordPrefix.empty()) {
+            engine->recordInput(recordPrefix + "-" + std::to_string(++recorded) + ".cqlog");
+        }
+        return engine;
+    });
+    if (!server.start()) {
+        return 1;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+
+    std::cerr << "Serving on " << server.boundAddress() << " (Ctrl-C to stop)" << std::endl;
+    server.run();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    activeServer = nullptr;
+    server.stats().print(std::cerr);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // stdin goes through InputReader, which writes out the renderer and
+    // std::cout before it blocks, so C stdio synchronization only costs time
+    std::ios::sync_with_stdio(false);
 
-int main() {
     try {
-        std::cout << "🏰⚔️ Welcome to C++ Code Quest! 🏰⚔️\n";
-        std::cout << "═══════════════════════════════════════\n";
-        std::cout << "Learn modern C++14/17 through epic adventures!\n\n";
+        std::vector<std::string> args(argv + 1, argv + argc);
+
+        EngineOptions engineOptions;
+        if (!takeOption(args, "--catalog", engineOptions.catalogPath) ||
+            !takeOption(args, "--rules", engineOptions.rulesPath) ||
+            !takeOption(args, "--cache", engineOptions.cachePath)) {
+            return 2;
+        }
+        engineOptions.compileAndRun = takeFlag(args, "--compile");
+        // The game's input as a session log; a directory of them with --serve
+        std::string recordPath;
+        if (!takeOption(args, "--record", recordPath)) {
+            return 2;
+        }
+        const bool headless = !args.empty() && (args[0] == "--grade" || args[0] == "--replay");
+        if (headless && !recordPath.empty()) {
+            std::cerr << "Error: --record applies to the game and --serve" << std::endl;
+            return 2;
+        }
+        // Skips the pauses between story screens
+        Renderer::standardOutput().setPacing(!takeFlag(args, "--fast"));
+
+        if (!args.empty() && args[0] == "--grade") {
+            return runBatchGrading({args.begin() + 1, args.end()}, engineOptions);
+        }
+        if (!args.empty() && args[0] == "--replay") {
+            return runReplay({args.begin() + 1, args.end()}, engineOptions);
+        }
+        if (!args.empty() && args[0] == "--serve") {
+            return runServer({args.begin() + 1, args.end()}, engineOptions, recordPath);
+        }
+        
+        showBanner(Renderer::standardOutput());
         
         auto game = std::make_unique<GameEngine>();
+        if (!prepareEngine(*game, engineOptions)) {
+            Renderer::standardOutput().drain();
+            return 1;
+        }
+        if (!recordPath.empty()) {
+            game->recordInput(recordPath);
+        }
         game->run();
+        saveCache(*game, engineOptions);
         
     } catch (const std::exception& e) {
+        Renderer::standardOutput().drain();
         std::cerr << "❌ Game Error: " << e.what() << std::endl;
         return 1;
     }
     
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,48 @@
+#include "BatchRunner.hpp"
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+std::optional<std::vector<fs::path>> BatchRunner::listFiles(const std::string& directory, std::string_view what) {
+    std::vector<fs::path> files;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file(error)) {
+            files.push_back(it->path());
+        }
+    }
+    if (error) {
+        std::cerr << "Error: Could not list " << what << " in " << directory << ": " << error.message() << std::endl;
+        return std::nullopt;
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+size_t BatchRunner::threadCount(size_t requested, size_t jobs) {
+    const size_t threads = requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(threads, jobs));
+}
+
+double BatchRunner::percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[rank];
+}
+
+void BatchRunner::appendCsvField(std::string& out, std::string_view field) {
+    if (field.find_first_of(",\"\n\r") == std::string_view::npos) {
+        out += field;
+        return;
+    }
+    out += '"';
+    for (char c : field) {
+        if (c == '"') {
+            out += '"';
+        }
+        out += c;
+    }
+    out += '"';
+}
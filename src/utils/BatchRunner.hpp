@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * The file-per-job driver behind --grade and --replay.
+ *
+ * listFiles() collects every regular file under a directory, sorted.
+ * forEach() hands job indexes to a pool of worker threads (the calling
+ * thread is one) through a shared atomic cursor. run() times each job on
+ * top of that: every worker writes report rows to its own buffer, which
+ * goes to the report under one lock every kFlushBytes, and tallies into its
+ * own slot, so workers never share a counter.
+ */
+class BatchRunner {
+public:
+    // Rows are batched per worker so the report lock is taken rarely
+    static constexpr size_t kFlushBytes = 64 * 1024;
+
+    // nullopt, reporting on stderr that the `what` in `directory` could not
+    // be listed, if the walk fails
+    static std::optional<std::vector<std::filesystem::path>> listFiles(const std::string& directory,
+                                                                       std::string_view what);
+
+    // `requested` workers, or one per hardware thread when 0, but at least
+    // one and no more than there are jobs
+    static size_t threadCount(size_t requested, size_t jobs);
+
+    // Calls job(worker, index) once for every index below `jobs`, on
+    // `threads` threads; `worker` is below `threads`
+    template<typename Job>
+    static void forEach(size_t jobs, size_t threads, Job&& job);
+
+    // For every index below `jobs`, times result = work(index), then calls
+    // record(worker, index, result, micros, rows): `worker` is below
+    // `threads` and `rows` is appended to. Returns the latencies in
+    // microseconds, sorted for percentile().
+    template<typename Work, typename Record>
+    static std::vector<double> run(size_t jobs, size_t threads, std::ostream& report, Work&& work, Record&& record);
+
+    static double percentile(const std::vector<double>& sorted, double fraction);
+    static void appendCsvField(std::string& out, std::string_view field);
+};
+
+template<typename Job>
+void BatchRunner::forEach(size_t jobs, size_t threads, Job&& job) {
+    std::atomic<size_t> cursor{0};
+    auto worker = [&](size_t id) {
+        for (size_t index; (index = cursor.fetch_add(1, std::memory_order_relaxed)) < jobs;) {
+            job(id, index);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+template<typename Work, typename Record>
+std::vector<double> BatchRunner::run(size_t jobs, size_t threads, std::ostream& report, Work&& work, Record&& record) {
+    std::mutex reportMutex;
+    std::vector<std::vector<double>> latencies(threads);
+    std::vector<std::string> rows(threads);
+    auto flush = [&](std::string& buffer) {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        report << buffer;
+        buffer.clear();
+    };
+
+    forEach(jobs, threads, [&](size_t id, size_t index) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = work(index);
+        const double micros =
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        latencies[id].push_back(micros);
+        record(id, index, result, micros, rows[id]);
+        if (rows[id].size() >= kFlushBytes) {
+            flush(rows[id]);
+        }
+    });
+    for (auto& buffer : rows) {
+        flush(buffer);
+    }
+    report.flush();
+
+    std::vector<double> all;
+    all.reserve(jobs);
+    for (const auto& local : latencies) {
+        all.insert(all.end(), local.begin(), local.end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+}
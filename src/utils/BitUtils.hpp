@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Small bit-twiddling helpers shared by the vectorized string kernels and
+// the inventory bitset
+namespace BitUtils {
+
+    // Index of the lowest set bit; mask must be non-zero
+    inline std::size_t countTrailingZeros(unsigned mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+    }
+
+    // Same for a 64-bit mask
+    inline std::size_t countTrailingZeros64(std::uint64_t mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return index;
+#else
+        return static_cast<std::size_t>(__builtin_ctzll(mask));
+#endif
+    }
+
+    inline std::size_t popCount64(std::uint64_t mask) {
+#ifdef _MSC_VER
+        return static_cast<std::size_t>(__popcnt64(mask));
+#else
+        return static_cast<std::size_t>(__builtin_popcountll(mask));
+#endif
+    }
+
+} // namespace BitUtils
@@ -0,0 +1,182 @@
+#include "BraceBalance.hpp"
+#include "BitUtils.hpp"
+#include "SimdSearch.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CQ_BRACE_SSE2 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CQ_BRACE_AVX2 1
+#define CQ_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+using State = BraceBalanceChecker::State;
+
+// 0 = not a bracket, 1..3 = opener of kind 0..2, 4..6 = closer of kind 0..2
+constexpr std::array<std::uint8_t, 256> buildBracketClasses() {
+    std::array<std::uint8_t, 256> classes{};
+    classes['{'] = 1;
+    classes['('] = 2;
+    classes['['] = 3;
+    classes['}'] = 4;
+    classes[')'] = 5;
+    classes[']'] = 6;
+    return classes;
+}
+
+constexpr std::array<std::uint8_t, 256> kBracketClasses = buildBracketClasses();
+
+// Applies one bracket at absolute offset; returns false on the first error
+inline bool applyBracket(State& state, char c, size_t offset) {
+    const std::uint8_t cls = kBracketClasses[static_cast<unsigned char>(c)];
+    if (cls == 0) {
+        return true;
+    }
+    if (cls <= 3) {
+        const size_t kind = cls - 1u;
+        if (state.depth[kind]++ == 0) {
+            state.outermostOpen[kind] = offset;
+        }
+        return true;
+    }
+    if (--state.depth[cls - 4u] < 0) {
+        state.errorOffset = offset;
+        state.errorBracket = c;
+        return false;
+    }
+    return true;
+}
+
+// Walks the set bits of a block mask in order
+inline bool applyMask(State& state, const char* block, size_t blockOffset, unsigned mask) {
+    while (mask != 0) {
+        const size_t i = BitUtils::countTrailingZeros(mask);
+        if (!applyBracket(state, block[i], blockOffset + i)) {
+            return false;
+        }
+        mask &= mask - 1;
+    }
+    return true;
+}
+
+// Each kernel scans a chunk whose first byte is at stream offset `base` and
+// returns how many bytes it got through before stopping at an error
+size_t scanScalar(State& state, const char* data, size_t size, size_t base) {
+    for (size_t i = 0; i < size; ++i) {
+        if (!applyBracket(state, data[i], base + i)) {
+            return i;
+        }
+    }
+    return size;
+}
+
+#ifdef CQ_BRACE_SSE2
+size_t scanSse2(State& state, const char* data, size_t size, size_t base) {
+    const __m128i braceOpen = _mm_set1_epi8('{');
+    const __m128i braceClose = _mm_set1_epi8('}');
+    const __m128i parenOpen = _mm_set1_epi8('(');
+    const __m128i parenClose = _mm_set1_epi8(')');
+    const __m128i squareOpen = _mm_set1_epi8('[');
+    const __m128i squareClose = _mm_set1_epi8(']');
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, braceOpen), _mm_cmpeq_epi8(block, braceClose)),
+                         _mm_or_si128(_mm_cmpeq_epi8(block, parenOpen), _mm_cmpeq_epi8(block, parenClose))),
+            _mm_or_si128(_mm_cmpeq_epi8(block, squareOpen), _mm_cmpeq_epi8(block, squareClose)));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0 && !applyMask(state, data + i, base + i, mask)) {
+            return i;
+        }
+    }
+    return i + scanScalar(state, data + i, size - i, base + i);
+}
+#endif
+
+#ifdef CQ_BRACE_AVX2
+CQ_TARGET_AVX2
+size_t scanAvx2(State& state, const char* data, size_t size, size_t base) {
+    const __m256i braceOpen = _mm256_set1_epi8('{');
+    const __m256i braceClose = _mm256_set1_epi8('}');
+    const __m256i parenOpen = _mm256_set1_epi8('(');
+    const __m256i parenClose = _mm256_set1_epi8(')');
+    const __m256i squareOpen = _mm256_set1_epi8('[');
+    const __m256i squareClose = _mm256_set1_epi8(']');
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, braceOpen), _mm256_cmpeq_epi8(block, braceClose)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, parenOpen), _mm256_cmpeq_epi8(block, parenClose))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, squareOpen), _mm256_cmpeq_epi8(block, squareClose)));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0 && !applyMask(state, data + i, base + i, mask)) {
+            return i;
+        }
+    }
+    return i + scanScalar(state, data + i, size - i, base + i);
+}
+#endif
+
+} // namespace
+
+void BraceBalanceChecker::feed(std::string_view chunk) {
+    if (state_.errorOffset != npos) {
+        return;
+    }
+
+    // Follows SimdSearch::setLevel, so tests and benchmarks can pin a kernel
+    size_t scanned = 0;
+    switch (SimdSearch::activeLevel()) {
+#ifdef CQ_BRACE_AVX2
+        case SimdSearch::Level::AVX2:
+            scanned = scanAvx2(state_, chunk.data(), chunk.size(), state_.consumed);
+            break;
+#endif
+#ifdef CQ_BRACE_SSE2
+        case SimdSearch::Level::SSE2:
+            scanned = scanSse2(state_, chunk.data(), chunk.size(), state_.consumed);
+            break;
+#endif
+        default:
+            scanned = scanScalar(state_, chunk.data(), chunk.size(), state_.consumed);
+            break;
+    }
+    state_.consumed += scanned;
+}
+
+BraceBalanceChecker::Result BraceBalanceChecker::finish() const {
+    Result result;
+    if (state_.errorOffset != npos) {
+        result.balanced = false;
+        result.offset = state_.errorOffset;
+        result.bracket = state_.errorBracket;
+        return result;
+    }
+
+    // Report the earliest opener that was never closed
+    static constexpr char kOpeners[] = {'{', '(', '['};
+    for (size_t kind = 0; kind < 3; ++kind) {
+        if (state_.depth[kind] > 0 && state_.outermostOpen[kind] < result.offset) {
+            result.balanced = false;
+            result.offset = state_.outermostOpen[kind];
+            result.bracket = kOpeners[kind];
+        }
+    }
+    return result;
+}
+
+BraceBalanceChecker::Result BraceBalanceChecker::check(std::string_view code) {
+    BraceBalanceChecker checker;
+    checker.feed(code);
+    return checker.finish();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Streaming bracket-balance checker with error location.
+ *
+ * {}, () and [] are counted independently, exactly like the original
+ * StringUtils::hasBalancedBraces: a closer that drives its counter negative
+ * is an error on the spot, and any counter left open at the end is an error
+ * at the outermost unclosed opener of that kind. Chunks can be fed as they
+ * arrive; offsets are relative to the start of the whole stream.
+ *
+ * Bracket bytes are located 16 or 32 at a time with the SimdSearch dispatch
+ * level, so bracket-free stretches cost one vector compare chain per block
+ * and only actual brackets reach the counters.
+ */
+class BraceBalanceChecker {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct Result {
+        bool balanced = true;
+        size_t offset = npos;   // first imbalance, npos when balanced
+        char bracket = '\0';    // the offending bracket character
+    };
+
+    void feed(std::string_view chunk);
+    Result finish() const;
+    void reset() { *this = BraceBalanceChecker(); }
+
+    // One-shot form of feed + finish
+    static Result check(std::string_view code);
+
+    // Counters and progress, exposed for the per-byte kernels
+    struct State {
+        std::array<std::int64_t, 3> depth{};          // {}, (), []
+        std::array<size_t, 3> outermostOpen{};        // offset of the 0 -> 1 opener
+        size_t consumed = 0;
+        size_t errorOffset = npos;
+        char errorBracket = '\0';
+    };
+
+private:
+    State state_;
+};
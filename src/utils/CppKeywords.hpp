@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+/**
+ * Compile-time perfect hash over the C++ keywords and common library
+ * identifiers the code helpers recognize.
+ *
+ * The table is built by the compiler with hash-and-displace: every word is
+ * first hashed into a bucket, and each bucket gets its own seed so that its
+ * words land in distinct, unused slots. A lookup is two hashes, one slot read
+ * and one string compare, with no allocation and no runtime initialization.
+ */
+namespace CppKeywords {
+
+    // Reporting order for StringUtils::extractCppKeywords
+    inline constexpr std::string_view kWords[] = {
+        // C++ keywords
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor",
+        "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t",
+        "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+        "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype",
+        "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+        "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+        "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+        "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected",
+        "public", "register", "reinterpret_cast", "requires", "return", "short",
+        "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+        "switch", "template", "this", "thread_local", "throw", "true", "try",
+        "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual",
+        "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+
+        // Common C++ library identifiers
+        "std", "string", "vector", "map", "set", "list", "queue", "stack",
+        "unique_ptr", "shared_ptr", "weak_ptr", "make_unique", "make_shared",
+        "move", "forward", "pair", "tuple", "optional", "variant", "any",
+        "function", "lambda", "bind", "ref", "cref", "iterator", "const_iterator",
+        "begin", "end", "size", "empty", "push_back", "pop_back", "insert",
+        "erase", "find", "count", "sort", "reverse", "transform", "for_each",
+        "algorithm", "numeric", "functional", "memory", "utility", "type_traits",
+        "chrono", "thread", "mutex", "lock_guard", "unique_lock", "condition_variable",
+        "future", "promise", "async", "packaged_task", "exception", "runtime_error",
+        "logic_error", "invalid_argument", "out_of_range", "length_error",
+        "domain_error", "range_error", "overflow_error", "underflow_error"
+    };
+
+    inline constexpr std::size_t kCount = std::size(kWords);
+
+    // kWords[0, kLanguageCount) are the reserved words of the language itself
+    inline constexpr std::size_t kLanguageCount = 92;
+
+    namespace detail {
+
+        inline constexpr std::size_t kBucketCount = 64;
+        inline constexpr std::size_t kSlotCount = 256;      // power of two, load factor ~0.6
+        inline constexpr std::size_t kMaxWordLength = 18;   // "condition_variable"
+        inline constexpr std::uint32_t kMaxSeed = 100000;
+
+        static_assert(kCount < 255, "slot entries are stored as uint8_t index + 1");
+
+        // Seeded FNV-1a followed by the murmur3 finalizer for avalanche
+        constexpr std::uint32_t hash(std::string_view word, std::uint32_t seed) {
+            std::uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+            for (char c : word) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 16777619u;
+            }
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+        constexpr std::size_t bucketOf(std::string_view word) {
+            return hash(word, 0) % kBucketCount;
+        }
+
+        constexpr std::size_t slotOf(std::string_view word, std::uint32_t seed) {
+            return hash(word, seed) & (kSlotCount - 1);
+        }
+
+        struct PerfectHashTable {
+            std::array<std::uint32_t, kBucketCount> seeds{};
+            std::array<std::uint8_t, kSlotCount> slots{};   // keyword index + 1, 0 = empty
+        };
+
+        constexpr PerfectHashTable buildPerfectHash() {
+            PerfectHashTable table;
+
+            std::array<std::size_t, kBucketCount> bucketSize{};
+            std::size_t largestBucket = 0;
+            for (std::size_t i = 0; i < kCount; ++i) {
+                const std::size_t size = ++bucketSize[bucketOf(kWords[i])];
+                largestBucket = size > largestBucket ? size : largestBucket;
+            }
+
+            // Place the most crowded buckets first, while the table is still empty
+            for (std::size_t size = largestBucket; size > 0; --size) {
+                for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+                    if (bucketSize[bucket] != size) {
+                        continue;
+                    }
+
+                    for (std::uint32_t seed = 1;; ++seed) {
+                        if (seed > kMaxSeed) {
+                            throw "no displacement seed found; grow kSlotCount";
+                        }
+
+                        std::array<std::size_t, kCount> chosen{};
+                        std::size_t placed = 0;
+                        bool fits = true;
+
+                        for (std::size_t i = 0; i < kCount && fits; ++i) {
+                            if (bucketOf(kWords[i]) != bucket) {
+                                continue;
+                            }
+                            const std::size_t slot = slotOf(kWords[i], seed);
+                            fits = table.slots[slot] == 0;
+                            for (std::size_t j = 0; j < placed && fits; ++j) {
+                                fits = chosen[j] != slot;
+                            }
+                            chosen[placed++] = slot;
+                        }
+
+                        if (fits) {
+                            table.seeds[bucket] = seed;
+                            std::size_t next = 0;
+                            for (std::size_t i = 0; i < kCount; ++i) {
+                                if (bucketOf(kWords[i]) == bucket) {
+                                    table.slots[chosen[next++]] = static_cast<std::uint8_t>(i + 1);
+                                }
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        inline constexpr PerfectHashTable kTable = buildPerfectHash();
+
+    } // namespace detail
+
+    // Position of word in kWords, or -1 if it is not a keyword
+    constexpr int indexOf(std::string_view word) {
+        if (word.empty() || word.size() > detail::kMaxWordLength) {
+            return -1;
+        }
+        const std::uint32_t seed = detail::kTable.seeds[detail::bucketOf(word)];
+        const std::uint8_t entry = detail::kTable.slots[detail::slotOf(word, seed)];
+        if (entry == 0 || kWords[entry - 1] != word) {
+            return -1;
+        }
+        return entry - 1;
+    }
+
+    constexpr bool contains(std::string_view word) {
+        return indexOf(word) >= 0;
+    }
+
+    // True only for reserved words, not for the library identifiers
+    constexpr bool isLanguageKeyword(std::string_view word) {
+        const int index = indexOf(word);
+        return index >= 0 && static_cast<std::size_t>(index) < kLanguageCount;
+    }
+
+    static_assert(indexOf("alignas") == 0);
+    static_assert(indexOf("underflow_error") == static_cast<int>(kCount) - 1);
+    static_assert(contains("constexpr") && !contains("constexp") && !contains("quest"));
+    static_assert(kWords[kLanguageCount - 1] == "xor_eq" && kWords[kLanguageCount] == "std");
+
+} // namespace CppKeywords
@@ -0,0 +1,465 @@
+#include "CppLexer.hpp"
+#include "CppKeywords.hpp"
+#include "SimdSearch.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+enum CharClass : std::uint8_t {
+    kOther,
+    kSpace,
+    kNewline,
+    kIdentifier,    // letters, '_', '$' and every non-ASCII byte (UTF-8 names)
+    kDigit,
+    kQuote,
+    kSlash,
+    kHash,
+    kDot,
+    kBackslash
+};
+
+constexpr std::array<std::uint8_t, 256> buildCharClasses() {
+    std::array<std::uint8_t, 256> classes{};
+    for (int c = 0; c < 256; ++c) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$' || c >= 0x80) {
+            classes[static_cast<std::size_t>(c)] = kIdentifier;
+        }
+    }
+    for (int c = '0'; c <= '9'; ++c) {
+        classes[static_cast<std::size_t>(c)] = kDigit;
+    }
+    for (char c : {' ', '\t', '\r', '\v', '\f'}) {
+        classes[static_cast<unsigned char>(c)] = kSpace;
+    }
+    classes['\n'] = kNewline;
+    classes['"'] = kQuote;
+    classes['\''] = kQuote;
+    classes['/'] = kSlash;
+    classes['#'] = kHash;
+    classes['.'] = kDot;
+    classes['\\'] = kBackslash;
+    return classes;
+}
+
+constexpr std::array<std::uint8_t, 256> kCharClasses = buildCharClasses();
+
+// Raw string delimiters are at most 16 characters by the standard
+constexpr std::size_t kMaxRawDelimiter = 16;
+
+class Lexer {
+public:
+    Lexer(std::string_view source, std::vector<Token>& out)
+        : source_(source), data_(source.data()), size_(source.size()), out_(out) {}
+
+    void run() {
+        while (pos_ < size_) {
+            const auto c = static_cast<unsigned char>(data_[pos_]);
+            const std::size_t start = pos_;
+
+            switch (kCharClasses[c]) {
+                case kSpace:
+                    ++pos_;
+                    continue;
+                case kNewline:
+                    ++pos_;
+                    lineStart_ = true;
+                    continue;
+                case kBackslash:
+                    if (isLineSplice(pos_)) {
+                        pos_ = source_.find('\n', pos_) + 1;
+                        continue;
+                    }
+                    ++pos_;
+                    emit(start, TokenKind::Punctuator);
+                    break;
+                case kIdentifier:
+                    lexWord(start);
+                    break;
+                case kDigit:
+                    lexNumber();
+                    emit(start, TokenKind::Number);
+                    break;
+                case kDot:
+                    if (pos_ + 1 < size_ && kCharClasses[static_cast<unsigned char>(data_[pos_ + 1])] == kDigit) {
+                        lexNumber();
+                        emit(start, TokenKind::Number);
+                    } else {
+                        lexPunctuator();
+                        emit(start, TokenKind::Punctuator);
+                    }
+                    break;
+                case kQuote:
+                    lexQuoted(data_[pos_]);
+                    emit(start, c == '"' ? TokenKind::String : TokenKind::Char);
+                    break;
+                case kSlash:
+                    if (peek(1) == '/') {
+                        skipLine();
+                        emit(start, TokenKind::Comment);
+                        continue;   // a comment does not end the line start
+                    }
+                    if (peek(1) == '*') {
+                        const std::size_t close = SimdSearch::find(source_, "*/", pos_ + 2);
+                        pos_ = close == SimdSearch::npos ? size_ : close + 2;
+                        emit(start, TokenKind::Comment);
+                        continue;
+                    }
+                    lexPunctuator();
+                    emit(start, TokenKind::Punctuator);
+                    break;
+                case kHash:
+                    if (lineStart_) {
+                        skipLine();
+                        emit(start, TokenKind::Preprocessor);
+                        break;
+                    }
+                    lexPunctuator();
+                    emit(start, TokenKind::Punctuator);
+                    break;
+                default:
+                    lexPunctuator();
+                    emit(start, TokenKind::Punctuator);
+                    break;
+            }
+
+            lineStart_ = false;
+        }
+    }
+
+private:
+    char peek(std::size_t ahead) const {
+        return pos_ + ahead < size_ ? data_[pos_ + ahead] : '\0';
+    }
+
+    void emit(std::size_t start, TokenKind kind) {
+        out_.push_back({static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(pos_ - start), kind});
+    }
+
+    static bool isIdentifierChar(char c) {
+        const auto cls = kCharClasses[static_cast<unsigned char>(c)];
+        return cls == kIdentifier || cls == kDigit;
+    }
+
+    // A backslash followed only by optional spaces and a newline
+    bool isLineSplice(std::size_t at) const {
+        for (std::size_t i = at + 1; i < size_; ++i) {
+            if (data_[i] == '\n') {
+                return true;
+            }
+            if (data_[i] != ' ' && data_[i] != '\t' && data_[i] != '\r') {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // Up to (not including) the newline, following line splices
+    void skipLine() {
+        while (true) {
+            const std::size_t newline = SimdSearch::findByte(source_, '\n', pos_);
+            if (newline == SimdSearch::npos) {
+                pos_ = size_;
+                return;
+            }
+            std::size_t last = newline;
+            while (last > pos_ && (data_[last - 1] == '\r' || data_[last - 1] == ' ' || data_[last - 1] == '\t')) {
+                --last;
+            }
+            if (last == pos_ || data_[last - 1] != '\\') {
+                pos_ = newline;
+                return;
+            }
+            pos_ = newline + 1;
+        }
+    }
+
+    void lexWord(std::size_t start) {
+        while (pos_ < size_ && isIdentifierChar(data_[pos_])) {
+            ++pos_;
+        }
+
+        const std::string_view word = source_.substr(start, pos_ - start);
+        const char next = peek(0);
+
+        // Encoding and raw-string prefixes glue onto the literal that follows
+        if (next == '"' || next == '\'') {
+            const bool isRaw = !word.empty() && word.back() == 'R';
+            const std::string_view encoding = isRaw ? word.substr(0, word.size() - 1) : word;
+            const bool validEncoding = encoding.empty() || encoding == "u8" || encoding == "u" ||
+                                       encoding == "U" || encoding == "L";
+
+            if (validEncoding && isRaw && next == '"' && lexRawString()) {
+                emit(start, TokenKind::String);
+                return;
+            }
+            if (validEncoding && !encoding.empty() && !isRaw) {
+                lexQuoted(next);
+                emit(start, next == '"' ? TokenKind::String : TokenKind::Char);
+                return;
+            }
+        }
+
+        emit(start, CppKeywords::isLanguageKeyword(word) ? TokenKind::Keyword : TokenKind::Identifier);
+    }
+
+    // pp-number: digits, letters, '.', digit separators and exponent signs
+    void lexNumber() {
+        ++pos_;
+        while (pos_ < size_) {
+            const char c = data_[pos_];
+            if (isIdentifierChar(c) || c == '.') {
+                const char lower = static_cast<char>(c | 0x20);
+                if ((lower == 'e' || lower == 'p') && (peek(1) == '+' || peek(1) == '-')) {
+                    pos_ += 2;
+                } else {
+                    ++pos_;
+                }
+            } else if (c == '\'' && pos_ + 1 < size_ && isIdentifierChar(data_[pos_ + 1])) {
+                pos_ += 2;
+            } else {
+                break;
+            }
+        }
+    }
+
+    // From the opening quote to just past the closing one, plus any
+    // user-defined literal suffix ("abc"s, 'x'_ch)
+    void lexQuoted(char quote) {
+        ++pos_;
+        while (pos_ < size_) {
+            const char c = data_[pos_];
+            if (c == '\\') {
+                pos_ += 2;
+                continue;
+            }
+            if (c == '\n') {
+                return;
+            }
+            ++pos_;
+            if (c == quote) {
+                break;
+            }
+        }
+        pos_ = pos_ > size_ ? size_ : pos_;
+        lexSuffix();
+    }
+
+    // At the opening quote of R"delim( ... )delim"; returns false (consuming
+    // nothing) when the delimiter is malformed
+    bool lexRawString() {
+        const std::size_t open = pos_ + 1;
+        std::size_t paren = open;
+        while (paren < size_ && paren - open <= kMaxRawDelimiter && data_[paren] != '(') {
+            const char c = data_[paren];
+            if (c == ' ' || c == ')' || c == '\\' || c == '\t' || c == '\n' || c == '"') {
+                return false;
+            }
+            ++paren;
+        }
+        if (paren >= size_ || data_[paren] != '(') {
+            return false;
+        }
+
+        // Closing sequence: )delim"
+        char closing[kMaxRawDelimiter + 2];
+        const std::size_t delimiterLength = paren - open;
+        closing[0] = ')';
+        std::memcpy(closing + 1, data_ + open, delimiterLength);
+        closing[delimiterLength + 1] = '"';
+
+        const std::size_t close = SimdSearch::find(source_, std::string_view(closing, delimiterLength + 2), paren + 1);
+        pos_ = close == SimdSearch::npos ? size_ : close + delimiterLength + 2;
+        lexSuffix();
+        return true;
+    }
+
+    void lexSuffix() {
+        while (pos_ < size_ && isIdentifierChar(data_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    // Longest-match punctuators; anything unknown is a single byte
+    void lexPunctuator() {
+        const char a = data_[pos_];
+        const char b = peek(1);
+        const char c = peek(2);
+        std::size_t length = 1;
+
+        switch (a) {
+            case ':': length = b == ':' ? 2 : 1; break;
+            case '-':
+                if (b == '>') {
+                    length = c == '*' ? 3 : 2;
+                } else {
+                    length = (b == '-' || b == '=') ? 2 : 1;
+                }
+                break;
+            case '+': length = (b == '+' || b == '=') ? 2 : 1; break;
+            case '&': length = (b == '&' || b == '=') ? 2 : 1; break;
+            case '|': length = (b == '|' || b == '=') ? 2 : 1; break;
+            case '<':
+                if (b == '<') {
+                    length = c == '=' ? 3 : 2;
+                } else if (b == '=') {
+                    length = c == '>' ? 3 : 2;
+                }
+                break;
+            case '>':
+                if (b == '>') {
+                    length = c == '=' ? 3 : 2;
+                } else {
+                    length = b == '=' ? 2 : 1;
+                }
+                break;
+            case '=': case '!': case '*': case '/': case '%': case '^':
+                length = b == '=' ? 2 : 1;
+                break;
+            case '.':
+                if (b == '.' && c == '.') {
+                    length = 3;
+                } else {
+                    length = b == '*' ? 2 : 1;
+                }
+                break;
+            case '#': length = b == '#' ? 2 : 1; break;
+            default: break;
+        }
+
+        pos_ += length;
+    }
+
+    std::string_view source_;
+    const char* data_;
+    std::size_t size_;
+    std::size_t pos_ = 0;
+    bool lineStart_ = true;
+    std::vector<Token>& out_;
+};
+
+} // namespace
+
+TokenStream CppLexer::tokenize(std::string_view source) {
+    std::vector<Token> tokens;
+    tokenize(source, tokens);
+    return TokenStream(source, std::move(tokens));
+}
+
+void CppLexer::tokenize(std::string_view source, std::vector<Token>& out) {
+    assert(source.size() <= std::numeric_limits<std::uint32_t>::max());
+
+    // Typical code averages one token per four to five bytes
+    out.reserve(out.size() + source.size() / 4 + 16);
+    Lexer(source, out).run();
+}
+
+// TokenStream queries
+//
+// Candidates come from a vectorized search of the source; a hit counts only
+// if a code token starts exactly there with exactly that length, which is a
+// binary search over the token offsets. This keeps queries at memory speed
+// while ignoring text inside comments, literals and longer tokens.
+size_t TokenStream::indexAt(size_t offset) const {
+    const auto it = std::lower_bound(tokens_.begin(), tokens_.end(), offset,
+                                     [](const Token& token, size_t value) { return token.offset < value; });
+    if (it == tokens_.end() || it->offset != offset) {
+        return SIZE_MAX;
+    }
+    return static_cast<size_t>(it - tokens_.begin());
+}
+
+size_t TokenStream::findToken(std::string_view spelling, size_t& pos) const {
+    while ((pos = SimdSearch::find(source_, spelling, pos)) != SimdSearch::npos) {
+        const size_t index = indexAt(pos);
+        pos += 1;
+        if (index != SIZE_MAX && tokens_[index].length == spelling.size() &&
+            tokens_[index].kind != TokenKind::Comment) {
+            return index;
+        }
+    }
+    return SIZE_MAX;
+}
+
+bool TokenStream::containsToken(std::string_view spelling) const {
+    size_t pos = 0;
+    return !spelling.empty() && findToken(spelling, pos) != SIZE_MAX;
+}
+
+size_t TokenStream::countToken(std::string_view spelling) const {
+    size_t total = 0;
+    size_t pos = 0;
+    while (!spelling.empty() && findToken(spelling, pos) != SIZE_MAX) {
+        ++total;
+    }
+    return total;
+}
+
+size_t TokenStream::count(TokenKind kind) const {
+    size_t total = 0;
+    for (const auto& token : tokens_) {
+        total += token.kind == kind ? 1 : 0;
+    }
+    return total;
+}
+
+bool TokenStream::containsSequence(std::initializer_list<std::string_view> spellings) const {
+    return containsSequenceOf(spellings.begin(), spellings.size());
+}
+
+bool TokenStream::containsSequence(const std::vector<std::string>& spellings) const {
+    return containsSequenceOf(spellings.data(), spellings.size());
+}
+
+template<typename Spelling>
+bool TokenStream::containsSequenceOf(const Spelling* words, size_t count) const {
+    if (count == 0) {
+        return true;
+    }
+
+    // Anchor on the longest spelling, the one with the fewest candidates,
+    // then check its neighbours on either side
+    size_t anchor = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (words[i].size() > words[anchor].size()) {
+            anchor = i;
+        }
+    }
+    if (words[anchor].empty()) {
+        return false;
+    }
+
+    auto codeTokenMatches = [&](size_t index, std::string_view spelling) {
+        return tokens_[index].kind != TokenKind::Comment && text(index) == spelling;
+    };
+
+    size_t pos = 0;
+    size_t found;
+    while ((found = findToken(words[anchor], pos)) != SIZE_MAX) {
+        bool matched = true;
+
+        size_t next = found;
+        for (size_t i = anchor + 1; i < count && matched; ++i) {
+            do {
+                ++next;
+            } while (next < tokens_.size() && tokens_[next].kind == TokenKind::Comment);
+            matched = next < tokens_.size() && codeTokenMatches(next, words[i]);
+        }
+
+        size_t previous = found;
+        for (size_t i = anchor; i > 0 && matched; --i) {
+            do {
+                matched = previous-- > 0;
+            } while (matched && tokens_[previous].kind == TokenKind::Comment);
+            matched = matched && codeTokenMatches(previous, words[i - 1]);
+        }
+
+        if (matched) {
+            return true;
+        }
+    }
+    return false;
+}
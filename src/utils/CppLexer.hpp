@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class TokenKind : std::uint8_t {
+    Identifier,
+    Keyword,        // reserved words only; std, make_unique, ... are identifiers
+    Number,
+    String,         // including prefixes and raw strings: u8"x", R"(x)"
+    Char,
+    Punctuator,     // longest match: ::, ->, &&, <<=, ...
+    Comment,
+    Preprocessor    // a whole directive line, continuations included
+};
+
+// 12 bytes per token; offsets index the buffer that was tokenized
+struct Token {
+    std::uint32_t offset;
+    std::uint32_t length;
+    TokenKind kind;
+};
+
+/**
+ * The tokens of one submission plus the buffer they point into.
+ *
+ * Tokenize once and hand the stream to every check: keyword, operator and
+ * bracket queries walk the small token array instead of rescanning bytes,
+ * and text inside comments and literals can no longer produce false
+ * matches. The stream borrows its source, which must outlive it; it is
+ * immutable and safe to share between threads.
+ */
+class TokenStream {
+public:
+    TokenStream() = default;
+    TokenStream(std::string_view source, std::vector<Token> tokens)
+        : source_(source), tokens_(std::move(tokens)) {}
+
+    std::string_view source() const { return source_; }
+    const std::vector<Token>& tokens() const { return tokens_; }
+    size_t size() const { return tokens_.size(); }
+    bool empty() const { return tokens_.empty(); }
+    const Token& operator[](size_t index) const { return tokens_[index]; }
+    std::vector<Token>::const_iterator begin() const { return tokens_.begin(); }
+    std::vector<Token>::const_iterator end() const { return tokens_.end(); }
+
+    std::string_view text(const Token& token) const { return source_.substr(token.offset, token.length); }
+    std::string_view text(size_t index) const { return text(tokens_[index]); }
+
+    // Queries over code tokens; comments are skipped
+    bool containsToken(std::string_view spelling) const;
+    size_t countToken(std::string_view spelling) const;
+    size_t count(TokenKind kind) const;
+
+    // Adjacent code tokens spelled exactly as given, e.g. {"auto", "["}
+    bool containsSequence(std::initializer_list<std::string_view> spellings) const;
+    bool containsSequence(const std::vector<std::string>& spellings) const;
+
+private:
+    std::string_view source_;
+    std::vector<Token> tokens_;
+
+    // Index of the token starting at `offset`, or SIZE_MAX
+    size_t indexAt(size_t offset) const;
+
+    // Next code token spelled `spelling` whose text starts at or after `pos`;
+    // advances `pos` past it
+    size_t findToken(std::string_view spelling, size_t& pos) const;
+
+    template<typename Spelling>
+    bool containsSequenceOf(const Spelling* words, size_t count) const;
+};
+
+/**
+ * Single-pass C++ lexer for submissions.
+ *
+ * Recognizes line and block comments, string and character literals with
+ * escapes and encoding prefixes, raw strings with custom delimiters, numbers
+ * with digit separators, preprocessor lines and the longest-match
+ * punctuators. Malformed input never fails: an unterminated block comment or
+ * raw string runs to the end of the buffer, any other unterminated literal to
+ * the end of its line. Sources must be under 4 GiB.
+ */
+class CppLexer {
+public:
+    static TokenStream tokenize(std::string_view source);
+
+    // Appends to `out`, so one vector can be reused across submissions
+    static void tokenize(std::string_view source, std::vector<Token>& out);
+
+private:
+    CppLexer() = delete;
+};
@@ -1,4 +1,5 @@
 #include "FileUtils.hpp"
+#include "StringUtils.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -11,22 +12,50 @@ namespace fs = std::filesystem;
 
 namespace GameUtils {
 
+    namespace {
+        // Config keys and values are trimmed of spaces and tabs only
+        std::string_view trim_blanks(std::string_view text) {
+            const auto start = text.find_first_not_of(" \t");
+            if (start == std::string_view::npos) {
+                return {};
+            }
+            return text.substr(start, text.find_last_not_of(" \t") - start + 1);
+        }
+
+        // Files are read as bytes, so a line from a CRLF file keeps its '\r'
+        std::string_view without_carriage_return(std::string_view line) {
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            return line;
+        }
+    }
+
     // Read entire file content into a string
     std::optional<std::string> FileUtils::read_file(const std::string& filepath) {
-        std::ifstream file(filepath);
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
         if (!file.is_open()) {
             std::cerr << "Error: Could not open file " << filepath << std::endl;
             return std::nullopt;
         }
         
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        // Size the buffer once and read in a single call
+        const auto size = file.tellg();
+        if (size < 0) {
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }
+        std::string content(static_cast<std::size_t>(size), '\0');
+        file.seekg(0);
+        file.read(content.data(), size);
+        content.resize(static_cast<std::size_t>(file.gcount()));
+        return content;
     }
 
-    // Write content to file
+    // Write content to file, byte for byte like read_file() reads it
     bool FileUtils::write_file(const std::string& filepath, const std::string& content) {
-        std::ofstream file(filepath);
+        std::ofstream file(filepath, std::ios::binary);
         if (!file.is_open()) {
             std::cerr << "Error: Could not create file " << filepath << std::endl;
             return false;
@@ -38,7 +67,7 @@ namespace GameUtils {
 
     // Append content to file
     bool FileUtils::append_to_file(const std::string& filepath, const std::string& content) {
-        std::ofstream file(filepath, std::ios::app);
+        std::ofstream file(filepath, std::ios::binary | std::ios::app);
         if (!file.is_open()) {
             std::cerr << "Error: Could not open file for appending " << filepath << std::endl;
             return false;
@@ -238,24 +267,17 @@ namespace GameUtils {
         }
         
         GameConfig config;
-        std::istringstream iss(*content);
-        std::string line;
         
-        while (std::getline(iss, line)) {
+        for (std::string_view line : StringUtils::splitLazy(*content, '\n')) {
+            line = without_carriage_return(line);
             if (line.empty() || line[0] == '#') continue; // Skip empty lines and comments
             
             auto pos = line.find('=');
-            if (pos != std::string::npos) {
-                std::string key = line.substr(0, pos);
-                std::string value = line.substr(pos + 1);
-                
-                // Trim whitespace (simple implementation)
-                key.erase(0, key.find_first_not_of(" \t"));
-                key.erase(key.find_last_not_of(" \t") + 1);
-                value.erase(0, value.find_first_not_of(" \t"));
-                value.erase(value.find_last_not_of(" \t") + 1);
+            if (pos != std::string_view::npos) {
+                auto key = trim_blanks(line.substr(0, pos));
+                auto value = trim_blanks(line.substr(pos + 1));
                 
-                config.settings[key] = value;
+                config.settings[std::string(key)] = std::string(value);
             }
         }
         
@@ -271,43 +293,50 @@ namespace GameUtils {
         oss << "experience=" << progress.experience << "\n";
         oss << "completed_levels=" << progress.completed_levels << "\n";
         
-        oss << "# Inventory items\n";
-        for (const auto& item : progress.inventory) {
-            oss << "inventory_item=" << item << "\n";
-        }
+        oss << "# Inventory: bit N set for reward id N, in hex\n";
+        oss << "inventory=" << progress.inventory.toHex() << "\n";
         
         return write_file(save_file, oss.str());
     }
 
     // Load game progress
-    std::optional<GameProgress> FileUtils::load_game_progress(const std::string& save_file) {
+    std::optional<GameProgress> FileUtils::load_game_progress(
+        const std::string& save_file,
+        const std::function<std::optional<Inventory::ItemId>(std::string_view)>& resolve_item) {
         auto content = read_file(save_file);
         if (!content) {
             return std::nullopt;
         }
         
         GameProgress progress;
-        std::istringstream iss(*content);
-        std::string line;
         
-        while (std::getline(iss, line)) {
+        for (std::string_view line : StringUtils::splitLazy(*content, '\n')) {
+            line = without_carriage_return(line);
             if (line.empty() || line[0] == '#') continue;
             
             auto pos = line.find('=');
-            if (pos != std::string::npos) {
-                std::string key = line.substr(0, pos);
-                std::string value = line.substr(pos + 1);
+            if (pos != std::string_view::npos) {
+                auto key = line.substr(0, pos);
+                auto value = line.substr(pos + 1);
                 
                 if (key == "player_name") {
-                    progress.player_name = value;
+                    progress.player_name = std::string(value);
                 } else if (key == "current_level") {
-                    progress.current_level = std::stoi(value);
+                    progress.current_level = std::stoi(std::string(value));
                 } else if (key == "experience") {
-                    progress.experience = std::stod(value);
+                    progress.experience = std::stod(std::string(value));
                 } else if (key == "completed_levels") {
-                    progress.completed_levels = std::stoi(value);
-                } else if (key == "inventory_item") {
-                    progress.inventory.push_back(value);
+                    progress.completed_levels = std::stoi(std::string(value));
+                } else if (key == "inventory") {
+                    auto inventory = Inventory::fromHex(value);
+                    if (!inventory) {
+                        return std::nullopt;
+                    }
+                    progress.inventory.merge(*inventory);
+                } else if (key == "inventory_item" && resolve_item) {
+                    if (const auto item = resolve_item(value)) {
+                        progress.inventory.add(*item);
+                    }
                 }
             }
         }
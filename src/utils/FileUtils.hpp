@@ -7,6 +7,9 @@
 #include <optional>
 #include <unordered_map>
 #include <cstddef>
+#include <functional>
+#include <string_view>
+#include "Inventory.hpp"
 
 namespace GameUtils {
 
@@ -59,7 +62,7 @@ namespace GameUtils {
         int current_level = 0;
         double experience = 0.0;
         int completed_levels = 0;
-        std::vector<std::string> inventory;
+        Inventory inventory;            // the level catalog's reward ids
         
         // Constructor
         GameProgress() = default;
@@ -78,12 +81,12 @@ namespace GameUtils {
             }
         }
         
-        void add_inventory_item(const std::string& item) {
-            inventory.push_back(item);
+        void add_inventory_item(Inventory::ItemId item) {
+            inventory.add(item);
         }
         
-        bool has_inventory_item(const std::string& item) const {
-            return std::find(inventory.begin(), inventory.end(), item) != inventory.end();
+        bool has_inventory_item(Inventory::ItemId item) const {
+            return inventory.has(item);
         }
     };
 
@@ -98,7 +101,7 @@ namespace GameUtils {
         // === Core File Operations ===
         
         /**
-         * @brief Read entire file content into a string
+         * @brief Read entire file content into a string, byte for byte
          * @param filepath Path to the file to read
          * @return Optional string containing file content, nullopt if error
          */
@@ -106,6 +109,9 @@ namespace GameUtils {
         
         /**
          * @brief Write content to file (overwrites existing content)
+         *
+         * Binary mode, like read_file(): no '\n' becomes "\r\n" on Windows,
+         * so binary formats round-trip and text files end lines in '\n'.
          * @param filepath Path to the file to write
          * @param content Content to write to the file
          * @return True if successful, false otherwise
@@ -265,9 +271,13 @@ namespace GameUtils {
         /**
          * @brief Load game progress from file
          * @param save_file Path to save file
+         * @param resolve_item Maps item names from older save files, which
+         *        listed each item by name, to ids; unresolved names are dropped
          * @return Optional GameProgress, nullopt if error
          */
-        static std::optional<GameProgress> load_game_progress(const std::string& save_file);
+        static std::optional<GameProgress> load_game_progress(
+            const std::string& save_file,
+            const std::function<std::optional<Inventory::ItemId>(std::string_view)>& resolve_item = {});
         
         /**
          * @brief Create complete project structure for C++ Code Quest
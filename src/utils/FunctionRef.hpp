@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Non-owning reference to a callable: an object pointer and a call thunk.
+ *
+ * Unlike std::function it never allocates and copies nothing, so it suits
+ * parameters that are called during the call and not stored. The thunk is
+ * a plain function instantiated for the callable's type, so the compiler
+ * can inline the callable into it. A referenced callable object must
+ * outlive the FunctionRef; a temporary lambda argument lives until the end
+ * of the full expression. Functions and function pointers are held by value.
+ */
+template<typename Signature>
+class FunctionRef;
+
+template<typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+public:
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef> &&
+                                         std::is_invocable_r_v<R, F&, Args...>>>
+    FunctionRef(F&& callable) noexcept {    // NOLINT: implicit like std::function
+        using Callable = std::remove_reference_t<F>;
+        if constexpr (std::is_function_v<Callable> || std::is_pointer_v<std::decay_t<F>>) {
+            using Pointer = std::decay_t<F>;
+            target_.function = reinterpret_cast<void (*)()>(static_cast<Pointer>(callable));
+            call_ = [](Target target, Args... args) -> R {
+                return reinterpret_cast<Pointer>(target.function)(std::forward<Args>(args)...);
+            };
+        } else {
+            target_.object = const_cast<void*>(static_cast<const void*>(std::addressof(callable)));
+            call_ = [](Target target, Args... args) -> R {
+                return (*static_cast<Callable*>(target.object))(std::forward<Args>(args)...);
+            };
+        }
+    }
+
+    R operator()(Args... args) const { return call_(target_, std::forward<Args>(args)...); }
+
+private:
+    union Target {
+        void* object;
+        void (*function)();
+    };
+
+    Target target_;
+    R (*call_)(Target, Args...);
+};
@@ -0,0 +1,290 @@
+#include "InputReader.hpp"
+#include "Renderer.hpp"
+#include "SimdSearch.hpp"
+#include <iostream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#define CQ_INPUT_POSIX 1
+#endif
+
+InputReader::InputReader(Source source, Options options)
+    : source_(std::move(source)), options_(options) {
+    if (options_.blockSize == 0) {
+        options_.blockSize = Options().blockSize;
+    }
+}
+
+InputReader& InputReader::standardInput() {
+#ifdef CQ_INPUT_POSIX
+    static InputReader reader([source = fromDescriptor(0)](char* buffer, size_t size) {
+        Renderer::standardOutput().drain();
+        std::cout.flush();
+        return source(buffer, size);
+    });
+#else
+    static InputReader reader([source = fromStream(std::cin)](char* buffer, size_t size) {
+        Renderer::standardOutput().drain();
+        return source(buffer, size);
+    });
+#endif
+    return reader;
+}
+
+InputReader::Source InputReader::fromDescriptor(int fd) {
+#ifdef CQ_INPUT_POSIX
+    return [fd](char* buffer, size_t size) -> size_t {
+        while (true) {
+            const ssize_t n = ::read(fd, buffer, size);
+            if (n >= 0) {
+                return static_cast<size_t>(n);
+            }
+            if (errno != EINTR) {
+                return 0;
+            }
+        }
+    };
+#else
+    (void)fd;
+    return fromStream(std::cin);
+#endif
+}
+
+InputReader::Source InputReader::fromStream(std::istream& in) {
+    // One blocking byte, then whatever the stream already has buffered
+    return [&in](char* buffer, size_t size) -> size_t {
+        if (size == 0 || !in.get(buffer[0])) {
+            return 0;
+        }
+        return 1 + static_cast<size_t>(in.readsome(buffer + 1, static_cast<std::streamsize>(size - 1)));
+    };
+}
+
+InputReader::Source InputReader::fromText(std::string_view text) {
+    return [text, offset = size_t(0)](char* buffer, size_t size) mutable {
+        const size_t n = text.copy(buffer, size, offset);
+        offset += n;
+        return n;
+    };
+}
+
+InputReader::Fill InputReader::fill() {
+    if (ended_) {
+        return Fill::Ended;
+    }
+    if (!source_) {
+        return Fill::Pending;       // feed() appends to the buffer directly
+    }
+    const size_t used = buffer_.size();
+    buffer_.resize(used + options_.blockSize);
+    ++readCalls_;
+    const size_t n = source_(buffer_.data() + used, options_.blockSize);
+    buffer_.resize(used + n);
+    ended_ = n == 0;
+    if (tap_ && n > 0) {
+        tap_(std::string_view(buffer_).substr(used));
+    }
+    return ended_ ? Fill::Ended : Fill::Data;
+}
+
+void InputReader::compact() {
+    buffer_.erase(0, begin_);
+    begin_ = 0;
+}
+
+bool InputReader::isSentinel(std::string_view line, std::string_view sentinel) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line == sentinel;
+}
+
+bool InputReader::readLine(std::string& line) {
+    // Only a fed reader can be pending, and it has no input yet
+    return tryReadLine(line).value_or(false);
+}
+
+InputReader::Status InputReader::readSubmission(std::string& code, std::string_view sentinel,
+                                                const LineCallback& onLine) {
+    return tryReadSubmission(code, sentinel, onLine).value_or(Status::EndOfInput);
+}
+
+std::optional<bool> InputReader::tryReadLine(std::string& line) {
+    // A fed reader resumes the search where the last feed() left it, so a
+    // line arriving in many pieces is scanned once
+    while (true) {
+        const size_t newline = SimdSearch::findByte(buffer_, '\n', begin_ + lineScan_);
+        if (newline != SimdSearch::npos) {
+            lineScan_ = 0;
+            if (std::exchange(skippingLine_, false)) {
+                begin_ = newline + 1;
+                continue;
+            }
+            line.assign(buffer_, begin_, newline - begin_);
+            begin_ = newline + 1;
+            return true;
+        }
+        // Keep only the partial line before reading more, and not even that
+        // once it is too long
+        if (skippingLine_ || buffer_.size() - begin_ > options_.maxLineBytes) {
+            skippingLine_ = true;
+            begin_ = buffer_.size();
+        }
+        compact();
+        lineScan_ = buffer_.size();
+        switch (fill()) {
+        case Fill::Data:
+            continue;
+        case Fill::Pending:
+            return std::nullopt;
+        case Fill::Ended:
+            lineScan_ = 0;
+            skippingLine_ = false;
+            if (buffer_.empty()) {
+                line.clear();
+                return false;
+            }
+            line.assign(buffer_);
+            buffer_.clear();
+            return true;
+        }
+    }
+}
+
+std::optional<InputReader::Status> InputReader::tryReadSubmission(std::string& code, std::string_view sentinel,
+                                                                   const LineCallback& onLine) {
+    // The submission is built in place: unread input starts at 0, so the
+    // lines before the sentinel are already the final text
+    auto& state = submission_;
+    if (!state.active) {
+        compact();
+        state = SubmissionState();
+        state.active = true;
+        lineScan_ = 0;
+        skippingLine_ = false;
+    }
+    while (true) {
+        if (state.skipping) {
+            if (!skipThrough(sentinel)) {
+                return std::nullopt;
+            }
+            state = SubmissionState();
+            code.clear();
+            return Status::TooLarge;
+        }
+
+        const size_t newline = SimdSearch::findByte(buffer_, '\n', state.scan);
+        if (newline == SimdSearch::npos) {
+            state.scan = buffer_.size();
+            if (buffer_.size() > options_.maxSubmissionBytes + sentinel.size() + 1) {
+                buffer_.erase(0, state.lineStart);
+                begin_ = 0;
+                state.skipping = true;
+                continue;
+            }
+            switch (fill()) {
+            case Fill::Data:
+                continue;
+            case Fill::Pending:
+                return std::nullopt;
+            case Fill::Ended:
+                if (state.lineStart < buffer_.size()) {
+                    buffer_ += '\n';
+                }
+                code = std::move(buffer_);
+                buffer_.clear();
+                state = SubmissionState();
+                return Status::EndOfInput;
+            }
+        }
+
+        if (isSentinel(std::string_view(buffer_).substr(state.lineStart, newline - state.lineStart), sentinel)) {
+            std::string rest = buffer_.substr(newline + 1);
+            buffer_.resize(state.lineStart);
+            code = std::move(buffer_);
+            buffer_ = std::move(rest);
+            begin_ = 0;
+            state = SubmissionState();
+            return Status::Complete;
+        }
+        if (newline + 1 > options_.maxSubmissionBytes) {
+            begin_ = newline + 1;
+            compact();
+            state.skipping = true;
+            continue;
+        }
+
+        state.lineStart = state.scan = newline + 1;
+        if (onLine) {
+            onLine(std::string_view(buffer_.data(), state.lineStart));
+        }
+    }
+}
+
+bool InputReader::skipThrough(std::string_view sentinel) {
+    // Lines are dropped as they complete, and an unfinished line only while
+    // it is too long to be the sentinel, so memory stays at a block or two
+    auto& state = submission_;
+    while (true) {
+        const size_t newline = SimdSearch::findByte(buffer_, '\n', begin_);
+        if (newline != SimdSearch::npos) {
+            const bool found = !state.partialIsLong &&
+                               isSentinel(std::string_view(buffer_).substr(begin_, newline - begin_), sentinel);
+            begin_ = newline + 1;
+            state.partialIsLong = false;
+            if (found) {
+                compact();
+                return true;
+            }
+            continue;
+        }
+        if (buffer_.size() - begin_ > sentinel.size() + 1) {
+            state.partialIsLong = true;
+            begin_ = buffer_.size();
+        }
+        compact();
+        switch (fill()) {
+        case Fill::Data:
+            continue;
+        case Fill::Pending:
+            return false;
+        case Fill::Ended:
+            buffer_.clear();
+            return true;
+        }
+    }
+}
+
+bool InputReader::LineAwaiter::attempt() {
+    const auto result = reader_.tryReadLine(line_);
+    result_ = result.value_or(false);
+    return result.has_value();
+}
+
+bool InputReader::SubmissionAwaiter::attempt() {
+    const auto result = reader_.tryReadSubmission(code_, sentinel_, onLine_);
+    result_ = result.value_or(Status::EndOfInput);
+    return result.has_value();
+}
+
+void InputReader::feed(std::string_view data) {
+    if (tap_) {
+        tap_(data);
+    }
+    buffer_ += data;
+    resumeWaiting();
+}
+
+void InputReader::closeInput() {
+    ended_ = true;
+    resumeWaiting();
+}
+
+void InputReader::resumeWaiting() {
+    if (waiting_ && waiting_->attempt()) {
+        const auto handle = std::exchange(waiting_, nullptr)->handle_;
+        handle.resume();
+    }
+}
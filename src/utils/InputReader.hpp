@@ -0,0 +1,191 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * Block-buffered reader for lines and multi-line submissions.
+ *
+ * Input is pulled in large blocks into one growable buffer and line ends are
+ * found with the vectorized byte search, so a pasted or piped submission
+ * costs a few reads and no per-line allocations. A finished submission is
+ * handed out by moving the buffer, not by copying it.
+ *
+ * Everything that reads the terminal must go through the same reader
+ * (standardInput()), since a block read takes bytes that later prompts need.
+ *
+ * A reader built without a source is fed: an event loop hands it bytes with
+ * feed() and closeInput(), and coroutines read through line() and
+ * submission(), which suspend until enough input has arrived. The same
+ * awaitables never suspend on a reader with a source, whose blocking reads
+ * happen inside them, so one coroutine serves both. Not thread-safe.
+ */
+class InputReader {
+public:
+    struct Options {
+        size_t blockSize = 64 * 1024;
+        size_t maxSubmissionBytes = 1024 * 1024;
+        size_t maxLineBytes = 64 * 1024;    // longer lines are dropped, up to their '\n'
+    };
+
+    // Fills up to `size` bytes and returns how many; fewer when that is all
+    // there is for now (an interactive line), 0 at end of input
+    using Source = std::function<size_t(char* buffer, size_t size)>;
+
+    enum class Status : std::uint8_t {
+        Complete,       // the sentinel line was read
+        EndOfInput,     // input ended first; the code read so far is kept
+        TooLarge        // over maxSubmissionBytes; skipped up to the sentinel
+    };
+
+    InputReader(Source source, Options options);
+    explicit InputReader(Source source) : InputReader(std::move(source), Options()) {}
+    // Fed with feed() and closeInput()
+    explicit InputReader(Options options) : InputReader(Source(), options) {}
+
+    // Reads stdin through read(2) where available, first writing out the
+    // Renderer::standardOutput() frame and std::cout as a tied std::cin would
+    static InputReader& standardInput();
+
+    static Source fromDescriptor(int fd);
+    static Source fromStream(std::istream& in);
+    // Reads `text`, which must outlive the reader, a block at a time
+    static Source fromText(std::string_view text);
+
+    using LineCallback = std::function<void(std::string_view)>;
+
+    // One line without its '\n', like std::getline; false at end of input.
+    // A line over maxLineBytes is skipped and the next one returned.
+    bool readLine(std::string& line);
+
+    // Lines up to one that is exactly `sentinel` (a trailing '\r' is
+    // allowed) become `code`, each ending in '\n'. `onLine` sees the code so
+    // far after every line; the view is only valid during the call.
+    Status readSubmission(std::string& code, std::string_view sentinel, const LineCallback& onLine = {});
+
+    // A fed reader can only answer these once its input has arrived, so
+    // coroutines await them instead
+    class Awaiter {
+    public:
+        bool await_ready() { return attempt(); }
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            reader_.waiting_ = this;
+        }
+
+    protected:
+        explicit Awaiter(InputReader& reader) : reader_(reader) {}
+        ~Awaiter() = default;
+
+        // True once the result is in
+        virtual bool attempt() = 0;
+
+        InputReader& reader_;
+
+    private:
+        friend class InputReader;
+        std::coroutine_handle<> handle_;
+    };
+
+    class LineAwaiter final : public Awaiter {
+    public:
+        LineAwaiter(InputReader& reader, std::string& line) : Awaiter(reader), line_(line) {}
+        bool await_resume() const { return result_; }
+
+    private:
+        std::string& line_;
+        bool result_ = false;
+        bool attempt() override;
+    };
+
+    class SubmissionAwaiter final : public Awaiter {
+    public:
+        SubmissionAwaiter(InputReader& reader, std::string& code, std::string_view sentinel,
+                          const LineCallback& onLine)
+            : Awaiter(reader), code_(code), sentinel_(sentinel), onLine_(onLine) {}
+        Status await_resume() const { return result_; }
+
+    private:
+        std::string& code_;
+        std::string_view sentinel_;
+        const LineCallback& onLine_;
+        Status result_ = Status::EndOfInput;
+        bool attempt() override;
+    };
+
+    // co_await line(s) and co_await submission(...) as readLine() and
+    // readSubmission(); `onLine` must outlive the await
+    [[nodiscard]] LineAwaiter line(std::string& line) { return LineAwaiter(*this, line); }
+    [[nodiscard]] SubmissionAwaiter submission(std::string& code, std::string_view sentinel,
+                                               const LineCallback& onLine = {}) {
+        return SubmissionAwaiter(*this, code, sentinel, onLine);
+    }
+
+    // For a fed reader: appends input, or ends it, and resumes the coroutine
+    // waiting on this reader once it can continue
+    void feed(std::string_view data);
+    void closeInput();
+
+    // A coroutine is suspended on this reader
+    bool waiting() const { return waiting_ != nullptr; }
+
+    // Bytes held that no read has consumed yet
+    size_t buffered() const { return buffer_.size() - begin_; }
+
+    // Sees every piece of input as it arrives, from the source or feed(),
+    // before anything reads it; empty to remove
+    using Tap = std::function<void(std::string_view)>;
+    void setTap(Tap tap) { tap_ = std::move(tap); }
+
+    const Options& options() const { return options_; }
+    void setMaxSubmissionBytes(size_t bytes) { options_.maxSubmissionBytes = bytes; }
+
+    // Source calls so far, for benchmarks
+    size_t readCalls() const { return readCalls_; }
+
+private:
+    enum class Fill : std::uint8_t { Data, Pending, Ended };
+
+    // Where an unfinished readSubmission() stopped, so a fed reader can
+    // continue it when more input arrives
+    struct SubmissionState {
+        bool active = false;
+        bool skipping = false;      // too large; dropping lines up to the sentinel
+        bool partialIsLong = false; // while skipping: the unfinished line cannot be the sentinel
+        size_t lineStart = 0;
+        size_t scan = 0;
+    };
+
+    Source source_;
+    Options options_;
+    std::string buffer_;
+    size_t begin_ = 0;          // first unread byte
+    size_t lineScan_ = 0;       // unread bytes a pending readLine() found no '\n' in
+    bool skippingLine_ = false; // a pending readLine() is dropping an overlong line
+    size_t readCalls_ = 0;
+    bool ended_ = false;
+    SubmissionState submission_;
+    Awaiter* waiting_ = nullptr;
+    Tap tap_;
+
+    // Appends one block from the source; a fed reader has none to pull
+    Fill fill();
+    void compact();
+
+    // Each returns nothing while a fed reader waits for more input
+    std::optional<bool> tryReadLine(std::string& line);
+    std::optional<Status> tryReadSubmission(std::string& code, std::string_view sentinel,
+                                            const LineCallback& onLine);
+    // Drops whole lines up to and including the sentinel; false while pending
+    bool skipThrough(std::string_view sentinel);
+    static bool isSentinel(std::string_view line, std::string_view sentinel);
+
+    void resumeWaiting();
+};
@@ -0,0 +1,47 @@
+#include "Inventory.hpp"
+
+std::string Inventory::toHex() const {
+    static const char* const kHex = "0123456789abcdef";
+    std::string text;
+    for (size_t index = high_.size() + 1; index-- > 0;) {
+        const std::uint64_t w = word(index);
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            const auto digit = static_cast<size_t>((w >> shift) & 0xF);
+            if (digit != 0 || !text.empty()) {
+                text += kHex[digit];
+            }
+        }
+    }
+    return text.empty() ? "0" : text;
+}
+
+std::optional<Inventory> Inventory::fromHex(std::string_view text) {
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    Inventory inventory;
+    ItemId id = 0;
+    // The last digit holds ids 0-3
+    for (size_t i = text.size(); i-- > 0; id += 4) {
+        const char c = text[i];
+        unsigned digit = 0;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<unsigned>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<unsigned>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = static_cast<unsigned>(c - 'A' + 10);
+        } else {
+            return std::nullopt;
+        }
+        for (ItemId bit = 0; bit < 4; ++bit) {
+            if (digit & (1u << bit)) {
+                if (id + bit > kMaxId) {
+                    return std::nullopt;
+                }
+                inventory.add(id + bit);
+            }
+        }
+    }
+    return inventory;
+}
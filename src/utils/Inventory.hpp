@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BitUtils.hpp"
+
+/**
+ * A player's items as a bitset over small integer ids.
+ *
+ * Ids come from interning item names once (LevelCatalog numbers its
+ * rewards), so membership is one bit test and union or subset checks are a
+ * few word operations, with no string compares. Ids below 64 live in an
+ * inline word, so the usual inventory never allocates.
+ *
+ * toHex() is the compact save form: the set as one hexadecimal number, bit
+ * N for id N ("0" when empty, "13" for ids 0, 1 and 4).
+ */
+class Inventory {
+public:
+    using ItemId = std::uint32_t;
+
+    // The largest id fromHex() accepts, so a save file cannot demand a huge set
+    static constexpr ItemId kMaxId = 65535;
+
+    void add(ItemId id) {
+        const size_t index = id / 64;
+        if (index > high_.size()) {
+            high_.resize(index, 0);
+        }
+        word(index) |= bit(id);
+    }
+
+    bool has(ItemId id) const {
+        const size_t index = id / 64;
+        return index <= high_.size() && (word(index) & bit(id)) != 0;
+    }
+
+    // Union
+    void merge(const Inventory& other) {
+        if (other.high_.size() > high_.size()) {
+            high_.resize(other.high_.size(), 0);
+        }
+        low_ |= other.low_;
+        for (size_t i = 0; i < other.high_.size(); ++i) {
+            high_[i] |= other.high_[i];
+        }
+    }
+
+    // Every item of `other` is also here
+    bool includes(const Inventory& other) const {
+        if ((other.low_ & ~low_) != 0) {
+            return false;
+        }
+        for (size_t i = 0; i < other.high_.size(); ++i) {
+            const std::uint64_t mine = i < high_.size() ? high_[i] : 0;
+            if ((other.high_[i] & ~mine) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t count() const {
+        size_t total = BitUtils::popCount64(low_);
+        for (const auto w : high_) {
+            total += BitUtils::popCount64(w);
+        }
+        return total;
+    }
+
+    bool empty() const { return count() == 0; }
+
+    void clear() {
+        low_ = 0;
+        high_.clear();
+    }
+
+    // Calls fn(id) for every item, in ascending id order
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t index = 0; index <= high_.size(); ++index) {
+            for (std::uint64_t w = word(index); w != 0; w &= w - 1) {
+                fn(static_cast<ItemId>(index * 64 + BitUtils::countTrailingZeros64(w)));
+            }
+        }
+    }
+
+    bool operator==(const Inventory& other) const { return includes(other) && other.includes(*this); }
+    bool operator!=(const Inventory& other) const { return !(*this == other); }
+
+    std::string toHex() const;
+    // nullopt unless `text` is hex digits naming ids up to kMaxId
+    static std::optional<Inventory> fromHex(std::string_view text);
+
+private:
+    std::uint64_t low_ = 0;                 // ids 0-63
+    std::vector<std::uint64_t> high_;       // ids from 64, 64 per word
+
+    static std::uint64_t bit(ItemId id) { return std::uint64_t{1} << (id % 64); }
+    std::uint64_t& word(size_t index) { return index == 0 ? low_ : high_[index - 1]; }
+    std::uint64_t word(size_t index) const { return index == 0 ? low_ : high_[index - 1]; }
+};
@@ -0,0 +1,367 @@
+#include "MultiPatternMatcher.hpp"
+#include "BitUtils.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CQ_MATCHER_SSE2 1
+#endif
+
+namespace {
+
+constexpr std::uint32_t kNoTransition = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint32_t kAcceptFlag = 0x80000000u;
+constexpr std::uint32_t kRowMask = ~kAcceptFlag;
+
+// Beyond this many distinct start bytes the vector compare chain stops paying off
+constexpr size_t kMaxVectorStartBytes = 8;
+
+// Tracks which distinct patterns have been seen. Sets of up to 64 patterns
+// (every validator in the game) never touch the heap.
+class FoundSet {
+public:
+    explicit FoundSet(size_t size) {
+        if (size > 64) {
+            large_.assign(size, 0);
+        }
+    }
+
+    // Returns true the first time an id is inserted
+    bool insert(std::uint32_t id) {
+        if (large_.empty()) {
+            const std::uint64_t bit = std::uint64_t{1} << id;
+            if (small_ & bit) {
+                return false;
+            }
+            small_ |= bit;
+            return true;
+        }
+        if (large_[id]) {
+            return false;
+        }
+        large_[id] = 1;
+        return true;
+    }
+
+private:
+    std::uint64_t small_ = 0;
+    std::vector<char> large_;
+};
+
+std::vector<std::string_view> toViews(const std::vector<std::string>& patterns) {
+    return std::vector<std::string_view>(patterns.begin(), patterns.end());
+}
+
+} // namespace
+
+MultiPatternMatcher::MultiPatternMatcher(const std::vector<std::string>& patterns) {
+    build(toViews(patterns));
+}
+
+void MultiPatternMatcher::build(const std::vector<std::string_view>& patterns) {
+    patternCount_ = patterns.size();
+    patternIds_.reserve(patterns.size());
+
+    // Deduplicate so containsAll can finish as soon as every distinct needle is seen
+    std::unordered_map<std::string_view, std::uint32_t> distinct;
+    std::vector<std::string_view> needles;
+    for (const auto& pattern : patterns) {
+        auto [it, inserted] = distinct.emplace(pattern, static_cast<std::uint32_t>(needles.size()));
+        if (inserted) {
+            needles.push_back(pattern);
+        }
+        patternIds_.push_back(it->second);
+    }
+    distinctCount_ = needles.size();
+
+    // Compress the alphabet to the bytes that actually occur in a needle
+    for (const auto& needle : needles) {
+        for (char c : needle) {
+            auto& cls = byteClass_[static_cast<unsigned char>(c)];
+            if (cls == 0) {
+                cls = static_cast<std::uint16_t>(classCount_++);
+            }
+        }
+    }
+
+    // Trie construction
+    std::vector<State> trie(classCount_, kNoTransition);
+    std::vector<std::vector<std::uint32_t>> stateOutputs(1);
+
+    for (std::uint32_t id = 0; id < needles.size(); ++id) {
+        const auto needle = needles[id];
+        if (needle.empty()) {
+            emptyPatternId_ = id;
+            continue;
+        }
+
+        State state = 0;
+        for (char c : needle) {
+            const size_t slot = state * classCount_ + byteClass_[static_cast<unsigned char>(c)];
+            if (trie[slot] == kNoTransition) {
+                trie[slot] = static_cast<State>(stateOutputs.size());
+                stateOutputs.emplace_back();
+                trie.resize(trie.size() + classCount_, kNoTransition);
+            }
+            state = trie[slot];
+        }
+        stateOutputs[state].push_back(id);
+    }
+
+    // Breadth-first pass: resolve failure links into a full DFA and inherit
+    // the outputs of each state's longest proper suffix
+    const size_t stateCount = stateOutputs.size();
+    transitions_ = std::move(trie);
+    std::vector<State> failure(stateCount, 0);
+    std::queue<State> pending;
+
+    for (size_t cls = 0; cls < classCount_; ++cls) {
+        auto& next = transitions_[cls];
+        if (next == kNoTransition) {
+            next = 0;
+        } else {
+            pending.push(next);
+        }
+    }
+
+    while (!pending.empty()) {
+        const State state = pending.front();
+        pending.pop();
+
+        const auto& inherited = stateOutputs[failure[state]];
+        stateOutputs[state].insert(stateOutputs[state].end(), inherited.begin(), inherited.end());
+
+        for (size_t cls = 0; cls < classCount_; ++cls) {
+            auto& next = transitions_[state * classCount_ + cls];
+            const State fallback = transitions_[failure[state] * classCount_ + cls];
+            if (next == kNoTransition) {
+                next = fallback;
+            } else {
+                failure[next] = fallback;
+                pending.push(next);
+            }
+        }
+    }
+
+    // Flatten outputs for cache-friendly scanning
+    outputBegin_.reserve(stateCount + 1);
+    for (const auto& ids : stateOutputs) {
+        outputBegin_.push_back(static_cast<std::uint32_t>(outputs_.size()));
+        outputs_.insert(outputs_.end(), ids.begin(), ids.end());
+    }
+    outputBegin_.push_back(static_cast<std::uint32_t>(outputs_.size()));
+
+    // Re-encode targets as tagged row offsets
+    for (auto& next : transitions_) {
+        const State target = next;
+        next = static_cast<State>(target * classCount_);
+        if (!stateOutputs[target].empty()) {
+            next |= kAcceptFlag;
+        }
+    }
+
+    for (const auto& needle : needles) {
+        if (needle.empty()) {
+            continue;
+        }
+
+        startByte_[static_cast<unsigned char>(needle[0])] = true;
+        if (needle.size() == 1) {
+            singleBytes_.push_back(static_cast<unsigned char>(needle[0]));
+        } else {
+            startPairs_.push_back({static_cast<unsigned char>(needle[0]),
+                                   static_cast<unsigned char>(needle[1])});
+        }
+    }
+
+    std::sort(startPairs_.begin(), startPairs_.end());
+    startPairs_.erase(std::unique(startPairs_.begin(), startPairs_.end()), startPairs_.end());
+    std::sort(singleBytes_.begin(), singleBytes_.end());
+    singleBytes_.erase(std::unique(singleBytes_.begin(), singleBytes_.end()), singleBytes_.end());
+}
+
+#ifdef CQ_MATCHER_SSE2
+namespace {
+
+// Candidate filter for 16 positions at once: bit i is set when the bytes at
+// block+i (and block+i+1) could begin a pattern.
+class StartFilter {
+public:
+    StartFilter(const std::vector<std::array<unsigned char, 2>>& pairs,
+                const std::vector<unsigned char>& singles)
+        : pairCount_(pairs.size()), singleCount_(singles.size()) {
+        for (size_t i = 0; i < pairCount_; ++i) {
+            first_[i] = _mm_set1_epi8(static_cast<char>(pairs[i][0]));
+            second_[i] = _mm_set1_epi8(static_cast<char>(pairs[i][1]));
+        }
+        for (size_t i = 0; i < singleCount_; ++i) {
+            single_[i] = _mm_set1_epi8(static_cast<char>(singles[i]));
+        }
+    }
+
+    static bool usable(size_t pairs, size_t singles) {
+        return pairs + singles != 0 && pairs <= kMaxVectorStartBytes && singles <= kMaxVectorStartBytes;
+    }
+
+    // Requires 17 readable bytes at block
+    unsigned candidates(const char* block) const {
+        const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 1));
+        __m128i hits = _mm_setzero_si128();
+        for (size_t i = 0; i < pairCount_; ++i) {
+            hits = _mm_or_si128(hits, _mm_and_si128(_mm_cmpeq_epi8(current, first_[i]),
+                                                    _mm_cmpeq_epi8(next, second_[i])));
+        }
+        for (size_t i = 0; i < singleCount_; ++i) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(current, single_[i]));
+        }
+        return static_cast<unsigned>(_mm_movemask_epi8(hits));
+    }
+
+private:
+    __m128i first_[kMaxVectorStartBytes];
+    __m128i second_[kMaxVectorStartBytes];
+    __m128i single_[kMaxVectorStartBytes];
+    size_t pairCount_;
+    size_t singleCount_;
+};
+
+} // namespace
+#endif
+
+template<typename Callback>
+void MultiPatternMatcher::scan(std::string_view text, Callback&& onMatch) const {
+    if (transitions_.empty()) {
+        return;
+    }
+
+    const State* table = transitions_.data();
+    const std::uint16_t* classes = byteClass_.data();
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+    State cell = 0;
+    size_t pos = 0;
+
+#ifdef CQ_MATCHER_SSE2
+    const bool vectorSkip = StartFilter::usable(startPairs_.size(), singleBytes_.size());
+    const StartFilter filter = vectorSkip ? StartFilter(startPairs_, singleBytes_)
+                                          : StartFilter({}, {});
+    size_t blockBase = 0;
+    unsigned blockMask = 0;
+#endif
+
+    while (pos < size) {
+        if (cell == 0) {
+#ifdef CQ_MATCHER_SSE2
+            // Pull the next candidate from the current block, refilling as needed
+            if (vectorSkip) {
+                if (pos >= blockBase + 16) {
+                    blockMask = 0;
+                } else if (blockMask != 0) {
+                    const size_t consumed = pos - blockBase;
+                    blockMask &= ~((1u << consumed) - 1u);
+                }
+
+                while (blockMask == 0 && pos + 17 <= size) {
+                    blockBase = pos;
+                    blockMask = filter.candidates(text.data() + pos);
+                    if (blockMask == 0) {
+                        pos += 16;
+                    }
+                }
+
+                if (blockMask != 0) {
+                    pos = blockBase + BitUtils::countTrailingZeros(blockMask);
+                }
+            }
+#endif
+            while (pos < size && !startByte_[bytes[pos]]) {
+                ++pos;
+            }
+            if (pos == size) {
+                return;
+            }
+        }
+
+        cell = table[(cell & kRowMask) + classes[bytes[pos]]];
+        ++pos;
+
+        if (cell & kAcceptFlag) {
+            const size_t state = (cell & kRowMask) / classCount_;
+            for (auto i = outputBegin_[state]; i < outputBegin_[state + 1]; ++i) {
+                if (!onMatch(outputs_[i])) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+bool MultiPatternMatcher::containsAll(std::string_view text) const {
+    FoundSet found(distinctCount_);
+    size_t remaining = distinctCount_;
+
+    if (emptyPatternId_ != SIZE_MAX) {
+        found.insert(static_cast<std::uint32_t>(emptyPatternId_));
+        --remaining;
+    }
+    if (remaining == 0) {
+        return true;
+    }
+
+    scan(text, [&](std::uint32_t id) {
+        if (found.insert(id)) {
+            --remaining;
+        }
+        return remaining != 0;
+    });
+
+    return remaining == 0;
+}
+
+bool MultiPatternMatcher::containsAny(std::string_view text) const {
+    if (emptyPatternId_ != SIZE_MAX) {
+        return true;
+    }
+
+    bool matched = false;
+    scan(text, [&](std::uint32_t) {
+        matched = true;
+        return false;
+    });
+
+    return matched;
+}
+
+std::vector<std::size_t> MultiPatternMatcher::findMatched(std::string_view text) const {
+    std::vector<char> seen(distinctCount_, 0);
+    size_t remaining = distinctCount_;
+
+    if (emptyPatternId_ != SIZE_MAX) {
+        seen[emptyPatternId_] = 1;
+        --remaining;
+    }
+
+    if (remaining != 0) {
+        scan(text, [&](std::uint32_t id) {
+            if (!seen[id]) {
+                seen[id] = 1;
+                --remaining;
+            }
+            return remaining != 0;
+        });
+    }
+
+    // Report in terms of the caller's pattern indices, duplicates included
+    std::vector<std::size_t> matched;
+    for (size_t i = 0; i < patternIds_.size(); ++i) {
+        if (seen[patternIds_[i]]) {
+            matched.push_back(i);
+        }
+    }
+
+    return matched;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Aho-Corasick automaton compiled once from a fixed set of needles.
+ *
+ * Every query (containsAll / containsAny / findMatched) is a single left-to-right
+ * scan of the text, independent of the number of needles. Build one per needle
+ * set and reuse it; the matcher is immutable after construction and safe to
+ * share between threads.
+ */
+class MultiPatternMatcher {
+public:
+    MultiPatternMatcher() = default;
+    explicit MultiPatternMatcher(const std::vector<std::string>& patterns);
+
+    // Queries
+    bool containsAll(std::string_view text) const;
+    bool containsAny(std::string_view text) const;
+    std::vector<std::size_t> findMatched(std::string_view text) const;
+
+    size_t patternCount() const { return patternCount_; }
+
+private:
+    using State = std::uint32_t;
+
+    // Bytes that occur in some pattern get their own column; every other byte
+    // shares column 0, which keeps the transition table small.
+    std::array<std::uint16_t, 256> byteClass_{};
+    size_t classCount_ = 1;
+
+    // Transitions hold the target's row offset (state * classCount_) so the
+    // scan loop never multiplies; kAcceptFlag marks targets with outputs.
+    std::vector<State> transitions_;
+    std::vector<std::uint32_t> outputBegin_;      // per state, into outputs_
+    std::vector<std::uint32_t> outputs_;          // distinct-pattern ids
+    std::vector<std::uint32_t> patternIds_;       // input index -> distinct id
+    size_t patternCount_ = 0;
+    size_t distinctCount_ = 0;
+    size_t emptyPatternId_ = SIZE_MAX;            // "" matches every text
+
+    // Root-state skipping: only positions that begin a two-byte pattern prefix
+    // (or a one-byte pattern) can start a match, so everything else is skipped
+    // in bulk. startByte_ is the scalar fallback filter on the first byte only.
+    std::array<bool, 256> startByte_{};
+    std::vector<std::array<unsigned char, 2>> startPairs_;
+    std::vector<unsigned char> singleBytes_;
+
+    template<typename Callback>
+    void scan(std::string_view text, Callback&& onMatch) const;
+
+    void build(const std::vector<std::string_view>& patterns);
+};
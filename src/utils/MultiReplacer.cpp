@@ -0,0 +1,84 @@
+#include "MultiReplacer.hpp"
+#include "SimdSearch.hpp"
+
+namespace {
+
+struct Match {
+    size_t pos;
+    size_t rule;
+};
+
+std::string_view fromOf(const MultiReplacer::Rule& rule) { return rule.first; }
+std::string_view toOf(const MultiReplacer::Rule& rule) { return rule.second; }
+std::string_view fromOf(const std::pair<std::string_view, std::string_view>& rule) { return rule.first; }
+std::string_view toOf(const std::pair<std::string_view, std::string_view>& rule) { return rule.second; }
+
+// Shared engine for the owning and borrowing forms. Each rule keeps the
+// position of its next occurrence, which only ever moves forward, so every
+// rule scans the text at most once.
+template<typename RuleT>
+std::string replaceRules(std::string_view text, const RuleT* rules, size_t count) {
+    std::vector<size_t> next(count, SimdSearch::npos);
+    for (size_t i = 0; i < count; ++i) {
+        if (!fromOf(rules[i]).empty()) {
+            next[i] = SimdSearch::find(text, fromOf(rules[i]));
+        }
+    }
+
+    // Pass 1: pick matches and work out the exact output size
+    std::vector<Match> matches;
+    size_t outputSize = text.size();
+    size_t pos = 0;
+
+    while (true) {
+        size_t best = count;
+        for (size_t i = 0; i < count; ++i) {
+            if (next[i] == SimdSearch::npos) {
+                continue;
+            }
+            if (next[i] < pos) {
+                next[i] = SimdSearch::find(text, fromOf(rules[i]), pos);
+                if (next[i] == SimdSearch::npos) {
+                    continue;
+                }
+            }
+            if (best == count || next[i] < next[best]) {
+                best = i;
+            }
+        }
+        if (best == count) {
+            break;
+        }
+
+        matches.push_back({next[best], best});
+        outputSize = outputSize - fromOf(rules[best]).size() + toOf(rules[best]).size();
+        pos = next[best] + fromOf(rules[best]).size();
+    }
+
+    // Pass 2: copy unchanged spans and replacements into the pre-sized buffer
+    std::string result;
+    result.reserve(outputSize);
+    size_t copied = 0;
+    for (const auto& match : matches) {
+        result.append(text.data() + copied, match.pos - copied);
+        result.append(toOf(rules[match.rule]));
+        copied = match.pos + fromOf(rules[match.rule]).size();
+    }
+    result.append(text.data() + copied, text.size() - copied);
+
+    return result;
+}
+
+} // namespace
+
+MultiReplacer::MultiReplacer(std::vector<Rule> rules)
+    : rules_(std::move(rules)) {}
+
+std::string MultiReplacer::apply(std::string_view text) const {
+    return replaceRules(text, rules_.data(), rules_.size());
+}
+
+std::string MultiReplacer::apply(std::string_view text, std::string_view from, std::string_view to) {
+    const std::pair<std::string_view, std::string_view> rule{from, to};
+    return replaceRules(text, &rule, 1);
+}
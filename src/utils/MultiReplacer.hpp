@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Applies a fixed set of from -> to rules in a single left-to-right pass.
+ *
+ * At every position the leftmost occurrence of any rule wins; when several
+ * rules match at the same position the one listed first is used. Replacement
+ * text is never rescanned, so rules do not feed into each other the way
+ * chained replaceAll calls do. Rules with an empty "from" never match.
+ *
+ * The output is assembled once into a buffer of exactly the final size, so
+ * the cost is linear in the input no matter how many hits there are.
+ */
+class MultiReplacer {
+public:
+    using Rule = std::pair<std::string, std::string>;
+
+    MultiReplacer() = default;
+    explicit MultiReplacer(std::vector<Rule> rules);
+
+    std::string apply(std::string_view text) const;
+
+    size_t ruleCount() const { return rules_.size(); }
+
+    // Single-rule form used by StringUtils::replaceAll; borrows its arguments
+    static std::string apply(std::string_view text, std::string_view from, std::string_view to);
+
+private:
+    std::vector<Rule> rules_;
+};
@@ -0,0 +1,154 @@
+#include "Renderer.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#define CQ_RENDER_POSIX 1
+#endif
+
+Renderer::Renderer(Sink sink, Waiter waiter)
+    : sink_(std::move(sink)), waiter_(std::move(waiter)) {}
+
+Renderer& Renderer::standardOutput() {
+#ifdef CQ_RENDER_POSIX
+    static Renderer renderer(
+        [sink = toDescriptor(1)](std::string_view frame) {
+            std::cout.flush();
+            sink(frame);
+        },
+        [](Clock::time_point deadline) {
+            // Typed-ahead input ends the pause
+            while (true) {
+                const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+                if (left.count() <= 0) {
+                    return;
+                }
+                pollfd input{0, POLLIN, 0};
+                const int ready = ::poll(&input, 1, static_cast<int>(left.count()));
+                if (ready > 0 || (ready < 0 && errno != EINTR)) {
+                    return;
+                }
+            }
+        });
+#else
+    static Renderer renderer(toStream(std::cout),
+                             [](Clock::time_point deadline) { std::this_thread::sleep_until(deadline); });
+#endif
+    return renderer;
+}
+
+Renderer::Sink Renderer::toDescriptor(int fd) {
+#ifdef CQ_RENDER_POSIX
+    return [fd](std::string_view frame) {
+        while (!frame.empty()) {
+            const ssize_t n = ::write(fd, frame.data(), frame.size());
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;     // nowhere left to report it
+            }
+            frame.remove_prefix(static_cast<size_t>(n));
+        }
+    };
+#else
+    (void)fd;
+    return toStream(std::cout);
+#endif
+}
+
+Renderer::Sink Renderer::toStream(std::ostream& out) {
+    return [&out](std::string_view frame) {
+        out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+        out.flush();
+    };
+}
+
+Renderer& Renderer::rule(size_t width, std::string_view glyph) {
+    frame_.reserve(frame_.size() + width * glyph.size() + 1);
+    for (size_t i = 0; i < width; ++i) {
+        frame_ += glyph;
+    }
+    frame_ += '\n';
+    return *this;
+}
+
+void Renderer::present() {
+    if (frame_.empty()) {
+        return;
+    }
+    if (pacing_ && Clock::now() < holdUntil_) {
+        queued_ += frame_;
+        frame_.clear();
+        return;
+    }
+    if (!queued_.empty()) {
+        queued_ += frame_;
+        frame_.clear();
+        write(queued_);
+        return;
+    }
+    write(frame_);
+}
+
+void Renderer::pause(Clock::duration duration) {
+    present();
+    if (pacing_) {
+        holdUntil_ = std::max(holdUntil_, Clock::now()) + duration;
+    }
+}
+
+void Renderer::pump(Clock::time_point now) {
+    if (!queued_.empty() && (!pacing_ || now >= holdUntil_)) {
+        write(queued_);
+    }
+}
+
+Renderer::Clock::time_point Renderer::nextDeadline() const {
+    return queued_.empty() ? Clock::time_point::max() : holdUntil_;
+}
+
+void Renderer::drain() {
+    frame_.insert(0, queued_);
+    queued_.clear();
+    if (pacing_ && waiter_ && Clock::now() < holdUntil_) {
+        waiter_(holdUntil_);
+    }
+    // Whatever comes next follows the player, not the old deadline
+    holdUntil_ = {};
+    if (!frame_.empty()) {
+        write(frame_);
+    }
+}
+
+void Renderer::write(std::string& frame) {
+    ++writeCalls_;
+    sink_(frame);
+    frame.clear();
+}
+
+void Renderer::appendNumber(double value) {
+    // As std::ostream prints it by default
+    char digits[32];
+    const int n = std::snprintf(digits, sizeof(digits), "%g", value);
+    frame_.append(digits, static_cast<size_t>(std::max(n, 0)));
+}
+
+void Renderer::appendNumber(long long value) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    frame_.append(digits, static_cast<size_t>(end - digits));
+}
+
+void Renderer::appendNumber(unsigned long long value) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    frame_.append(digits, static_cast<size_t>(end - digits));
+}
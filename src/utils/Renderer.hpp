@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * Frame-based terminal output.
+ *
+ * Text is composed into one buffer and a finished frame leaves in a single
+ * sink call (one write(2) on a terminal) instead of a write per line.
+ * Frames end when present() or pause() is called, or when drain() runs
+ * before the game waits for input.
+ *
+ * Pacing never sleeps in the renderer. pause() sets a deadline, and frames
+ * presented before it are queued. An event loop calls pump() when
+ * nextDeadline() passes. A synchronous caller calls drain(), which hands the
+ * deadline to the waiter; the terminal waiter returns early once the player
+ * has typed ahead. With pacing off, pauses are skipped (fast-forward).
+ * Not thread-safe.
+ */
+class Renderer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Writes the whole frame
+    using Sink = std::function<void(std::string_view frame)>;
+
+    // Returns at `deadline` or earlier; no waiter means no waiting
+    using Waiter = std::function<void(Clock::time_point deadline)>;
+
+    explicit Renderer(Sink sink, Waiter waiter = {});
+
+    // stdout through write(2) where available, after flushing std::cout so
+    // other writers stay in order; waits return early on pending stdin
+    static Renderer& standardOutput();
+
+    static Sink toDescriptor(int fd);
+    static Sink toStream(std::ostream& out);
+
+    Renderer& operator<<(std::string_view text) {
+        frame_ += text;
+        return *this;
+    }
+    Renderer& operator<<(const char* text) { return *this << std::string_view(text); }
+    Renderer& operator<<(const std::string& text) { return *this << std::string_view(text); }
+    Renderer& operator<<(char c) {
+        frame_ += c;
+        return *this;
+    }
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    Renderer& operator<<(T value) {
+        appendNumber(value);
+        return *this;
+    }
+
+    // `width` copies of `glyph`, then a newline; a glyph may be any UTF-8
+    // sequence
+    Renderer& rule(size_t width, std::string_view glyph);
+
+    // Ends the frame: written now, or queued while a pause runs
+    void present();
+
+    // Ends the frame and holds later ones for `duration`
+    void pause(Clock::duration duration);
+
+    // Writes queued frames once the pause is over
+    void pump(Clock::time_point now = Clock::now());
+
+    // When pump() has work to do; Clock::time_point::max() if none
+    Clock::time_point nextDeadline() const;
+
+    // Presents, waits out any pause and writes everything
+    void drain();
+
+    void setPacing(bool enabled) { pacing_ = enabled; }
+    bool pacing() const { return pacing_; }
+
+    // Sink calls so far, for benchmarks
+    size_t writeCalls() const { return writeCalls_; }
+
+private:
+    Sink sink_;
+    Waiter waiter_;
+    std::string frame_;             // being composed
+    std::string queued_;            // presented during a pause
+    Clock::time_point holdUntil_{};
+    size_t writeCalls_ = 0;
+    bool pacing_ = true;
+
+    void write(std::string& frame);
+    void appendNumber(double value);
+    void appendNumber(long long value);
+    void appendNumber(unsigned long long value);
+
+    template<typename T>
+    void appendNumber(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            appendNumber(static_cast<double>(value));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            frame_ += value ? '1' : '0';
+        } else if constexpr (std::is_signed_v<T>) {
+            appendNumber(static_cast<long long>(value));
+        } else {
+            appendNumber(static_cast<unsigned long long>(value));
+        }
+    }
+};
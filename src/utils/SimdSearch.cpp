@@ -0,0 +1,397 @@
+#include "SimdSearch.hpp"
+#include "BitUtils.hpp"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CQ_SIMD_SSE2 1
+#endif
+
+// AVX2 kernels are compiled per-function with a target attribute, so the rest
+// of the binary keeps running on CPUs without AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CQ_SIMD_AVX2 1
+#define CQ_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+using FindFn = size_t (*)(const char* haystack, size_t size, const char* needle, size_t length, size_t pos);
+using FindByteFn = size_t (*)(const char* haystack, size_t size, char byte, size_t pos);
+using ConvertFn = void (*)(char* data, size_t size);
+
+struct Kernels {
+    FindFn find;
+    FindByteFn findByte;
+    FindFn findIgnoreCase;
+    ConvertFn toLower;
+    ConvertFn toUpper;
+    SimdSearch::Level level;
+};
+
+inline char foldLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+inline char foldUpper(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+}
+
+// Equality of two byte ranges, ignoring ASCII case
+inline bool equalIgnoreCase(const char* a, const char* b, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (foldLower(a[i]) != foldLower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// === Scalar kernels ===
+
+size_t findScalar(const char* haystack, size_t size, const char* needle, size_t length, size_t pos) {
+    return std::string_view(haystack, size).find(std::string_view(needle, length), pos);
+}
+
+size_t findByteScalar(const char* haystack, size_t size, char byte, size_t pos) {
+    const void* hit = std::memchr(haystack + pos, static_cast<unsigned char>(byte), size - pos);
+    return hit ? static_cast<size_t>(static_cast<const char*>(hit) - haystack) : SimdSearch::npos;
+}
+
+size_t findIgnoreCaseScalar(const char* haystack, size_t size, const char* needle, size_t length, size_t pos) {
+    const char first = foldLower(needle[0]);
+    for (; pos + length <= size; ++pos) {
+        if (foldLower(haystack[pos]) == first && equalIgnoreCase(haystack + pos + 1, needle + 1, length - 1)) {
+            return pos;
+        }
+    }
+    return SimdSearch::npos;
+}
+
+void toLowerScalar(char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = foldLower(data[i]);
+    }
+}
+
+void toUpperScalar(char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = foldUpper(data[i]);
+    }
+}
+
+// === SSE2 kernels ===
+
+#ifdef CQ_SIMD_SSE2
+size_t findSse2(const char* haystack, size_t size, const char* needle, size_t length, size_t pos) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[length - 1]);
+
+    for (; pos + length - 1 + 16 <= size; pos += 16) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+        const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos + length - 1));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            const size_t offset = BitUtils::countTrailingZeros(mask);
+            if (std::memcmp(haystack + pos + offset + 1, needle + 1, length - 2) == 0) {
+                return pos + offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return findScalar(haystack, size, needle, length, pos);
+}
+
+size_t findByteSse2(const char* haystack, size_t size, char byte, size_t pos) {
+    const __m128i target = _mm_set1_epi8(byte);
+
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+        if (mask != 0) {
+            return pos + BitUtils::countTrailingZeros(mask);
+        }
+    }
+
+    return pos < size ? findByteScalar(haystack, size, byte, pos) : SimdSearch::npos;
+}
+
+// Adds `delta` to every byte in [lo, hi]. The signed compares leave bytes
+// >= 0x80 (negative as epi8) outside any ASCII range.
+inline __m128i shiftRangeSse2(__m128i block, char lo, char hi, char delta) {
+    const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                                          _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(hi + 1))));
+    return _mm_add_epi8(block, _mm_and_si128(inRange, _mm_set1_epi8(delta)));
+}
+
+inline __m128i foldLowerSse2(__m128i block) {
+    return shiftRangeSse2(block, 'A', 'Z', 'a' - 'A');
+}
+
+size_t findIgnoreCaseSse2(const char* haystack, size_t size, const char* needle, size_t length, size_t pos) {
+    const __m128i first = _mm_set1_epi8(foldLower(needle[0]));
+    const __m128i last = _mm_set1_epi8(foldLower(needle[length - 1]));
+    const size_t middle = length > 2 ? length - 2 : 0;
+
+    for (; pos + length - 1 + 16 <= size; pos += 16) {
+        const __m128i blockFirst = foldLowerSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos)));
+        const __m128i blockLast = foldLowerSse2(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos + length - 1)));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            const size_t offset = BitUtils::countTrailingZeros(mask);
+            if (equalIgnoreCase(haystack + pos + offset + 1, needle + 1, middle)) {
+                return pos + offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return findIgnoreCaseScalar(haystack, size, needle, length, pos);
+}
+
+void toLowerSse2(char* data, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto* block = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(block, foldLowerSse2(_mm_loadu_si128(block)));
+    }
+    toLowerScalar(data + i, size - i);
+}
+
+void toUpperSse2(char* data, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto* block = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(block, shiftRangeSse2(_mm_loadu_si128(block), 'a', 'z', 'A' - 'a'));
+    }
+    toUpperScalar(data + i, size - i);
+}
+#endif
+
+// === AVX2 kernels ===
+
+#ifdef CQ_SIMD_AVX2
+CQ_TARGET_AVX2
+size_t findAvx2(const char* haystack, size_t size, const char* needle, size_t length, size_t pos) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[length - 1]);
+
+    for (; pos + length - 1 + 32 <= size; pos += 32) {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos));
+        const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos + length - 1));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            const size_t offset = BitUtils::countTrailingZeros(mask);
+            if (std::memcmp(haystack + pos + offset + 1, needle + 1, length - 2) == 0) {
+                return pos + offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return findScalar(haystack, size, needle, length, pos);
+}
+
+CQ_TARGET_AVX2
+size_t findByteAvx2(const char* haystack, size_t size, char byte, size_t pos) {
+    const __m256i target = _mm256_set1_epi8(byte);
+
+    for (; pos + 32 <= size; pos += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target)));
+        if (mask != 0) {
+            return pos + BitUtils::countTrailingZeros(mask);
+        }
+    }
+
+    return pos < size ? findByteScalar(haystack, size, byte, pos) : SimdSearch::npos;
+}
+
+CQ_TARGET_AVX2
+inline __m256i shiftRangeAvx2(__m256i block, char lo, char hi, char delta) {
+    const __m256i inRange = _mm256_and_si256(
+        _mm256_cmpgt_epi8(block, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), block));
+    return _mm256_add_epi8(block, _mm256_and_si256(inRange, _mm256_set1_epi8(delta)));
+}
+
+CQ_TARGET_AVX2
+inline __m256i foldLowerAvx2(__m256i block) {
+    return shiftRangeAvx2(block, 'A', 'Z', 'a' - 'A');
+}
+
+CQ_TARGET_AVX2
+size_t findIgnoreCaseAvx2(const char* haystack, size_t size, const char* needle, size_t length, size_t pos) {
+    const __m256i first = _mm256_set1_epi8(foldLower(needle[0]));
+    const __m256i last = _mm256_set1_epi8(foldLower(needle[length - 1]));
+    const size_t middle = length > 2 ? length - 2 : 0;
+
+    for (; pos + length - 1 + 32 <= size; pos += 32) {
+        const __m256i blockFirst = foldLowerAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos)));
+        const __m256i blockLast = foldLowerAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos + length - 1)));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            const size_t offset = BitUtils::countTrailingZeros(mask);
+            if (equalIgnoreCase(haystack + pos + offset + 1, needle + 1, middle)) {
+                return pos + offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return findIgnoreCaseScalar(haystack, size, needle, length, pos);
+}
+
+CQ_TARGET_AVX2
+void toLowerAvx2(char* data, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto* block = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(block, foldLowerAvx2(_mm256_loadu_si256(block)));
+    }
+    toLowerScalar(data + i, size - i);
+}
+
+CQ_TARGET_AVX2
+void toUpperAvx2(char* data, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto* block = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(block, shiftRangeAvx2(_mm256_loadu_si256(block), 'a', 'z', 'A' - 'a'));
+    }
+    toUpperScalar(data + i, size - i);
+}
+
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+Kernels kernelsFor(SimdSearch::Level level) {
+    switch (level) {
+#ifdef CQ_SIMD_AVX2
+        case SimdSearch::Level::AVX2:
+            return {findAvx2, findByteAvx2, findIgnoreCaseAvx2, toLowerAvx2, toUpperAvx2, level};
+#endif
+#ifdef CQ_SIMD_SSE2
+        case SimdSearch::Level::SSE2:
+            return {findSse2, findByteSse2, findIgnoreCaseSse2, toLowerSse2, toUpperSse2, level};
+#endif
+        default:
+            return {findScalar, findByteScalar, findIgnoreCaseScalar, toLowerScalar, toUpperScalar,
+                    SimdSearch::Level::Scalar};
+    }
+}
+
+Kernels& activeKernels() {
+    static Kernels kernels = kernelsFor(SimdSearch::bestSupportedLevel());
+    return kernels;
+}
+
+} // namespace
+
+size_t SimdSearch::find(std::string_view haystack, std::string_view needle, size_t pos) {
+    if (needle.empty()) {
+        return pos <= haystack.size() ? pos : npos;
+    }
+    if (pos >= haystack.size() || needle.size() > haystack.size() - pos) {
+        return npos;
+    }
+    if (needle.size() == 1) {
+        return activeKernels().findByte(haystack.data(), haystack.size(), needle[0], pos);
+    }
+    return activeKernels().find(haystack.data(), haystack.size(), needle.data(), needle.size(), pos);
+}
+
+size_t SimdSearch::findByte(std::string_view haystack, char byte, size_t pos) {
+    if (pos >= haystack.size()) {
+        return npos;
+    }
+    return activeKernels().findByte(haystack.data(), haystack.size(), byte, pos);
+}
+
+size_t SimdSearch::findIgnoreCase(std::string_view haystack, std::string_view needle, size_t pos) {
+    if (needle.empty()) {
+        return pos <= haystack.size() ? pos : npos;
+    }
+    if (pos >= haystack.size() || needle.size() > haystack.size() - pos) {
+        return npos;
+    }
+    return activeKernels().findIgnoreCase(haystack.data(), haystack.size(), needle.data(), needle.size(), pos);
+}
+
+void SimdSearch::toLower(char* data, size_t size) {
+    activeKernels().toLower(data, size);
+}
+
+void SimdSearch::toUpper(char* data, size_t size) {
+    activeKernels().toUpper(data, size);
+}
+
+SimdSearch::Level SimdSearch::activeLevel() {
+    return activeKernels().level;
+}
+
+SimdSearch::Level SimdSearch::bestSupportedLevel() {
+    if (isSupported(Level::AVX2)) {
+        return Level::AVX2;
+    }
+    if (isSupported(Level::SSE2)) {
+        return Level::SSE2;
+    }
+    return Level::Scalar;
+}
+
+bool SimdSearch::isSupported(Level level) {
+    switch (level) {
+        case Level::Scalar:
+            return true;
+        case Level::SSE2:
+#ifdef CQ_SIMD_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case Level::AVX2:
+#ifdef CQ_SIMD_AVX2
+        {
+            static const bool supported = cpuHasAvx2();
+            return supported;
+        }
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* SimdSearch::levelName(Level level) {
+    switch (level) {
+        case Level::Scalar: return "scalar";
+        case Level::SSE2: return "sse2";
+        case Level::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+bool SimdSearch::setLevel(Level level) {
+    if (!isSupported(level)) {
+        return false;
+    }
+    activeKernels() = kernelsFor(level);
+    return true;
+}
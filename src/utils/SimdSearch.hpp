@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * Vectorized substring search with runtime CPU dispatch.
+ *
+ * Candidate positions are found by comparing the needle's first and last
+ * bytes against 16 (SSE2) or 32 (AVX2) haystack positions at once; only
+ * positions where both agree are verified with memcmp. The widest kernel the
+ * CPU supports is chosen on first use, with the scalar std::string_view
+ * search as the portable fallback.
+ *
+ * The same dispatch covers ASCII case folding: case-insensitive search folds
+ * haystack blocks on the fly instead of lowercasing copies, and the
+ * toLower/toUpper kernels convert 16 or 32 bytes per step. Only 'A'-'Z' and
+ * 'a'-'z' are mapped, exactly as tolower/toupper do in the "C" locale; every
+ * other byte, including non-ASCII ones, passes through unchanged.
+ */
+class SimdSearch {
+public:
+    enum class Level {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    static constexpr size_t npos = std::string_view::npos;
+
+    // Same contract as std::string_view::find
+    static size_t find(std::string_view haystack, std::string_view needle, size_t pos = 0);
+    static size_t findByte(std::string_view haystack, char byte, size_t pos = 0);
+
+    // As find, but ASCII letters compare equal regardless of case
+    static size_t findIgnoreCase(std::string_view haystack, std::string_view needle, size_t pos = 0);
+
+    // In-place ASCII case conversion
+    static void toLower(char* data, size_t size);
+    static void toUpper(char* data, size_t size);
+
+    // Dispatch control
+    static Level activeLevel();
+    static Level bestSupportedLevel();
+    static bool isSupported(Level level);
+    static const char* levelName(Level level);
+
+    // Pins the kernel used by find/findByte (benchmarks and tests). Returns
+    // false if the CPU lacks the instruction set. Not thread-safe.
+    static bool setLevel(Level level);
+
+private:
+    SimdSearch() = delete;
+};
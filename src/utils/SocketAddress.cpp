@@ -0,0 +1,172 @@
+#include "SocketAddress.hpp"
+#include <cstring>
+
+#ifdef CQ_SOCKETS_POSIX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef CQ_SOCKETS_POSIX
+namespace {
+
+// A stream socket with close-on-exec set. SOCK_CLOEXEC, SOCK_NONBLOCK and
+// MSG_NOSIGNAL are Linux-only, so the flags go through fcntl(), and on
+// macOS the socket is told not to raise SIGPIPE itself.
+int openSocket(int family, bool nonBlocking) {
+    const int fd = ::socket(family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    bool ok = ::fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+    if (ok && nonBlocking) {
+        const int flags = ::fcntl(fd, F_GETFL);
+        ok = flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    ok = ok && ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on)) == 0;
+#endif
+    if (!ok) {
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+#endif
+
+std::optional<SocketAddress> SocketAddress::parse(const std::string& text, std::string& error) {
+#ifdef CQ_SOCKETS_POSIX
+    SocketAddress address;
+    address.text_ = text;
+
+    if (text.rfind("unix:", 0) == 0) {
+        const std::string path = text.substr(5);
+        sockaddr_un un{};
+        if (path.empty() || path.size() >= sizeof(un.sun_path)) {
+            error = "unix socket path must be 1 to " + std::to_string(sizeof(un.sun_path) - 1) + " bytes";
+            return std::nullopt;
+        }
+        un.sun_family = AF_UNIX;
+        std::memcpy(un.sun_path, path.c_str(), path.size() + 1);
+        std::memcpy(&address.storage_, &un, sizeof(un));
+        address.length_ = static_cast<socklen_t>(sizeof(un));
+        address.unixPath_ = path;
+        return address;
+    }
+
+    if (text.rfind("tcp:", 0) == 0) {
+        std::string host = "127.0.0.1";
+        std::string port = text.substr(4);
+        const size_t colon = port.rfind(':');
+        if (colon != std::string::npos) {
+            host = port.substr(0, colon);
+            port = port.substr(colon + 1);
+        }
+        if (port.empty() || port.size() > 5 || port.find_first_not_of("0123456789") != std::string::npos ||
+            std::stoul(port) > 65535) {
+            error = "expected a port from 0 to 65535 in '" + text + "'";
+            return std::nullopt;
+        }
+        sockaddr_in in{};
+        in.sin_family = AF_INET;
+        in.sin_port = htons(static_cast<std::uint16_t>(std::stoul(port)));
+        if (::inet_pton(AF_INET, host.c_str(), &in.sin_addr) != 1) {
+            error = "expected a numeric IPv4 host in '" + text + "'";
+            return std::nullopt;
+        }
+        std::memcpy(&address.storage_, &in, sizeof(in));
+        address.length_ = static_cast<socklen_t>(sizeof(in));
+        return address;
+    }
+
+    error = "expected tcp:PORT, tcp:HOST:PORT or unix:PATH, not '" + text + "'";
+    return std::nullopt;
+#else
+    (void)text;
+    error = "sockets need a POSIX system";
+    return std::nullopt;
+#endif
+}
+
+int SocketAddress::listen(int backlog) const {
+#ifdef CQ_SOCKETS_POSIX
+    const int fd = openSocket(storage_.ss_family, true);
+    if (fd < 0) {
+        return -1;
+    }
+    if (unixPath_) {
+        // Only a leftover socket is replaced, never a regular file
+        struct stat info {};
+        if (::lstat(unixPath_->c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+            ::unlink(unixPath_->c_str());
+        }
+    } else {
+        const int on = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&storage_), length_) != 0 || ::listen(fd, backlog) != 0) {
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+#else
+    (void)backlog;
+    return -1;
+#endif
+}
+
+int SocketAddress::connect() const {
+#ifdef CQ_SOCKETS_POSIX
+    const int fd = openSocket(storage_.ss_family, false);
+    if (fd < 0) {
+        return -1;
+    }
+    int result;
+    do {
+        result = ::connect(fd, reinterpret_cast<const sockaddr*>(&storage_), length_);
+    } while (result != 0 && errno == EINTR);
+    if (result != 0) {
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+std::string SocketAddress::boundTo(int fd) {
+#ifdef CQ_SOCKETS_POSIX
+    sockaddr_storage storage{};
+    socklen_t length = sizeof(storage);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&storage), &length) != 0) {
+        return {};
+    }
+    if (storage.ss_family == AF_UNIX) {
+        const auto* un = reinterpret_cast<const sockaddr_un*>(&storage);
+        return std::string("unix:") + un->sun_path;
+    }
+    if (storage.ss_family == AF_INET) {
+        const auto* in = reinterpret_cast<const sockaddr_in*>(&storage);
+        char host[INET_ADDRSTRLEN] = {};
+        ::inet_ntop(AF_INET, &in->sin_addr, host, sizeof(host));
+        return std::string("tcp:") + host + ":" + std::to_string(ntohs(in->sin_port));
+    }
+#else
+    (void)fd;
+#endif
+    return {};
+}
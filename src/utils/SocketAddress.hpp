@@ -0,0 +1,45 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#define CQ_SOCKETS_POSIX 1
+#endif
+
+/**
+ * A listening or connecting address written as text:
+ *
+ *   tcp:PORT          127.0.0.1:PORT
+ *   tcp:HOST:PORT     HOST is a numeric IPv4 address; PORT 0 picks a free one
+ *   unix:PATH         a Unix domain socket
+ *
+ * POSIX only; parse() reports an error elsewhere.
+ */
+class SocketAddress {
+public:
+    // nullopt with a message in `error` if the text is malformed
+    static std::optional<SocketAddress> parse(const std::string& text, std::string& error);
+
+    // A non-blocking, close-on-exec listening socket, or -1 with errno set.
+    // A stale Unix socket file at the path is replaced.
+    int listen(int backlog) const;
+
+    // A blocking connected socket, or -1 with errno set
+    int connect() const;
+
+    // The address `fd` is bound to, in the same notation
+    static std::string boundTo(int fd);
+
+    const std::string& text() const { return text_; }
+    bool isUnix() const { return unixPath_.has_value(); }
+
+private:
+    std::string text_;
+    std::optional<std::string> unixPath_;
+#ifdef CQ_SOCKETS_POSIX
+    sockaddr_storage storage_{};
+    socklen_t length_ = 0;
+#endif
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include "SimdSearch.hpp"
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+/**
+ * Lazy, forward-iterable split of a string_view.
+ *
+ * Tokens are produced one at a time as string_views into the source, so
+ * walking a multi-megabyte buffer costs no allocation and a caller that
+ * stops early never scans the rest. The range only borrows the source; keep
+ * the underlying buffer alive while iterating.
+ *
+ * Token semantics follow the eager StringUtils::split overloads:
+ *  - char delimiter: like std::getline, no trailing empty token and no tokens
+ *    at all for an empty source
+ *  - string delimiter: always yields the final field, even if empty; an empty
+ *    delimiter yields the whole source as one token
+ */
+template<typename Delimiter>
+class BasicSplitRange {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+        using pointer = void;
+
+        iterator() = default;
+
+        std::string_view operator*() const {
+            return source_.substr(tokenStart_, tokenEnd_ - tokenStart_);
+        }
+
+        iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator previous = *this;
+            advance();
+            return previous;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) {
+            return lhs.atEnd_ == rhs.atEnd_ && (lhs.atEnd_ || lhs.tokenStart_ == rhs.tokenStart_);
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class BasicSplitRange;
+
+        iterator(std::string_view source, Delimiter delimiter)
+            : source_(source), delimiter_(delimiter), atEnd_(source.empty() && !kKeepsTrailingField) {
+            if (!atEnd_) {
+                locate(0);
+            }
+        }
+
+        void locate(size_t start) {
+            tokenStart_ = start;
+            tokenEnd_ = findDelimiter(start);
+            if (tokenEnd_ == SimdSearch::npos) {
+                tokenEnd_ = source_.size();
+            }
+        }
+
+        void advance() {
+            if (tokenEnd_ == source_.size()) {
+                atEnd_ = true;
+                return;
+            }
+
+            const size_t next = tokenEnd_ + delimiterLength();
+            if (next == source_.size() && !kKeepsTrailingField) {
+                atEnd_ = true;
+                return;
+            }
+            locate(next);
+        }
+
+        size_t findDelimiter(size_t start) const {
+            if constexpr (kKeepsTrailingField) {
+                if (delimiter_.empty()) {
+                    return SimdSearch::npos;
+                }
+                return SimdSearch::find(source_, delimiter_, start);
+            } else {
+                return SimdSearch::findByte(source_, delimiter_, start);
+            }
+        }
+
+        size_t delimiterLength() const {
+            if constexpr (kKeepsTrailingField) {
+                return delimiter_.size();
+            } else {
+                return 1;
+            }
+        }
+
+        static constexpr bool kKeepsTrailingField = !std::is_same_v<Delimiter, char>;
+
+        std::string_view source_;
+        Delimiter delimiter_{};
+        size_t tokenStart_ = 0;
+        size_t tokenEnd_ = 0;
+        bool atEnd_ = true;
+    };
+
+    BasicSplitRange() = default;
+    BasicSplitRange(std::string_view source, Delimiter delimiter)
+        : source_(source), delimiter_(delimiter) {}
+
+    iterator begin() const { return iterator(source_, delimiter_); }
+    iterator end() const { return iterator(); }
+
+    std::string_view source() const { return source_; }
+
+private:
+    std::string_view source_;
+    Delimiter delimiter_{};
+};
+
+using CharSplitRange = BasicSplitRange<char>;
+using StringSplitRange = BasicSplitRange<std::string_view>;
+
+#if defined(__cpp_lib_ranges)
+namespace std::ranges {
+    template<typename Delimiter>
+    inline constexpr bool enable_borrowed_range<BasicSplitRange<Delimiter>> = true;
+
+    template<typename Delimiter>
+    inline constexpr bool enable_view<BasicSplitRange<Delimiter>> = true;
+}
+
+static_assert(std::ranges::forward_range<CharSplitRange>);
+static_assert(std::ranges::forward_range<StringSplitRange>);
+static_assert(std::ranges::view<CharSplitRange>);
+#endif
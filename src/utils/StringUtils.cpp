@@ -1,28 +1,46 @@
 #include "StringUtils.hpp"
+#include "SimdSearch.hpp"
+#include "CppKeywords.hpp"
+#include "BraceBalance.hpp"
 #include <algorithm>
 #include <regex>
 #include <set>
+#include <string_view>
+
+namespace {
+
+// Matches the regex \w class in the "C" locale, which defines the word
+// boundaries containsCppKeyword has always used
+inline bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+} // namespace
 
 // String manipulation implementations
+// Case conversion maps ASCII letters only, like ::tolower in the "C" locale
 std::string StringUtils::toLowerCase(const std::string& str) {
     std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    toLowerCaseInPlace(result);
     return result;
 }
 
 std::string StringUtils::toUpperCase(const std::string& str) {
     std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+    toUpperCaseInPlace(result);
     return result;
 }
 
+void StringUtils::toLowerCaseInPlace(std::string& str) {
+    SimdSearch::toLower(str.data(), str.size());
+}
+
+void StringUtils::toUpperCaseInPlace(std::string& str) {
+    SimdSearch::toUpper(str.data(), str.size());
+}
+
 std::string StringUtils::trim(const std::string& str) {
-    auto start = str.find_first_not_of(" \t\n\r\f\v");
-    if (start == std::string::npos) {
-        return "";
-    }
-    auto end = str.find_last_not_of(" \t\n\r\f\v");
-    return str.substr(start, end - start + 1);
+    return std::string(trimView(str));
 }
 
 std::string StringUtils::removeSpaces(const std::string& str) {
@@ -32,58 +50,90 @@ std::string StringUtils::removeSpaces(const std::string& str) {
 }
 
 // String searching implementations
-bool StringUtils::contains(const std::string& str, const std::string& substr) {
-    return str.find(substr) != std::string::npos;
+bool StringUtils::contains(std::string_view str, std::string_view substr) {
+    return SimdSearch::find(str, substr) != SimdSearch::npos;
 }
 
-bool StringUtils::containsIgnoreCase(const std::string& str, const std::string& substr) {
-    return toLowerCase(str).find(toLowerCase(substr)) != std::string::npos;
+bool StringUtils::containsIgnoreCase(std::string_view str, std::string_view substr) {
+    return SimdSearch::findIgnoreCase(str, substr) != SimdSearch::npos;
 }
 
-bool StringUtils::containsAll(const std::string& str, const std::vector<std::string>& substrings) {
-    for (const auto& substr : substrings) {
-        if (!contains(str, substr)) {
-            return false;
-        }
-    }
-    return true;
+bool StringUtils::containsAll(std::string_view str, const std::vector<std::string>& substrings) {
+    return containsAll(str, MultiPatternMatcher(substrings));
 }
 
-bool StringUtils::containsAny(const std::string& str, const std::vector<std::string>& substrings) {
-    for (const auto& substr : substrings) {
-        if (contains(str, substr)) {
-            return true;
-        }
+bool StringUtils::containsAny(std::string_view str, const std::vector<std::string>& substrings) {
+    return containsAny(str, MultiPatternMatcher(substrings));
+}
+
+// Ad-hoc literal lists are usually two or three needles; a vectorized search
+// per needle beats building an automaton and never touches the heap
+bool StringUtils::containsAll(std::string_view str, std::initializer_list<std::string_view> substrings) {
+    return std::all_of(substrings.begin(), substrings.end(), [str](std::string_view substr) {
+        return contains(str, substr);
+    });
+}
+
+bool StringUtils::containsAny(std::string_view str, std::initializer_list<std::string_view> substrings) {
+    return std::any_of(substrings.begin(), substrings.end(), [str](std::string_view substr) {
+        return contains(str, substr);
+    });
+}
+
+bool StringUtils::containsAll(std::string_view str, const MultiPatternMatcher& matcher) {
+    return matcher.containsAll(str);
+}
+
+bool StringUtils::containsAny(std::string_view str, const MultiPatternMatcher& matcher) {
+    return matcher.containsAny(str);
+}
+
+size_t StringUtils::find(std::string_view str, std::string_view substr, size_t pos) {
+    return SimdSearch::find(str, substr, pos);
+}
+
+size_t StringUtils::findIgnoreCase(std::string_view str, std::string_view substr, size_t pos) {
+    return SimdSearch::findIgnoreCase(str, substr, pos);
+}
+
+bool StringUtils::startsWith(std::string_view str, std::string_view prefix) {
+    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool StringUtils::endsWith(std::string_view str, std::string_view suffix) {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Non-allocating view implementations
+std::string_view StringUtils::trimView(std::string_view str) {
+    auto start = str.find_first_not_of(" \t\n\r\f\v");
+    if (start == std::string_view::npos) {
+        return {};
     }
-    return false;
+    auto end = str.find_last_not_of(" \t\n\r\f\v");
+    return str.substr(start, end - start + 1);
+}
+
+std::vector<std::string_view> StringUtils::splitView(std::string_view str, char delimiter) {
+    const auto tokens = splitLazy(str, delimiter);
+    return std::vector<std::string_view>(tokens.begin(), tokens.end());
+}
+
+std::vector<std::string_view> StringUtils::splitView(std::string_view str, std::string_view delimiter) {
+    const auto tokens = splitLazy(str, delimiter);
+    return std::vector<std::string_view>(tokens.begin(), tokens.end());
 }
 
 // String splitting and joining implementations
 std::vector<std::string> StringUtils::split(const std::string& str, char delimiter) {
-    std::vector<std::string> result;
-    std::istringstream iss(str);
-    std::string token;
-    
-    while (std::getline(iss, token, delimiter)) {
-        result.push_back(token);
-    }
-    
-    return result;
+    const auto views = splitView(str, delimiter);
+    return std::vector<std::string>(views.begin(), views.end());
 }
 
 std::vector<std::string> StringUtils::split(const std::string& str, const std::string& delimiter) {
-    std::vector<std::string> result;
-    size_t start = 0;
-    size_t end = str.find(delimiter);
-    
-    while (end != std::string::npos) {
-        result.push_back(str.substr(start, end - start));
-        start = end + delimiter.length();
-        end = str.find(delimiter, start);
-    }
-    
-    result.push_back(str.substr(start));
-    return result;
+    const auto views = splitView(str, std::string_view(delimiter));
+    return std::vector<std::string>(views.begin(), views.end());
 }
 
 std::string StringUtils::join(const std::vector<std::string>& strings, const std::string& delimiter) {
@@ -106,8 +156,8 @@ std::string StringUtils::replace(const std::string& str, const std::string& from
     }
     
     std::string result = str;
-    size_t pos = result.find(from);
-    if (pos != std::string::npos) {
+    size_t pos = SimdSearch::find(result, from);
+    if (pos != SimdSearch::npos) {
         result.replace(pos, from.length(), to);
     }
     
@@ -115,19 +165,15 @@ std::string StringUtils::replace(const std::string& str, const std::string& from
 }
 
 std::string StringUtils::replaceAll(const std::string& str, const std::string& from, const std::string& to) {
-    if (from.empty()) {
-        return str;
-    }
-    
-    std::string result = str;
-    size_t pos = 0;
-    
-    while ((pos = result.find(from, pos)) != std::string::npos) {
-        result.replace(pos, from.length(), to);
-        pos += to.length();
-    }
-    
-    return result;
+    return MultiReplacer::apply(str, from, to);
+}
+
+std::string StringUtils::replaceAll(const std::string& str, const std::vector<std::pair<std::string, std::string>>& rules) {
+    return MultiReplacer(rules).apply(str);
+}
+
+std::string StringUtils::replaceAll(const std::string& str, const MultiReplacer& replacer) {
+    return replacer.apply(str);
 }
 
 // String validation implementations
@@ -182,20 +228,19 @@ bool StringUtils::isValidCppIdentifier(const std::string& str) {
     }
     
     // Must start with letter or underscore
-    if (!std::isalpha(str[0]) && str[0] != '_') {
+    if (!isWordChar(str[0]) || (str[0] >= '0' && str[0] <= '9')) {
         return false;
     }
     
     // Rest must be alphanumeric or underscore
     for (size_t i = 1; i < str.length(); ++i) {
-        if (!std::isalnum(str[i]) && str[i] != '_') {
+        if (!isWordChar(str[i])) {
             return false;
         }
     }
     
     // Check if it's a C++ keyword
-    const auto keywords = getCppKeywords();
-    return std::find(keywords.begin(), keywords.end(), str) == keywords.end();
+    return !CppKeywords::contains(str);
 }
 
 bool StringUtils::containsCppKeyword(const std::string& str, const std::string& keyword) {
@@ -205,40 +250,46 @@ bool StringUtils::containsCppKeyword(const std::string& str, const std::string&
 }
 
 std::vector<std::string> StringUtils::extractCppKeywords(const std::string& code) {
+    // One pass over the maximal word-character runs; a keyword is present
+    // exactly when some run equals it, which is what "\\bkeyword\\b" matched
+    std::vector<bool> found(CppKeywords::kCount, false);
+    size_t remaining = CppKeywords::kCount;
+
+    size_t pos = 0;
+    while (pos < code.size() && remaining > 0) {
+        if (!isWordChar(code[pos])) {
+            ++pos;
+            continue;
+        }
+
+        const size_t start = pos;
+        while (pos < code.size() && isWordChar(code[pos])) {
+            ++pos;
+        }
+
+        const int index = CppKeywords::indexOf(std::string_view(code).substr(start, pos - start));
+        if (index >= 0 && !found[static_cast<size_t>(index)]) {
+            found[static_cast<size_t>(index)] = true;
+            --remaining;
+        }
+    }
+
     std::vector<std::string> foundKeywords;
-    const auto keywords = getCppKeywords();
-    
-    for (const auto& keyword : keywords) {
-        if (containsCppKeyword(code, keyword)) {
-            foundKeywords.push_back(keyword);
+    for (size_t i = 0; i < CppKeywords::kCount; ++i) {
+        if (found[i]) {
+            foundKeywords.emplace_back(CppKeywords::kWords[i]);
         }
     }
-    
+
     return foundKeywords;
 }
 
 bool StringUtils::hasBalancedBraces(const std::string& code) {
-    int braceCount = 0;
-    int parenCount = 0;
-    int bracketCount = 0;
-    
-    for (char c : code) {
-        switch (c) {
-            case '{': braceCount++; break;
-            case '}': braceCount--; break;
-            case '(': parenCount++; break;
-            case ')': parenCount--; break;
-            case '[': bracketCount++; break;
-            case ']': bracketCount--; break;
-        }
-        
-        // Early exit if any count goes negative
-        if (braceCount < 0 || parenCount < 0 || bracketCount < 0) {
-            return false;
-        }
-    }
-    
-    return braceCount == 0 && parenCount == 0 && bracketCount == 0;
+    return BraceBalanceChecker::check(code).balanced;
+}
+
+size_t StringUtils::findBraceImbalance(std::string_view code) {
+    return BraceBalanceChecker::check(code).offset;
 }
 
 int StringUtils::countOccurrences(const std::string& str, const std::string& substr) {
@@ -249,7 +300,7 @@ int StringUtils::countOccurrences(const std::string& str, const std::string& sub
     int count = 0;
     size_t pos = 0;
     
-    while ((pos = str.find(substr, pos)) != std::string::npos) {
+    while ((pos = SimdSearch::find(str, substr, pos)) != SimdSearch::npos) {
         count++;
         pos += substr.length();
     }
@@ -290,35 +341,3 @@ std::string StringUtils::center(const std::string& str, size_t width, char fillC
 bool StringUtils::isSpace(char c) {
     return std::isspace(static_cast<unsigned char>(c));
 }
-
-std::vector<std::string> StringUtils::getCppKeywords() {
-    return {
-        // C++ keywords
-        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor",
-        "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t",
-        "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
-        "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype",
-        "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
-        "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
-        "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
-        "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected",
-        "public", "register", "reinterpret_cast", "requires", "return", "short",
-        "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
-        "switch", "template", "this", "thread_local", "throw", "true", "try",
-        "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual",
-        "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
-        
-        // Common C++ library identifiers
-        "std", "string", "vector", "map", "set", "list", "queue", "stack",
-        "unique_ptr", "shared_ptr", "weak_ptr", "make_unique", "make_shared",
-        "move", "forward", "pair", "tuple", "optional", "variant", "any",
-        "function", "lambda", "bind", "ref", "cref", "iterator", "const_iterator",
-        "begin", "end", "size", "empty", "push_back", "pop_back", "insert",
-        "erase", "find", "count", "sort", "reverse", "transform", "for_each",
-        "algorithm", "numeric", "functional", "memory", "utility", "type_traits",
-        "chrono", "thread", "mutex", "lock_guard", "unique_lock", "condition_variable",
-        "future", "promise", "async", "packaged_task", "exception", "runtime_error",
-        "logic_error", "invalid_argument", "out_of_range", "length_error",
-        "domain_error", "range_error", "overflow_error", "underflow_error"
-    };
-}
\ No newline at end of file
@@ -1,24 +1,48 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <initializer_list>
 #include <vector>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include "MultiPatternMatcher.hpp"
+#include "MultiReplacer.hpp"
+#include "SplitRange.hpp"
 
 class StringUtils {
 public:
     // String manipulation
     static std::string toLowerCase(const std::string& str);
     static std::string toUpperCase(const std::string& str);
+    static void toLowerCaseInPlace(std::string& str);
+    static void toUpperCaseInPlace(std::string& str);
     static std::string trim(const std::string& str);
     static std::string removeSpaces(const std::string& str);
     
-    // String searching
-    static bool contains(const std::string& str, const std::string& substr);
-    static bool containsIgnoreCase(const std::string& str, const std::string& substr);
-    static bool containsAll(const std::string& str, const std::vector<std::string>& substrings);
-    static bool containsAny(const std::string& str, const std::vector<std::string>& substrings);
+    // String searching (accept std::string, string literals and views alike)
+    static bool contains(std::string_view str, std::string_view substr);
+    static bool containsIgnoreCase(std::string_view str, std::string_view substr);
+    static bool containsAll(std::string_view str, const std::vector<std::string>& substrings);
+    static bool containsAny(std::string_view str, const std::vector<std::string>& substrings);
+    static bool containsAll(std::string_view str, std::initializer_list<std::string_view> substrings);
+    static bool containsAny(std::string_view str, std::initializer_list<std::string_view> substrings);
+    static bool containsAll(std::string_view str, const MultiPatternMatcher& matcher);
+    static bool containsAny(std::string_view str, const MultiPatternMatcher& matcher);
+    static size_t find(std::string_view str, std::string_view substr, size_t pos = 0);
+    static size_t findIgnoreCase(std::string_view str, std::string_view substr, size_t pos = 0);
+    static bool startsWith(std::string_view str, std::string_view prefix);
+    static bool endsWith(std::string_view str, std::string_view suffix);
+    
+    // Non-allocating views; results point into the argument's buffer
+    static std::string_view trimView(std::string_view str);
+    static std::vector<std::string_view> splitView(std::string_view str, char delimiter);
+    static std::vector<std::string_view> splitView(std::string_view str, std::string_view delimiter);
+    
+    // Lazy splitting: tokens are found on demand, nothing is allocated
+    static CharSplitRange splitLazy(std::string_view str, char delimiter) { return {str, delimiter}; }
+    static StringSplitRange splitLazy(std::string_view str, std::string_view delimiter) { return {str, delimiter}; }
     
     // String splitting and joining
     static std::vector<std::string> split(const std::string& str, char delimiter);
@@ -29,6 +53,10 @@ public:
     static std::string replace(const std::string& str, const std::string& from, const std::string& to);
     static std::string replaceAll(const std::string& str, const std::string& from, const std::string& to);
     
+    // Several rules in one pass; see MultiReplacer for the matching rules
+    static std::string replaceAll(const std::string& str, const std::vector<std::pair<std::string, std::string>>& rules);
+    static std::string replaceAll(const std::string& str, const MultiReplacer& replacer);
+    
     // String validation
     static bool isNumeric(const std::string& str);
     static bool isAlpha(const std::string& str);
@@ -41,6 +69,7 @@ public:
     static bool containsCppKeyword(const std::string& str, const std::string& keyword);
     static std::vector<std::string> extractCppKeywords(const std::string& code);
     static bool hasBalancedBraces(const std::string& code);
+    static size_t findBraceImbalance(std::string_view code);    // npos when balanced
     static int countOccurrences(const std::string& str, const std::string& substr);
     
     // Formatting utilities
@@ -67,5 +96,4 @@ public:
 private:
     // Helper functions
     static bool isSpace(char c);
-    static std::vector<std::string> getCppKeywords();
 };
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+/**
+ * A lazily started coroutine producing a T.
+ *
+ * Nothing runs until the task is co_awaited or start()ed. When it finishes,
+ * the coroutine awaiting it resumes by symmetric transfer, so a chain of
+ * tasks completing synchronously uses no extra stack. An exception escapes
+ * to the awaiter, or to result() for a started task. The task owns its
+ * frame, so a Task must outlive any suspension of its coroutine.
+ *
+ * GCC 12 miscompiles a co_await inside an if condition (the coroutine never
+ * starts), so await into a local and test that.
+ */
+template<typename T = void>
+class Task;
+
+namespace TaskDetail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> done) noexcept {
+            return done.promise().continuation;
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template<typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    void return_value(T result) { value.emplace(std::move(result)); }
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template<>
+struct Promise<void> : PromiseBase {
+    void return_void() noexcept {}
+    void take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace TaskDetail
+
+template<typename T>
+class Task {
+public:
+    struct promise_type : TaskDetail::Promise<T> {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    ~Task() { destroy(); }
+
+    // Runs the coroutine up to its first suspension, for a driver that is
+    // not itself a coroutine. Once only.
+    void start() { handle_.resume(); }
+
+    bool done() const { return !handle_ || handle_.done(); }
+
+    // The value or exception of a finished task
+    T result() { return handle_.promise().take(); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> task;
+
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                task.promise().continuation = awaiting;
+                return task;
+            }
+            T await_resume() { return task.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    void destroy() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+};
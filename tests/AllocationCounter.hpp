@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Global operator new replacement for the test binary, used to assert that
+ * hot paths do not allocate. Counting is process-wide, so measure a small
+ * scope and compare before/after.
+ */
+namespace TestSupport {
+
+    std::size_t allocationCount();
+
+    // Number of allocations performed while running fn
+    template<typename Fn>
+    std::size_t countAllocations(Fn&& fn) {
+        const std::size_t before = allocationCount();
+        fn();
+        return allocationCount() - before;
+    }
+
+} // namespace TestSupport
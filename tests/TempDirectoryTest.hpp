@@ -0,0 +1,58 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "FileUtils.hpp"
+#include "StringUtils.hpp"
+
+/**
+ * Fixture for tests that work on files: each test gets an empty directory
+ * named after it under the system temp directory, removed afterwards.
+ */
+namespace TestSupport {
+
+    class TempDirectoryTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+            dir_ = std::filesystem::temp_directory_path() / (std::string("cpp-code-quest-") + test->name());
+            std::filesystem::remove_all(dir_);
+            std::filesystem::create_directories(dir_);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(dir_);
+        }
+
+        std::string path(const std::string& name) const {
+            return (dir_ / name).string();
+        }
+
+        // Writes `name`, creating its directories, and returns its path
+        std::string write(const std::string& name, const std::string& content) {
+            const std::string file = path(name);
+            std::filesystem::create_directories((dir_ / name).parent_path());
+            EXPECT_TRUE(GameUtils::FileUtils::write_file(file, content)) << file;
+            return file;
+        }
+
+        std::filesystem::path dir_;
+    };
+
+    // Report lines sorted, since batch workers finish in any order
+    inline std::vector<std::string> sortedRows(const std::string& report, bool skipHeader) {
+        std::vector<std::string> rows;
+        for (auto line : StringUtils::splitLazy(report, '\n')) {
+            rows.emplace_back(line);
+        }
+        if (skipHeader && !rows.empty()) {
+            rows.erase(rows.begin());
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+} // namespace TestSupport
@@ -0,0 +1,133 @@
+/**
+ * C++ Code Quest - BatchGrader Tests
+ *
+ * Headless grading of a directory of submissions, and the BatchRunner
+ * driver it shares with --replay.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GameEngine.hpp"
+#include "BatchGrader.hpp"
+#include "BatchRunner.hpp"
+#include "TempDirectoryTest.hpp"
+
+namespace CppCodeQuestTests {
+
+using TestSupport::sortedRows;
+
+class BatchGraderTest : public TestSupport::TempDirectoryTest {
+protected:
+    void SetUp() override {
+        TempDirectoryTest::SetUp();
+        write("level1_ada.cpp", "auto f = [](auto x) { return x; };\n");
+        write("level3_bjarne.cpp", "auto p = std::make_unique<int>(42);\n");
+        write("class-b/level3_grace.cpp", "int* p = new int(42);\n");
+        write("notes.txt", "no level here\n");
+        write("level9_ken.cpp", "auto x = 1;\n");
+    }
+
+    const GameEngine engine_;
+};
+
+TEST_F(BatchGraderTest, GradesEveryFileAsCsv) {
+    BatchGrader::Options options;
+    options.directory = dir_.string();
+    options.threads = 3;
+
+    std::ostringstream report;
+    const auto summary = BatchGrader(engine_).run(options, report);
+
+    ASSERT_TRUE(summary.has_value());
+    EXPECT_EQ(report.str().rfind("file,level,status,bytes,micros,error\n", 0), 0u);
+
+    const auto rows = sortedRows(report.str(), true);
+    ASSERT_EQ(rows.size(), 5u);
+    EXPECT_EQ(rows[0].rfind("class-b/level3_grace.cpp,3,fail,22,", 0), 0u);
+    EXPECT_EQ(rows[1].rfind("level1_ada.cpp,1,pass,", 0), 0u);
+    EXPECT_EQ(rows[2].rfind("level3_bjarne.cpp,3,pass,", 0), 0u);
+    EXPECT_EQ(rows[3].rfind("level9_ken.cpp,9,error,0,", 0), 0u);
+    EXPECT_EQ(rows[4].rfind("notes.txt,,error,0,", 0), 0u);
+
+    EXPECT_EQ(summary->submissions, 5u);
+    EXPECT_EQ(summary->passed, 2u);
+    EXPECT_EQ(summary->failed, 1u);
+    EXPECT_EQ(summary->errors, 2u);
+    EXPECT_EQ(summary->threads, 3u);
+    EXPECT_LE(summary->p50Micros, summary->p99Micros);
+    EXPECT_LE(summary->p99Micros, summary->maxMicros);
+}
+
+TEST_F(BatchGraderTest, JsonLinesReport) {
+    const auto options = BatchGrader::parseOptions({dir_.string(), "--format", "jsonl", "--threads", "2"});
+    ASSERT_TRUE(options.has_value());
+    EXPECT_EQ(options->format, BatchGrader::Format::JsonLines);
+
+    std::ostringstream report;
+    ASSERT_TRUE(BatchGrader(engine_).run(*options, report).has_value());
+
+    const auto rows = sortedRows(report.str(), false);
+    ASSERT_EQ(rows.size(), 5u);
+    EXPECT_EQ(rows[1].rfind("{\"file\":\"level1_ada.cpp\",\"level\":1,\"status\":\"pass\",", 0), 0u);
+    EXPECT_NE(rows[4].find("\"level\":null,\"status\":\"error\""), std::string::npos);
+}
+
+TEST_F(BatchGraderTest, RejectsBadUsage) {
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(BatchGrader::parseOptions({}).has_value());
+    EXPECT_FALSE(BatchGrader::parseOptions({"dir", "--format", "xml"}).has_value());
+    EXPECT_FALSE(BatchGrader::parseOptions({"dir", "--threads", "0"}).has_value());
+
+    BatchGrader::Options missing;
+    missing.directory = (dir_ / "does-not-exist").string();
+    std::ostringstream report;
+    EXPECT_FALSE(BatchGrader(engine_).run(missing, report).has_value());
+    testing::internal::GetCapturedStderr();
+}
+
+// ============================================================================
+// BatchRunner
+// ============================================================================
+
+TEST(BatchRunnerTest, RunsEveryJobOnceAndMergesLatencies) {
+    constexpr size_t kJobs = 1000;
+    std::vector<int> seen(kJobs, 0);
+    std::vector<size_t> perWorker(3, 0);
+    std::ostringstream report;
+
+    const auto latencies = BatchRunner::run(
+        kJobs, perWorker.size(), report, [](size_t index) { return index * 2; },
+        [&](size_t worker, size_t index, size_t result, double, std::string& rows) {
+            ++seen[index];
+            ++perWorker[worker];
+            rows += std::to_string(result) + '\n';
+        });
+
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), static_cast<std::ptrdiff_t>(kJobs));
+    EXPECT_EQ(perWorker[0] + perWorker[1] + perWorker[2], kJobs);
+    ASSERT_EQ(latencies.size(), kJobs);
+    EXPECT_TRUE(std::is_sorted(latencies.begin(), latencies.end()));
+    const auto rows = sortedRows(report.str(), false);
+    ASSERT_EQ(rows.size(), kJobs);
+    EXPECT_TRUE(std::binary_search(rows.begin(), rows.end(), "1998"));
+}
+
+TEST(BatchRunnerTest, QuotesCsvFieldsAndPicksPercentiles) {
+    std::string row;
+    BatchRunner::appendCsvField(row, "plain");
+    row += ',';
+    BatchRunner::appendCsvField(row, "say \"hi\", twice");
+    EXPECT_EQ(row, "plain,\"say \"\"hi\"\", twice\"");
+
+    EXPECT_EQ(BatchRunner::percentile({}, 0.5), 0.0);
+    EXPECT_EQ(BatchRunner::percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 0.50), 3.0);
+    EXPECT_EQ(BatchRunner::percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 0.99), 5.0);
+    EXPECT_EQ(BatchRunner::threadCount(8, 3), 3u);
+    EXPECT_EQ(BatchRunner::threadCount(2, 0), 1u);
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,128 @@
+/**
+ * C++ Code Quest - CompileRunner Tests
+ *
+ * Outcomes of the compile-and-run backend (pass, wrong output, compile and
+ * runtime errors, timeouts, output floods) and its use by the game engine.
+ * Skipped where fork or a compiler is unavailable.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CompileRunner.hpp"
+#include "GameEngine.hpp"
+
+namespace CppCodeQuestTests {
+
+using Status = CompileRunner::Status;
+
+// One pool for the whole suite; starting it builds the precompiled header
+CompileRunner* sharedRunner() {
+    static std::unique_ptr<CompileRunner> runner = [] {
+        CompileRunner::Options options;
+        options.runSeconds = 1;
+        return std::make_unique<CompileRunner>(options);
+    }();
+    return runner->ready() ? runner.get() : nullptr;
+}
+
+#define REQUIRE_RUNNER(runner)                                       \
+    CompileRunner* runner = sharedRunner();                          \
+    if (!CompileRunner::isSupported() || runner == nullptr) {        \
+        GTEST_SKIP() << "compile-and-run is unavailable here";       \
+    }
+
+// ============================================================================
+// Outcomes
+// ============================================================================
+
+TEST(CompileRunnerTest, PassesMatchingOutput) {
+    REQUIRE_RUNNER(runner);
+    const auto result = runner->run("#include <iostream>\nint main() { std::cout << 6 * 7 << '\\n'; }", "42");
+    EXPECT_EQ(result.status, Status::Passed) << result.message;
+    EXPECT_EQ(result.output, "42\n");
+    EXPECT_TRUE(result.message.empty());
+}
+
+TEST(CompileRunnerTest, ReportsWrongOutput) {
+    REQUIRE_RUNNER(runner);
+    const auto result = runner->run("#include <cstdio>\nint main() { std::puts(\"41\"); }", "42");
+    EXPECT_EQ(result.status, Status::WrongOutput);
+    EXPECT_EQ(result.output, "41\n");
+}
+
+TEST(CompileRunnerTest, ReportsCompileErrors) {
+    REQUIRE_RUNNER(runner);
+    const auto result = runner->execute("int main() { auto x = ; }");
+    EXPECT_EQ(result.status, Status::CompileError);
+    EXPECT_NE(result.output.find("error"), std::string::npos);
+}
+
+TEST(CompileRunnerTest, ReportsRuntimeErrors) {
+    REQUIRE_RUNNER(runner);
+    EXPECT_EQ(runner->execute("int main() { return 3; }").status, Status::RuntimeError);
+    EXPECT_EQ(runner->execute("#include <cstdlib>\nint main() { std::abort(); }").status, Status::RuntimeError);
+}
+
+TEST(CompileRunnerTest, StopsRunawayPrograms) {
+    REQUIRE_RUNNER(runner);
+    EXPECT_EQ(runner->execute("int main() { for (volatile int i = 0;; i = i + 1) {} }").status, Status::TimedOut);
+
+    const auto flood = runner->execute("#include <cstdio>\nint main() { for (;;) std::putchar('x'); }");
+    EXPECT_EQ(flood.status, Status::RuntimeError);
+    EXPECT_LE(flood.output.size(), runner->options().outputBytes);
+
+    // The worker that ran them is still usable
+    EXPECT_EQ(runner->execute("int main() {}").status, Status::Passed);
+}
+
+TEST(CompileRunnerTest, StatusNames) {
+    EXPECT_STREQ(CompileRunner::statusName(Status::Passed), "passed");
+    EXPECT_STREQ(CompileRunner::statusName(Status::TimedOut), "timed out");
+}
+
+TEST(CompileRunnerTest, SplitsCompilerCommands) {
+    CompileRunner::Options options;
+    options.setCompilerCommand("  ccache\tg++ -m64 ");
+    EXPECT_EQ(options.compiler, "ccache");
+    EXPECT_EQ(options.compilerArgs, (std::vector<std::string>{"g++", "-m64"}));
+    EXPECT_EQ(options.compilerCommand(), "ccache g++ -m64");
+
+    options.setCompilerCommand(" ");
+    EXPECT_EQ(options.compiler, "ccache");
+}
+
+TEST(CompileRunnerTest, PassesCompilerArguments) {
+    REQUIRE_RUNNER(runner);
+    CompileRunner::Options options = runner->options();
+    options.setCompilerCommand(options.compiler + " -DANSWER=42");
+    options.workers = 1;
+    options.precompiledHeader = false;
+    CompileRunner withArgs(options);
+    ASSERT_TRUE(withArgs.ready());
+    EXPECT_EQ(withArgs.run("#include <cstdio>\nint main() { std::printf(\"%d\\n\", ANSWER); }", "42").status,
+              Status::Passed);
+}
+
+// ============================================================================
+// Engine integration
+// ============================================================================
+
+TEST(CompileRunnerTest, EngineChecksProgramsAgainstReferenceSolutions) {
+    REQUIRE_RUNNER(runner);
+    GameEngine engine;
+    CompileRunner::Options options;
+    options.workers = 1;
+    ASSERT_TRUE(engine.enableCompileAndRun(options));
+
+    const Level& level = engine.getLevel(0);
+    EXPECT_TRUE(level.hasCompileCheck());
+    EXPECT_FALSE(level.getExpectedOutput().empty());
+    EXPECT_TRUE(level.validateSolution(std::string(level.getSolutionText())));
+
+    // Satisfies the rule but does not compile
+    EXPECT_FALSE(level.validateSolution("auto x = [] { return lambda; };"));
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,130 @@
+/**
+ * C++ Code Quest - CppLexer Tests
+ *
+ * Token boundaries and kinds for the constructs submissions actually use.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "CppLexer.hpp"
+
+namespace CppCodeQuestTests {
+
+namespace {
+
+std::vector<std::string> spellings(const TokenStream& stream) {
+    std::vector<std::string> out;
+    for (const auto& token : stream) {
+        out.emplace_back(stream.text(token));
+    }
+    return out;
+}
+
+std::vector<TokenKind> kinds(const TokenStream& stream) {
+    std::vector<TokenKind> out;
+    for (const auto& token : stream) {
+        out.push_back(token.kind);
+    }
+    return out;
+}
+
+} // namespace
+
+// ==========================================
+// Token boundaries
+// ==========================================
+
+TEST(CppLexer, SplitsCodeIntoTokens) {
+    const std::string code = "auto ptr = std::make_unique<int>(1'000);";
+    const auto stream = CppLexer::tokenize(code);
+
+    EXPECT_EQ(spellings(stream), (std::vector<std::string>{
+        "auto", "ptr", "=", "std", "::", "make_unique", "<", "int", ">", "(", "1'000", ")", ";"}));
+    EXPECT_EQ(stream[0].kind, TokenKind::Keyword);
+    EXPECT_EQ(stream[3].kind, TokenKind::Identifier);
+    EXPECT_EQ(stream[10].kind, TokenKind::Number);
+    EXPECT_EQ(stream.source().data(), code.data());
+}
+
+TEST(CppLexer, LongestMatchPunctuators) {
+    const auto stream = CppLexer::tokenize("a<<=b->*c<=>d...e&&f||g::h>>=i.*j");
+    EXPECT_EQ(spellings(stream), (std::vector<std::string>{
+        "a", "<<=", "b", "->*", "c", "<=>", "d", "...", "e", "&&", "f", "||", "g", "::", "h", ">>=", "i", ".*", "j"}));
+}
+
+TEST(CppLexer, NumbersWithExponentsAndSuffixes) {
+    const auto stream = CppLexer::tokenize("1.5e-3f 0x1p+4 .25 42ULL 0b1010'1010");
+    EXPECT_EQ(spellings(stream), (std::vector<std::string>{"1.5e-3f", "0x1p+4", ".25", "42ULL", "0b1010'1010"}));
+    EXPECT_EQ(stream.count(TokenKind::Number), 5u);
+}
+
+// ==========================================
+// Comments, literals and directives
+// ==========================================
+
+TEST(CppLexer, CommentsAndLiteralsAreSingleTokens) {
+    const std::string code =
+        "#include <memory>\n"
+        "// auto [a, b] = p; in a comment\n"
+        "/* std::move\n   still a comment */ int x = 'a';\n"
+        "const char* s = \"if constexpr \\\" lambda\";\n";
+    const auto stream = CppLexer::tokenize(code);
+
+    EXPECT_EQ(kinds(stream), (std::vector<TokenKind>{
+        TokenKind::Preprocessor, TokenKind::Comment, TokenKind::Comment,
+        TokenKind::Keyword, TokenKind::Identifier, TokenKind::Punctuator, TokenKind::Char, TokenKind::Punctuator,
+        TokenKind::Keyword, TokenKind::Keyword, TokenKind::Punctuator, TokenKind::Identifier,
+        TokenKind::Punctuator, TokenKind::String, TokenKind::Punctuator}));
+    EXPECT_EQ(stream.text(0), "#include <memory>");
+    EXPECT_EQ(stream.text(13), "\"if constexpr \\\" lambda\"");
+
+    // Text inside comments and literals no longer matches
+    EXPECT_FALSE(stream.containsToken("move"));
+    EXPECT_FALSE(stream.containsToken("constexpr"));
+    EXPECT_FALSE(stream.containsSequence({"auto", "["}));
+    EXPECT_TRUE(stream.containsSequence({"int", "x", "="}));
+}
+
+TEST(CppLexer, PrefixedAndRawStrings) {
+    const std::string code =
+        "auto a = u8\"x\"; auto b = L'y'; auto c = R\"cq(a )\" \"b)cq\"; auto d = \"s\"s; auto e = uR\"(z)\";";
+    const auto stream = CppLexer::tokenize(code);
+
+    std::vector<std::string> literals;
+    for (const auto& token : stream) {
+        if (token.kind == TokenKind::String || token.kind == TokenKind::Char) {
+            literals.emplace_back(stream.text(token));
+        }
+    }
+    EXPECT_EQ(literals, (std::vector<std::string>{"u8\"x\"", "L'y'", "R\"cq(a )\" \"b)cq\"", "\"s\"s", "uR\"(z)\""}));
+    EXPECT_EQ(stream.countToken("auto"), 5u);
+}
+
+TEST(CppLexer, DirectivesFollowLineSplicesAndUnterminatedInputEnds) {
+    const auto macro = CppLexer::tokenize("#define SQUARE(x) \\\n    ((x) * (x))\nint y;");
+    EXPECT_EQ(macro.size(), 4u);
+    EXPECT_EQ(macro[0].kind, TokenKind::Preprocessor);
+    EXPECT_EQ(macro.text(1), "int");
+
+    // '#' after code on the same line is a punctuator, not a directive
+    EXPECT_EQ(CppLexer::tokenize("x # y")[1].kind, TokenKind::Punctuator);
+
+    const auto unterminated = CppLexer::tokenize("int a; /* never closed\nint b;");
+    EXPECT_EQ(unterminated.size(), 4u);
+    EXPECT_EQ(unterminated[3].kind, TokenKind::Comment);
+
+    const auto openString = CppLexer::tokenize("auto s = \"oops\nint z;");
+    EXPECT_EQ(openString.text(3), "\"oops");
+    EXPECT_TRUE(openString.containsSequence({"int", "z", ";"}));
+}
+
+TEST(CppLexer, ReusesTheCallersVector) {
+    std::vector<Token> tokens;
+    CppLexer::tokenize("int a;", tokens);
+    CppLexer::tokenize("int b;", tokens);
+    EXPECT_EQ(tokens.size(), 6u);
+    EXPECT_EQ(sizeof(Token), 12u);
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,102 @@
+/**
+ * C++ Code Quest - FileUtils Tests
+ *
+ * Round-trip tests for the config and save-file formats.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include "FileUtils.hpp"
+#include "TempDirectoryTest.hpp"
+
+namespace CppCodeQuestTests {
+
+using GameUtils::FileUtils;
+using FileUtilsTest = TestSupport::TempDirectoryTest;
+
+TEST_F(FileUtilsTest, LoadGameConfigTrimsBlanksAndSkipsComments) {
+    ASSERT_TRUE(FileUtils::write_file(path("game.cfg"),
+        "# comment\n\n  difficulty \t=  hard \nsound_enabled=true\nmalformed line\n  =  \ntrailing=x"));
+
+    auto config = FileUtils::load_game_config(path("game.cfg"));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_EQ(config->get_string("difficulty"), "hard");
+    EXPECT_TRUE(config->get_bool("sound_enabled"));
+    EXPECT_EQ(config->get_string("trailing"), "x");
+    EXPECT_EQ(config->get_string(""), "");
+    EXPECT_EQ(config->settings.size(), 4u);
+}
+
+TEST_F(FileUtilsTest, GameProgressRoundTrip) {
+    GameUtils::GameProgress progress("Ada", 3, 125.5);
+    progress.complete_level(2);
+    progress.add_inventory_item(0);
+    progress.add_inventory_item(70);
+
+    ASSERT_TRUE(FileUtils::save_game_progress(path("progress.save"), progress));
+    auto loaded = FileUtils::load_game_progress(path("progress.save"));
+
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->player_name, "Ada");
+    EXPECT_EQ(loaded->current_level, 3);
+    EXPECT_DOUBLE_EQ(loaded->experience, 125.5);
+    EXPECT_EQ(loaded->completed_levels, 2);
+    EXPECT_TRUE(loaded->has_inventory_item(70));
+    EXPECT_FALSE(loaded->has_inventory_item(1));
+    EXPECT_EQ(loaded->inventory.count(), 2u);
+
+    // Saved as one bitmask, not a line per item
+    const auto text = FileUtils::read_file(path("progress.save"));
+    ASSERT_TRUE(text.has_value());
+    EXPECT_NE(text->find("\ninventory=400000000000000001\n"), std::string::npos) << *text;
+}
+
+TEST_F(FileUtilsTest, GameProgressReadsItemNamesFromOlderSaves) {
+    ASSERT_TRUE(FileUtils::write_file(path("old.save"),
+        "player_name=Ada\ninventory_item=Lambda Mastery Badge\ninventory_item=Lost Relic\n"));
+    auto resolve = [](std::string_view name) -> std::optional<Inventory::ItemId> {
+        if (name == "Lambda Mastery Badge") {
+            return 1;
+        }
+        return std::nullopt;
+    };
+    auto loaded = FileUtils::load_game_progress(path("old.save"), resolve);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_TRUE(loaded->has_inventory_item(1));
+    EXPECT_EQ(loaded->inventory.count(), 1u);
+
+    ASSERT_TRUE(FileUtils::write_file(path("bad.save"), "inventory=12zz\n"));
+    EXPECT_FALSE(FileUtils::load_game_progress(path("bad.save")).has_value());
+}
+
+TEST_F(FileUtilsTest, WritesBytesAsIsAndReadsCrlfFiles) {
+    GameUtils::GameProgress progress("Ada", 3, 125.5);
+    progress.add_inventory_item(13);
+    ASSERT_TRUE(FileUtils::save_game_progress(path("progress.save"), progress));
+    const auto text = FileUtils::read_file(path("progress.save"));
+    ASSERT_TRUE(text.has_value());
+    EXPECT_EQ(text->find('\r'), std::string::npos);
+
+    // The same save as an editor on Windows would leave it
+    std::string crlf;
+    for (const char c : *text) {
+        crlf += c == '\n' ? "\r\n" : std::string(1, c);
+    }
+    ASSERT_TRUE(FileUtils::write_file(path("crlf.save"), crlf));
+    EXPECT_EQ(FileUtils::read_file(path("crlf.save")), crlf);
+
+    const auto loaded = FileUtils::load_game_progress(path("crlf.save"));
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->player_name, "Ada");
+    EXPECT_DOUBLE_EQ(loaded->experience, 125.5);
+    EXPECT_TRUE(loaded->has_inventory_item(13));
+    EXPECT_EQ(loaded->inventory.count(), 1u);
+
+    ASSERT_TRUE(FileUtils::write_file(path("game.cfg"), "difficulty = hard\r\nsound_enabled=true\r\n"));
+    const auto config = FileUtils::load_game_config(path("game.cfg"));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_EQ(config->get_string("difficulty"), "hard");
+    EXPECT_TRUE(config->get_bool("sound_enabled"));
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,64 @@
+/**
+ * C++ Code Quest - FunctionRef Tests
+ *
+ * Non-owning callable references.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include "FunctionRef.hpp"
+
+namespace CppCodeQuestTests {
+
+namespace {
+
+bool startsWithAuto(std::string_view code) {
+    return code.substr(0, 4) == "auto";
+}
+
+size_t callTwice(FunctionRef<size_t(std::string_view)> f, std::string_view text) {
+    return f(text) + f(text);
+}
+
+} // namespace
+
+TEST(FunctionRefTest, CallsLambdasWithoutCopyingThem) {
+    size_t calls = 0;
+    auto counter = [&calls](std::string_view text) {
+        ++calls;
+        return text.size();
+    };
+    EXPECT_EQ(callTwice(counter, "abc"), 6u);
+    EXPECT_EQ(calls, 2u);       // the same lambda object saw both calls
+
+    // A temporary lives for the whole call
+    EXPECT_EQ(callTwice([](std::string_view text) { return text.size() * 10; }, "ab"), 40u);
+}
+
+TEST(FunctionRefTest, AcceptsFunctionPointersAndConstCallables) {
+    // Function pointers are held by value, so a temporary &f is fine
+    FunctionRef<bool(std::string_view)> ref(&startsWithAuto);
+    EXPECT_TRUE(ref("auto x = 1;"));
+    EXPECT_FALSE(ref("int x = 1;"));
+
+    const auto isEmpty = [](std::string_view text) { return text.empty(); };
+    FunctionRef<bool(std::string_view)> constRef(isEmpty);
+    EXPECT_TRUE(constRef(""));
+
+    // Copies refer to the same callable
+    FunctionRef<bool(std::string_view)> copy = ref;
+    EXPECT_TRUE(copy("auto"));
+    FunctionRef<bool(std::string_view)> named(startsWithAuto);
+    EXPECT_TRUE(named("auto&& x"));
+}
+
+TEST(FunctionRefTest, ConvertsArgumentsAndResults) {
+    // std::string arguments bind to the view parameter; int converts to long
+    auto length = [](std::string_view text) { return static_cast<int>(text.size()); };
+    FunctionRef<long(std::string_view)> ref(length);
+    const std::string text = "four";
+    EXPECT_EQ(ref(text), 4L);
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,323 @@
+/**
+ * C++ Code Quest - Game Server Tests
+ *
+ * Engines on injected and fed streams, socket addresses, and whole games
+ * played against the server over a Unix socket.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GameEngine.hpp"
+#include "GameServer.hpp"
+#include "InputReader.hpp"
+#include "LevelCatalog.hpp"
+#include "Renderer.hpp"
+#include "SocketAddress.hpp"
+
+#if defined(CQ_SOCKETS_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CppCodeQuestTests {
+
+// What a player who knows every answer types
+std::string winningTranscript() {
+    std::string transcript = "\n";
+    for (const auto& level : LevelCatalog::builtin()) {
+        transcript += std::string(level.solution);
+        if (transcript.back() != '\n') {
+            transcript += '\n';
+        }
+        transcript += "DONE\ny\n";
+    }
+    return transcript;
+}
+
+// ============================================================================
+// Injected streams
+// ============================================================================
+
+TEST(GameEngineStreamsTest, PlaysAWholeGameOnInjectedStreams) {
+    std::istringstream in(winningTranscript());
+    std::ostringstream out;
+    InputReader input(InputReader::fromStream(in));
+    Renderer output(Renderer::toStream(out));
+    output.setPacing(false);
+
+    GameEngine engine(input, output);
+    engine.run();
+
+    EXPECT_TRUE(engine.isGameComplete());
+    for (size_t i = 0; i < engine.getLevelCount(); ++i) {
+        EXPECT_TRUE(engine.isLevelCompleted(i)) << "level " << i + 1;
+        EXPECT_TRUE(engine.getInventory().has(engine.getCatalog().rewardOf(i)));
+    }
+    EXPECT_EQ(engine.getInventory().count(), engine.getCatalog().rewardCount());
+    EXPECT_NE(out.str().find("Welcome, brave programmer!"), std::string::npos);
+    EXPECT_NE(out.str().find("CONGRATULATIONS"), std::string::npos);
+}
+
+TEST(GameEngineStreamsTest, EndOfInputEndsTheGame) {
+    std::istringstream in("\n");
+    std::ostringstream out;
+    InputReader input(InputReader::fromStream(in));
+    Renderer output(Renderer::toStream(out));
+    output.setPacing(false);
+
+    GameEngine engine(input, output);
+    engine.run();
+
+    EXPECT_FALSE(engine.isGameComplete());
+    EXPECT_NE(out.str().find("Game saved!"), std::string::npos);
+}
+
+TEST(GameEngineStreamsTest, EnginesShareLevelsButNotProgress) {
+    std::istringstream in(winningTranscript());
+    std::ostringstream out;
+    InputReader input(InputReader::fromStream(in));
+    Renderer output(Renderer::toStream(out));
+    output.setPacing(false);
+
+    GameEngine player(input, output);
+    GameEngine waiting(input, output, player.getLevels());
+    EXPECT_EQ(waiting.getLevels(), player.getLevels());
+    EXPECT_EQ(GameEngine().getLevels(), LevelSet::builtin());
+    EXPECT_EQ(&waiting.getLevel(0), &player.getLevel(0));
+
+    player.run();
+    EXPECT_TRUE(player.isGameComplete());
+    EXPECT_TRUE(player.isLevelCompleted(0));
+    EXPECT_FALSE(waiting.isLevelCompleted(0));
+    EXPECT_EQ(waiting.getProgressPercentage(), 0.0);
+}
+
+TEST(GameEngineStreamsTest, SuspendsBetweenLinesOnAFedReader) {
+    InputReader input{InputReader::Options()};
+    std::ostringstream out;
+    Renderer output(Renderer::toStream(out));
+    output.setPacing(false);
+    GameEngine engine(input, output);
+
+    auto game = engine.play();
+    game.start();
+    EXPECT_FALSE(game.done());
+    EXPECT_TRUE(input.waiting());
+
+    const std::string transcript = winningTranscript();
+    size_t start = 0;
+    while (start < transcript.size()) {
+        EXPECT_FALSE(game.done());
+        const size_t end = transcript.find('\n', start) + 1;
+        input.feed(std::string_view(transcript).substr(start, end - start));
+        start = end;
+    }
+    ASSERT_TRUE(game.done());
+    game.result();
+    EXPECT_TRUE(engine.isGameComplete());
+    output.drain();
+    EXPECT_NE(out.str().find("CONGRATULATIONS"), std::string::npos);
+
+    // run() cannot wait for input that has to be fed
+    InputReader fed{InputReader::Options()};
+    GameEngine blocked(fed, output);
+    EXPECT_THROW(blocked.run(), std::logic_error);
+}
+
+// ============================================================================
+// SocketAddress
+// ============================================================================
+
+#if defined(CQ_SOCKETS_POSIX)
+TEST(SocketAddressTest, ParsesTcpAndUnixAddresses) {
+    std::string error;
+    EXPECT_TRUE(SocketAddress::parse("tcp:7000", error));
+    EXPECT_TRUE(SocketAddress::parse("tcp:0.0.0.0:0", error));
+    const auto local = SocketAddress::parse("unix:/tmp/quest.sock", error);
+    ASSERT_TRUE(local);
+    EXPECT_TRUE(local->isUnix());
+    EXPECT_EQ(local->text(), "unix:/tmp/quest.sock");
+}
+
+TEST(SocketAddressTest, RejectsMalformedAddresses) {
+    for (const char* text : {"7000", "tcp:", "tcp:70000", "tcp:port", "tcp:localhost:7000", "unix:", "udp:7000"}) {
+        std::string error;
+        EXPECT_FALSE(SocketAddress::parse(text, error)) << text;
+        EXPECT_FALSE(error.empty()) << text;
+    }
+    std::string error;
+    EXPECT_FALSE(SocketAddress::parse("unix:" + std::string(200, 'x'), error));
+}
+
+TEST(SocketAddressTest, ListensNonBlockingAndClosesOnExec) {
+    std::string error;
+    const auto address = SocketAddress::parse("tcp:0", error);
+    ASSERT_TRUE(address) << error;
+    const int listener = address->listen(4);
+    ASSERT_GE(listener, 0);
+    EXPECT_NE(::fcntl(listener, F_GETFL) & O_NONBLOCK, 0);
+    EXPECT_NE(::fcntl(listener, F_GETFD) & FD_CLOEXEC, 0);
+
+    const auto bound = SocketAddress::parse(SocketAddress::boundTo(listener), error);
+    ASSERT_TRUE(bound) << error;
+    const int client = bound->connect();
+    ASSERT_GE(client, 0);
+    EXPECT_EQ(::fcntl(client, F_GETFL) & O_NONBLOCK, 0);
+    EXPECT_NE(::fcntl(client, F_GETFD) & FD_CLOEXEC, 0);
+    ::close(client);
+    ::close(listener);
+}
+#endif
+
+// ============================================================================
+// GameServer
+// ============================================================================
+
+#if defined(__linux__)
+
+class GameServerTest : public ::testing::Test {
+protected:
+    std::string socketPath_;
+
+    void SetUp() override {
+        socketPath_ = (std::filesystem::temp_directory_path() /
+                       ("cq_server_test_" + std::to_string(::getpid()) + ".sock")).string();
+    }
+
+    static GameServer::Options options(const std::string& address) {
+        GameServer::Options options;
+        options.address = address;
+        options.pacing = false;
+        return options;
+    }
+
+    static std::unique_ptr<GameEngine> makeEngine(InputReader& input, Renderer& output) {
+        return std::make_unique<GameEngine>(input, output);
+    }
+
+    // Sends `transcript` and returns everything the server says until it
+    // hangs up
+    static std::string play(const SocketAddress& address, const std::string& transcript) {
+        const int fd = address.connect();
+        if (fd < 0) {
+            return {};
+        }
+        // A session that ends early may close before reading everything
+        [[maybe_unused]] const auto sent = ::send(fd, transcript.data(), transcript.size(), MSG_NOSIGNAL);
+        std::string received;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+            received.append(buffer, static_cast<size_t>(count));
+        }
+        ::close(fd);
+        return received;
+    }
+};
+
+TEST_F(GameServerTest, ServesConcurrentGamesOverAUnixSocket) {
+    GameServer server(options("unix:" + socketPath_), makeEngine);
+    ASSERT_TRUE(server.start());
+    EXPECT_EQ(server.boundAddress(), "unix:" + socketPath_);
+    std::thread reactor([&] { server.run(); });
+
+    std::string error;
+    const auto address = SocketAddress::parse(server.boundAddress(), error);
+    ASSERT_TRUE(address);
+    const std::string transcript = winningTranscript();
+    std::vector<std::string> outputs(4);
+    std::vector<std::thread> players;
+    for (auto& output : outputs) {
+        players.emplace_back([&] { output = play(*address, transcript); });
+    }
+    for (auto& player : players) {
+        player.join();
+    }
+    server.stop();
+    reactor.join();
+
+    for (const auto& output : outputs) {
+        EXPECT_NE(output.find("CONGRATULATIONS"), std::string::npos);
+    }
+    EXPECT_EQ(server.stats().sessionsServed, 4u);
+    EXPECT_GE(server.stats().peakSessions, 1u);
+}
+
+TEST_F(GameServerTest, StopEndsSessionsWhosePlayersAreIdle) {
+    GameServer server(options("tcp:127.0.0.1:0"), makeEngine);
+    ASSERT_TRUE(server.start());
+    EXPECT_EQ(server.boundAddress().rfind("tcp:127.0.0.1:", 0), 0u);
+    std::thread reactor([&] { server.run(); });
+
+    std::string error;
+    const auto address = SocketAddress::parse(server.boundAddress(), error);
+    ASSERT_TRUE(address);
+    const int fd = address->connect();
+    ASSERT_GE(fd, 0);
+    std::string received;
+    char buffer[4096];
+    while (received.find("Press Enter") == std::string::npos) {
+        const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        ASSERT_GT(count, 0);
+        received.append(buffer, static_cast<size_t>(count));
+    }
+
+    // The idle player sees end of input, and the game saves and says goodbye
+    server.stop();
+    ssize_t count;
+    while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        received.append(buffer, static_cast<size_t>(count));
+    }
+    ::close(fd);
+    reactor.join();
+
+    EXPECT_NE(received.find("Game saved!"), std::string::npos);
+    EXPECT_EQ(server.stats().sessionsServed, 1u);
+}
+
+TEST_F(GameServerTest, FloodedLinesAreDroppedWithoutStallingOtherPlayers) {
+    GameServer server(options("unix:" + socketPath_), makeEngine);
+    ASSERT_TRUE(server.start());
+    std::thread reactor([&] { server.run(); });
+
+    std::string error;
+    const auto address = SocketAddress::parse(server.boundAddress(), error);
+    ASSERT_TRUE(address);
+    // Megabytes with no newline at the first prompt; the line is skipped
+    // and the game goes on with the next one
+    std::string flooded;
+    std::thread flooder([&] { flooded = play(*address, std::string(4 << 20, 'x') + "\n" + winningTranscript()); });
+    const std::string other = play(*address, winningTranscript());
+    flooder.join();
+    server.stop();
+    reactor.join();
+
+    EXPECT_NE(other.find("CONGRATULATIONS"), std::string::npos);
+    EXPECT_NE(flooded.find("CONGRATULATIONS"), std::string::npos);
+}
+
+TEST_F(GameServerTest, FactoryCanRefuseASession) {
+    GameServer server(options("unix:" + socketPath_), [](InputReader&, Renderer& output) {
+        output << "Closed for maintenance\n";
+        return std::unique_ptr<GameEngine>();
+    });
+    ASSERT_TRUE(server.start());
+    std::thread reactor([&] { server.run(); });
+
+    std::string error;
+    const auto address = SocketAddress::parse(server.boundAddress(), error);
+    ASSERT_TRUE(address);
+    EXPECT_EQ(play(*address, "\n"), "Closed for maintenance\n");
+
+    server.stop();
+    reactor.join();
+}
+
+#endif
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,236 @@
+/**
+ * C++ Code Quest - InputReader Tests
+ *
+ * Line reading across block boundaries, DONE-terminated submissions, the
+ * size limit and what is left for the next read, and fed readers awaited
+ * from coroutines.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "InputReader.hpp"
+#include "Task.hpp"
+
+namespace CppCodeQuestTests {
+
+InputReader::Options smallBlocks(size_t blockSize, size_t maxSubmissionBytes = 1024) {
+    InputReader::Options options;
+    options.blockSize = blockSize;
+    options.maxSubmissionBytes = maxSubmissionBytes;
+    return options;
+}
+
+// ============================================================================
+// Lines
+// ============================================================================
+
+TEST(InputReaderTest, ReadsLinesLikeGetline) {
+    for (size_t block : {size_t{1}, size_t{3}, size_t{64}}) {
+        std::istringstream in("first\n\nthird line\nlast");
+        InputReader reader(InputReader::fromStream(in), smallBlocks(block));
+
+        std::vector<std::string> lines;
+        for (std::string line; reader.readLine(line);) {
+            lines.push_back(line);
+        }
+        EXPECT_EQ(lines, (std::vector<std::string>{"first", "", "third line", "last"})) << "block " << block;
+    }
+}
+
+TEST(InputReaderTest, EmptyInputHasNoLines) {
+    std::istringstream in("");
+    InputReader reader(InputReader::fromStream(in));
+    std::string line = "stale";
+    EXPECT_FALSE(reader.readLine(line));
+    EXPECT_TRUE(line.empty());
+}
+
+TEST(InputReaderTest, OverlongLinesAreSkipped) {
+    InputReader::Options options = smallBlocks(4);
+    options.maxLineBytes = 8;
+    const std::string text = "short\n" + std::string(100, 'x') + "\nafter\n" + std::string(20, 'y');
+    InputReader reader(InputReader::fromText(text), options);
+
+    std::string line;
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(line, "short");
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(line, "after");
+    EXPECT_FALSE(reader.readLine(line));    // the overlong tail is dropped too
+}
+
+// ============================================================================
+// Submissions
+// ============================================================================
+
+TEST(InputReaderTest, SubmissionStopsAtTheSentinel) {
+    std::istringstream in("auto x = 1;\n  DONE\nauto y = 2;\nDONE\r\n2\n");
+    InputReader reader(InputReader::fromStream(in), smallBlocks(5));
+
+    std::vector<std::string> seen;
+    std::string code;
+    EXPECT_EQ(reader.readSubmission(code, "DONE", [&](std::string_view soFar) { seen.emplace_back(soFar); }),
+              InputReader::Status::Complete);
+    EXPECT_EQ(code, "auto x = 1;\n  DONE\nauto y = 2;\n");
+    EXPECT_EQ(seen, (std::vector<std::string>{"auto x = 1;\n", "auto x = 1;\n  DONE\n", code}));
+
+    // Input after the sentinel is still there for the next prompt
+    std::string line;
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(line, "2");
+}
+
+TEST(InputReaderTest, EndOfInputKeepsTheCode) {
+    std::istringstream in("int x;\nint y;");
+    InputReader reader(InputReader::fromStream(in));
+    std::string code;
+    EXPECT_EQ(reader.readSubmission(code, "DONE"), InputReader::Status::EndOfInput);
+    EXPECT_EQ(code, "int x;\nint y;\n");
+
+    EXPECT_EQ(reader.readSubmission(code, "DONE"), InputReader::Status::EndOfInput);
+    EXPECT_EQ(code, "");
+}
+
+TEST(InputReaderTest, OversizedSubmissionsAreSkippedUpToTheSentinel) {
+    const std::string longLine(1000, 'x');
+    std::istringstream in("short\n" + longLine + "\nmore\nDONE\nok\nDONE\n" + longLine + "DONE\nDONE\ny\n");
+    InputReader reader(InputReader::fromStream(in), smallBlocks(7, 64));
+
+    std::string code;
+    EXPECT_EQ(reader.readSubmission(code, "DONE"), InputReader::Status::TooLarge);
+    EXPECT_TRUE(code.empty());
+
+    EXPECT_EQ(reader.readSubmission(code, "DONE"), InputReader::Status::Complete);
+    EXPECT_EQ(code, "ok\n");
+
+    // A long line ending in the sentinel's text is not the sentinel
+    EXPECT_EQ(reader.readSubmission(code, "DONE"), InputReader::Status::TooLarge);
+    std::string line;
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(line, "y");
+}
+
+TEST(InputReaderTest, LargePastesTakeFewReads) {
+    std::string paste;
+    for (int i = 0; i < 20000; ++i) {
+        paste += "    total += counts[" + std::to_string(i) + "];\n";
+    }
+    std::istringstream in(paste + "DONE\n");
+    InputReader reader(InputReader::fromStream(in));
+
+    std::string code;
+    ASSERT_EQ(reader.readSubmission(code, "DONE"), InputReader::Status::Complete);
+    EXPECT_EQ(code, paste);
+    EXPECT_LE(reader.readCalls(), paste.size() / reader.options().blockSize + 2);
+}
+
+// ============================================================================
+// Fed readers
+// ============================================================================
+
+Task<> readTwoLines(InputReader& reader, std::vector<std::string>& lines) {
+    for (int i = 0; i < 2; ++i) {
+        std::string line;
+        const bool ok = co_await reader.line(line);
+        if (!ok) {
+            co_return;
+        }
+        lines.push_back(line);
+    }
+}
+
+// A coroutine's parameters live in its frame; a capturing lambda coroutine
+// would dangle once the temporary closure is gone
+Task<> readSubmission(InputReader& reader, std::string& code, InputReader::Status& status,
+                      InputReader::LineCallback onLine = {}) {
+    status = co_await reader.submission(code, "DONE", onLine);
+}
+
+TEST(InputReaderTest, FedReaderSuspendsUntilALineArrives) {
+    InputReader reader(smallBlocks(4));
+    std::vector<std::string> lines;
+    auto task = readTwoLines(reader, lines);
+    task.start();
+    EXPECT_FALSE(task.done());
+    EXPECT_TRUE(reader.waiting());
+
+    reader.feed("fir");
+    EXPECT_TRUE(lines.empty());     // no newline yet
+    reader.feed("st\nsec");
+    EXPECT_EQ(lines, std::vector<std::string>({"first"}));
+    reader.feed("ond\nleft over\n");
+    EXPECT_TRUE(task.done());
+    EXPECT_FALSE(reader.waiting());
+    EXPECT_EQ(lines, std::vector<std::string>({"first", "second"}));
+
+    std::string line;
+    ASSERT_TRUE(reader.readLine(line));     // buffered, so no waiting
+    EXPECT_EQ(line, "left over");
+}
+
+TEST(InputReaderTest, FedLineWithoutANewlineStaysBounded) {
+    InputReader::Options options = smallBlocks(4);
+    options.maxLineBytes = 64;
+    InputReader reader(options);
+    std::vector<std::string> lines;
+    auto task = readTwoLines(reader, lines);
+    task.start();
+
+    const std::string chunk(100, 'x');
+    for (int i = 0; i < 1000; ++i) {
+        reader.feed(chunk);
+        ASSERT_LE(reader.buffered(), options.maxLineBytes + chunk.size());
+    }
+    EXPECT_TRUE(lines.empty());
+    reader.feed("\nfirst\nsecond\n");
+    ASSERT_TRUE(task.done());
+    EXPECT_EQ(lines, std::vector<std::string>({"first", "second"}));
+}
+
+TEST(InputReaderTest, FedSubmissionContinuesWhereItStopped) {
+    InputReader reader(smallBlocks(4, 32));
+    std::string code;
+    std::vector<std::string> seen;
+    const InputReader::LineCallback onLine = [&](std::string_view soFar) { seen.emplace_back(soFar); };
+    InputReader::Status status = InputReader::Status::EndOfInput;
+    auto task = readSubmission(reader, code, status, onLine);
+    task.start();
+
+    reader.feed("auto x");
+    reader.feed(" = 1;\nint y;\nDO");
+    EXPECT_FALSE(task.done());
+    EXPECT_EQ(seen, std::vector<std::string>({"auto x = 1;\n", "auto x = 1;\nint y;\n"}));
+    reader.feed("NE\n");
+    ASSERT_TRUE(task.done());
+    EXPECT_EQ(status, InputReader::Status::Complete);
+    EXPECT_EQ(code, "auto x = 1;\nint y;\n");
+    EXPECT_EQ(seen.size(), 2u);     // lines are reported once
+}
+
+TEST(InputReaderTest, FedSubmissionSkipsOversizedInputAndSeesTheEnd) {
+    InputReader reader(smallBlocks(4, 16));
+    std::string code;
+    InputReader::Status status = InputReader::Status::Complete;
+    auto oversized = readSubmission(reader, code, status);
+    oversized.start();
+    reader.feed(std::string(40, 'x'));
+    reader.feed("\nmore\nDONE\nnext\n");
+    ASSERT_TRUE(oversized.done());
+    EXPECT_EQ(status, InputReader::Status::TooLarge);
+
+    std::string line;
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(line, "next");
+
+    auto unfinished = readSubmission(reader, code, status);
+    unfinished.start();
+    reader.feed("partial");
+    reader.closeInput();
+    ASSERT_TRUE(unfinished.done());
+    EXPECT_EQ(status, InputReader::Status::EndOfInput);
+    EXPECT_EQ(code, "partial\n");
+}
+
+} // namespace CppCodeQuestTests
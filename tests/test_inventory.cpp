@@ -0,0 +1,88 @@
+/**
+ * C++ Code Quest - Inventory Tests
+ *
+ * The item bitset: membership, union, subset checks, iteration order and
+ * the hex save form.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "Inventory.hpp"
+
+namespace CppCodeQuestTests {
+
+Inventory inventoryOf(const std::vector<Inventory::ItemId>& items) {
+    Inventory inventory;
+    for (const auto item : items) {
+        inventory.add(item);
+    }
+    return inventory;
+}
+
+std::vector<Inventory::ItemId> itemsOf(const Inventory& inventory) {
+    std::vector<Inventory::ItemId> items;
+    inventory.forEach([&](Inventory::ItemId item) { items.push_back(item); });
+    return items;
+}
+
+TEST(InventoryTest, AddsAndTestsItemsOnBothSidesOfTheInlineWord) {
+    Inventory inventory;
+    EXPECT_TRUE(inventory.empty());
+    inventory.add(3);
+    inventory.add(63);
+    inventory.add(64);
+    inventory.add(200);
+    inventory.add(3);
+
+    EXPECT_EQ(inventory.count(), 4u);
+    EXPECT_TRUE(inventory.has(63));
+    EXPECT_TRUE(inventory.has(200));
+    EXPECT_FALSE(inventory.has(4));
+    EXPECT_FALSE(inventory.has(65));
+    EXPECT_FALSE(inventory.has(100000));
+    EXPECT_EQ(itemsOf(inventory), (std::vector<Inventory::ItemId>{3, 63, 64, 200}));
+
+    inventory.clear();
+    EXPECT_TRUE(inventory.empty());
+    EXPECT_FALSE(inventory.has(200));
+}
+
+TEST(InventoryTest, MergesAndChecksSubsets) {
+    Inventory player = inventoryOf({0, 2});
+    const Inventory unlock = inventoryOf({2, 130});
+    EXPECT_FALSE(player.includes(unlock));
+
+    player.merge(inventoryOf({130, 5}));
+    EXPECT_TRUE(player.includes(unlock));
+    EXPECT_FALSE(unlock.includes(player));
+    EXPECT_TRUE(player.includes(Inventory()));
+    EXPECT_EQ(itemsOf(player), (std::vector<Inventory::ItemId>{0, 2, 5, 130}));
+
+    // Equality ignores how many words each side holds
+    Inventory wide = inventoryOf({1, 300});
+    Inventory small = inventoryOf({1});
+    EXPECT_NE(wide, small);
+    small.merge(inventoryOf({300}));
+    EXPECT_EQ(wide, small);
+    EXPECT_EQ(inventoryOf({7}), *Inventory::fromHex("080"));
+}
+
+TEST(InventoryTest, HexRoundTrips) {
+    EXPECT_EQ(Inventory().toHex(), "0");
+    EXPECT_EQ(inventoryOf({0, 1, 4}).toHex(), "13");
+    EXPECT_EQ(inventoryOf({64}).toHex(), "10000000000000000");
+
+    const Inventory items = inventoryOf({0, 9, 63, 64, 127, 1000});
+    const auto parsed = Inventory::fromHex(items.toHex());
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(*parsed, items);
+    EXPECT_EQ(itemsOf(*Inventory::fromHex("1F")), (std::vector<Inventory::ItemId>{0, 1, 2, 3, 4}));
+    EXPECT_TRUE(Inventory::fromHex("0")->empty());
+
+    EXPECT_FALSE(Inventory::fromHex(""));
+    EXPECT_FALSE(Inventory::fromHex("12g"));
+    EXPECT_FALSE(Inventory::fromHex("1" + std::string(Inventory::kMaxId / 4 + 1, '0')));
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,268 @@
+/**
+ * C++ Code Quest - LevelCatalog Tests
+ *
+ * Catalog parsing, id lookup, error reporting and the engine playing a
+ * catalog loaded from a file.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "GameEngine.hpp"
+#include "LevelCatalog.hpp"
+#include "FileUtils.hpp"
+#include "TempDirectoryTest.hpp"
+
+namespace CppCodeQuestTests {
+
+// One complete level; `rule` and `solution` vary, the rest is filler
+std::string catalogLevel(int id, const std::string& rule = "contains(\"auto\")",
+                         const std::string& solution = "int main() {}") {
+    const std::string n = std::to_string(id);
+    return "[level " + n + "]\n"
+           "title = Title " + n + "\n"
+           "story = Story " + n + "\n"
+           "character = Character\n"
+           "dialogue = Hello\n"
+           "concept = Concept " + n + "\n"
+           "explanation = Explained\n"
+           "challenge = Do it\n"
+           "reward = Reward " + n + "\n"
+           "hint = Hint " + n + "\n"
+           "rule = " + rule + "\n"
+           "solution = <<END\n" + solution + "\nEND\n";
+}
+
+std::string parseError(const std::string& text) {
+    std::string error;
+    EXPECT_FALSE(LevelCatalog::parse(text, error).has_value());
+    return error;
+}
+
+// ============================================================================
+// Parsing and lookup
+// ============================================================================
+
+TEST(LevelCatalogTest, BuiltinCatalogHasTheFiveLevels) {
+    const LevelCatalog& catalog = LevelCatalog::builtin();
+    ASSERT_EQ(catalog.size(), 5u);
+    for (std::uint32_t id = 1; id <= 5; ++id) {
+        const auto* entry = catalog.find(id);
+        ASSERT_NE(entry, nullptr) << id;
+        EXPECT_EQ(entry->id, id);
+        EXPECT_FALSE(entry->title.empty());
+        EXPECT_NE(entry->solution.find("int main()"), std::string_view::npos) << id;
+    }
+    EXPECT_EQ(catalog.find(1)->title, "The Temple of Auto");
+    EXPECT_EQ(catalog.find(0), nullptr);
+    EXPECT_EQ(catalog.find(6), nullptr);
+    EXPECT_EQ(catalog.find(LevelCatalog::kMaxId + 1), nullptr);
+}
+
+TEST(LevelCatalogTest, BlockValuesKeepTheirLinesAndViewTheText) {
+    std::string error;
+    const auto catalog = LevelCatalog::parse(
+        "# comment\n\n" + catalogLevel(3, "contains(\"x\")", "int main() {\n    return 0;\n}"), error);
+    ASSERT_TRUE(catalog) << error;
+
+    const auto* entry = catalog->find(3);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->solution, "int main() {\n    return 0;\n}");
+    EXPECT_EQ(entry->rule, "contains(\"x\")");
+    EXPECT_EQ(entry->conceptName, "Concept 3");
+
+    // Copies share the text, so views stay valid after the original is gone
+    LevelCatalog copy = *catalog;
+    const char* data = catalog->find(3)->solution.data();
+    EXPECT_EQ(copy.find(3)->solution.data(), data);
+}
+
+TEST(LevelCatalogTest, SparseIdsAreOrderedById) {
+    std::string error;
+    const auto catalog = LevelCatalog::parse(catalogLevel(40) + catalogLevel(7) + catalogLevel(300), error);
+    ASSERT_TRUE(catalog) << error;
+    ASSERT_EQ(catalog->size(), 3u);
+    EXPECT_EQ((*catalog)[0].id, 7u);
+    EXPECT_EQ((*catalog)[1].id, 40u);
+    EXPECT_EQ((*catalog)[2].id, 300u);
+    EXPECT_EQ(catalog->find(40)->hint, "Hint 40");
+    EXPECT_EQ(catalog->find(41), nullptr);
+}
+
+TEST(LevelCatalogTest, ReportsMistakesWithLineNumbers) {
+    EXPECT_EQ(parseError(catalogLevel(1) + catalogLevel(1)), "line 15: level 1 is defined twice");
+    EXPECT_EQ(parseError("[level 0]\n"), "line 1: expected [level <id>] with an id from 1 to 65535");
+    EXPECT_EQ(parseError("title = x\n"), "line 1: field before the first [level <id>]");
+    EXPECT_EQ(parseError("[level 2]\ncolour = red\n"), "line 2: unknown field 'colour'");
+    EXPECT_EQ(parseError("[level 2]\ntitle = a\ntitle = b\n"), "line 3: field 'title' given twice");
+    EXPECT_EQ(parseError("[level 2]\njust text\n"), "line 2: expected name = value");
+    EXPECT_EQ(parseError("[level 2]\nstory = <<END\nno end\n"), "line 2: no line 'END' ends the story");
+
+    std::string partial = catalogLevel(5);
+    partial.erase(partial.find("hint = "), std::string("hint = Hint 5\n").size());
+    EXPECT_EQ(parseError(partial), "line 1: level 5 has no hint");
+}
+
+// ============================================================================
+// Binary packs
+// ============================================================================
+
+void expectSameLevels(const LevelCatalog& a, const LevelCatalog& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].id, b[i].id);
+        EXPECT_EQ(a[i].title, b[i].title);
+        EXPECT_EQ(a[i].story, b[i].story);
+        EXPECT_EQ(a[i].character, b[i].character);
+        EXPECT_EQ(a[i].dialogue, b[i].dialogue);
+        EXPECT_EQ(a[i].conceptName, b[i].conceptName);
+        EXPECT_EQ(a[i].explanation, b[i].explanation);
+        EXPECT_EQ(a[i].challenge, b[i].challenge);
+        EXPECT_EQ(a[i].reward, b[i].reward);
+        EXPECT_EQ(a[i].hint, b[i].hint);
+        EXPECT_EQ(a[i].solution, b[i].solution);
+        EXPECT_EQ(a[i].rule, b[i].rule);
+    }
+}
+
+TEST(LevelCatalogTest, PackRoundTripsEveryField) {
+    const std::string pack = LevelCatalog::builtin().toPack();
+    EXPECT_TRUE(LevelCatalog::isPack(pack));
+    EXPECT_FALSE(LevelCatalog::isPack("[level 1]\n"));
+
+    std::string error;
+    const auto unpacked = LevelCatalog::parsePack(pack, error);
+    ASSERT_TRUE(unpacked) << error;
+    expectSameLevels(*unpacked, LevelCatalog::builtin());
+    EXPECT_EQ(unpacked->find(4)->title, "The Valley of Move Semantics");
+    EXPECT_EQ(unpacked->toPack(), pack);
+}
+
+TEST(LevelCatalogTest, RejectsDamagedPacks) {
+    std::string error;
+    const auto catalog = LevelCatalog::parse(catalogLevel(2) + catalogLevel(9), error);
+    ASSERT_TRUE(catalog) << error;
+    const std::string pack = catalog->toPack();
+
+    auto rejected = [&](std::string bytes) {
+        std::string message;
+        EXPECT_FALSE(LevelCatalog::parsePack(std::move(bytes), message).has_value());
+        return message;
+    };
+    auto withU32 = [&](size_t at, std::uint32_t value) {
+        std::string bytes = pack;
+        for (size_t i = 0; i < 4; ++i, value >>= 8) {
+            bytes[at + i] = static_cast<char>(value & 0xff);
+        }
+        return bytes;
+    };
+    const size_t recordSize = 4 + 11 * 8;
+
+    EXPECT_EQ(rejected(pack.substr(0, 12)), "not a level pack");
+    EXPECT_EQ(rejected(withU32(8, 7)), "pack version 7 is not supported");
+    EXPECT_EQ(rejected(withU32(12, 1000)), "level table runs past the end of the pack");
+    EXPECT_EQ(rejected(pack.substr(0, pack.size() - 1)), "level 9: rule lies outside the pack");
+    EXPECT_EQ(rejected(withU32(16 + 4, 0)), "level 2: title lies outside the pack");
+    EXPECT_EQ(rejected(withU32(16 + recordSize, 2)), "level record 2: id 2 is out of range or out of order");
+    EXPECT_EQ(rejected(withU32(16, 0)), "level record 1: id 0 is out of range or out of order");
+}
+
+// ============================================================================
+// Catalogs in the engine
+// ============================================================================
+
+TEST(LevelCatalogTest, InternsRewardsInOrderOfFirstAppearance) {
+    // Levels 1 and 3 give the same reward
+    std::string third = catalogLevel(3);
+    third.replace(third.find("Reward 3"), 8, "Reward 1");
+    const std::string text = catalogLevel(1) + catalogLevel(2) + third;
+    std::string error;
+    const auto catalog = LevelCatalog::parse(text, error);
+    ASSERT_TRUE(catalog) << error;
+
+    ASSERT_EQ(catalog->rewardCount(), 2u);
+    EXPECT_EQ(catalog->rewardOf(0), 0u);
+    EXPECT_EQ(catalog->rewardOf(1), 1u);
+    EXPECT_EQ(catalog->rewardOf(2), 0u);
+    EXPECT_EQ(catalog->rewardName(1), "Reward 2");
+    EXPECT_EQ(catalog->findReward("Reward 1"), 0u);
+    EXPECT_FALSE(catalog->findReward("Reward 3"));
+
+    // Packs number them the same way
+    const auto pack = LevelCatalog::parsePack(catalog->toPack(), error);
+    ASSERT_TRUE(pack) << error;
+    EXPECT_EQ(pack->rewardOf(2), 0u);
+    EXPECT_EQ(pack->rewardName(1), "Reward 2");
+}
+
+class LevelCatalogFileTest : public TestSupport::TempDirectoryTest {
+protected:
+    GameEngine engine_;
+};
+
+TEST_F(LevelCatalogFileTest, EngineLoadsCatalogAndRulesById) {
+    ASSERT_TRUE(engine_.loadCatalog(write("levels.catalog",
+        catalogLevel(20, "contains(\"twenty\")") + catalogLevel(10, "contains(\"ten\")"))));
+
+    ASSERT_EQ(engine_.getLevelCount(), 2u);
+    EXPECT_EQ(engine_.getLevel(0).getId(), 10u);
+    EXPECT_EQ(engine_.getLevel(1).getTitle(), "Title 20");
+    ASSERT_NE(engine_.findLevel(20), nullptr);
+    EXPECT_TRUE(engine_.findLevel(20)->validateSolution("twenty"));
+    EXPECT_FALSE(engine_.findLevel(20)->validateSolution("ten"));
+    EXPECT_EQ(engine_.findLevel(1), nullptr);
+
+    // "levelN" in a rules file is the level with id N
+    ASSERT_TRUE(engine_.loadValidationRules(write("rules.txt", "level20 = contains(\"XX\")\n")));
+    EXPECT_TRUE(engine_.findLevel(20)->validateSolution("XX"));
+    EXPECT_TRUE(engine_.findLevel(10)->validateSolution("ten"));
+}
+
+TEST_F(LevelCatalogFileTest, EditingLevelsLeavesOtherEnginesAlone) {
+    GameEngine other(InputReader::standardInput(), Renderer::standardOutput(), engine_.getLevels());
+    const auto shared = engine_.getLevels();
+
+    ASSERT_TRUE(engine_.loadValidationRules(write("rules.txt", "level1 = contains(\"XX\")\n")));
+    EXPECT_NE(engine_.getLevels(), shared);
+    EXPECT_TRUE(engine_.findLevel(1)->validateSolution("XX"));
+    EXPECT_FALSE(other.findLevel(1)->validateSolution("XX"));
+    EXPECT_EQ(other.getLevels(), shared);
+
+    // The copy still views the same catalog text
+    EXPECT_EQ(engine_.getLevel(1).getStory().data(), other.getLevel(1).getStory().data());
+}
+
+TEST_F(LevelCatalogFileTest, LoadsPacksByMappingThem) {
+    const std::string file = path("levels.pack");
+    {
+        std::ofstream out(file, std::ios::binary);
+        const std::string pack = LevelCatalog::builtin().toPack();
+        out.write(pack.data(), static_cast<std::streamsize>(pack.size()));
+    }
+
+    const auto pack = LevelCatalog::load(file);
+    ASSERT_TRUE(pack);
+    expectSameLevels(*pack, LevelCatalog::builtin());
+
+    // Engines share the mapping rather than copying the text
+    ASSERT_TRUE(engine_.loadCatalog(file));
+    GameEngine second;
+    ASSERT_TRUE(second.loadCatalog(file));
+    EXPECT_EQ(engine_.getLevel(2).getTitle(), "The Smart Pointer Forge");
+    EXPECT_TRUE(second.findLevel(1)->validateSolution("auto f = [](auto x) { return x; };"));
+    EXPECT_EQ(engine_.getCatalog()[0].solution.data(), engine_.getLevel(0).getSolutionText().data());
+}
+
+TEST_F(LevelCatalogFileTest, BadCatalogKeepsTheCurrentLevels) {
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(engine_.loadCatalog(write("broken.catalog", catalogLevel(1, "all(contains(\"a\""))));
+    EXPECT_FALSE(engine_.loadCatalog(path("missing.catalog")));
+    const std::string message = testing::internal::GetCapturedStderr();
+    EXPECT_NE(message.find("level 1 rule"), std::string::npos) << message;
+
+    ASSERT_EQ(engine_.getLevelCount(), 5u);
+    EXPECT_EQ(engine_.getLevel(0).getTitle(), "The Temple of Auto");
+}
+
+} // namespace CppCodeQuestTests
@@ -0,0 +1,146 @@
+/**
+ * C++ Code Quest - Renderer Tests
+ *
+ * Frame batching, number formatting and timer-driven pacing.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Renderer.hpp"
+
+namespace CppCodeQuestTests {
+
+using namespace std::chrono_literals;
+
+// Records every frame the renderer emits and every wait it asks for
+struct RecordingTerminal {
+    std::vector<std::string> frames;
+    std::vector<Renderer::Clock::time_point> waits;
+
+    Renderer renderer() {
+        return Renderer([this](std::string_view frame) { frames.emplace_back(frame); },
+                        [this](Renderer::Clock::time_point deadline) { waits.push_back(deadline); });
+    }
+};
+
+// ============================================================================
+// Composition
+// ============================================================================
+
+TEST(RendererTest, ComposesAFrameAndWritesItOnce) {
+    RecordingTerminal terminal;
+    Renderer out = terminal.renderer();
+
+    out << "\n";
+    out.rule(3, "═") << "📖 " << std::string("Title") << " " << std::string_view("v") << '!' << "\n";
+    out.rule(2, "-");
+    EXPECT_TRUE(terminal.frames.empty());
+
+    out.present();
+    ASSERT_EQ(terminal.frames.size(), 1u);
+    EXPECT_EQ(terminal.frames[0], "\n═══\n📖 Title v!\n--\n");
+    EXPECT_EQ(out.writeCalls(), 1u);
+
+    out.present();      // nothing new, nothing written
+    EXPECT_EQ(out.writeCalls(), 1u);
+}
+
+TEST(RendererTest, FormatsNumbersLikeOstream) {
+    RecordingTerminal terminal;
+    Renderer out = terminal.renderer();
+    std::ostringstream expected;
+
+    const double percentages[] = {0.0, 20.0, 100.0 / 3.0, 66.66666666};
+    for (double value : percentages) {
+        out << value << " ";
+        expected << value << " ";
+    }
+    out << -7 << " " << size_t{1024} << " " << 3u;
+    expected << -7 << " " << size_t{1024} << " " << 3u;
+    out.present();
+    ASSERT_EQ(terminal.frames.size(), 1u);
+    EXPECT_EQ(terminal.frames[0], expected.str());
+}
+
+// ============================================================================
+// Pacing
+// ============================================================================
+
+TEST(RendererTest, PauseHoldsLaterFramesUntilTheDeadline) {
+    RecordingTerminal terminal;
+    Renderer out = terminal.renderer();
+
+    out << "story\n";
+    const auto before = Renderer::Clock::now();
+    out.pause(1h);
+    ASSERT_EQ(terminal.frames.size(), 1u);     // the paused frame itself shows at once
+
+    out << "concept\n";
+    out.present();
+    out << "challenge\n";
+    out.present();
+    EXPECT_EQ(terminal.frames.size(), 1u);
+    const auto deadline = out.nextDeadline();
+    EXPECT_GE(deadline, before + 1h);
+
+    out.pump(deadline - 1s);
+    EXPECT_EQ(terminal.frames.size(), 1u);
+    out.pump(deadline);
+    ASSERT_EQ(terminal.frames.size(), 2u);
+    EXPECT_EQ(terminal.frames[1], "concept\nchallenge\n");      // queued frames leave together
+    EXPECT_EQ(out.nextDeadline(), Renderer::Clock::time_point::max());
+    EXPECT_TRUE(terminal.waits.empty());
+}
+
+TEST(RendererTest, DrainWaitsThroughTheWaiterThenWritesEverything) {
+    RecordingTerminal terminal;
+    Renderer out = terminal.renderer();
+
+    out << "completed\n";
+    out.pause(1h);
+    out << "progress\n";
+    out.present();
+    out << "continue? ";
+    out.drain();
+
+    ASSERT_EQ(terminal.waits.size(), 1u);
+    ASSERT_EQ(terminal.frames.size(), 2u);
+    EXPECT_EQ(terminal.frames[1], "progress\ncontinue? ");
+
+    // The deadline is spent: the next frame is not held
+    out << "next\n";
+    out.present();
+    EXPECT_EQ(terminal.frames.size(), 3u);
+}
+
+TEST(RendererTest, FastForwardSkipsPauses) {
+    RecordingTerminal terminal;
+    Renderer out = terminal.renderer();
+    out.setPacing(false);
+
+    out << "story\n";
+    out.pause(1h);
+    out << "concept\n";
+    out.present();
+    out.drain();
+
+    EXPECT_EQ(terminal.frames.size(), 2u);
+    EXPECT_TRUE(terminal.waits.empty());
+    EXPECT_EQ(out.nextDeadline(), Renderer::Clock::time_point::max());
+}
+
+TEST(RendererTest, StreamSinkWritesFrames) {
+    std::ostringstream stream;
+    Renderer out(Renderer::toStream(stream));
+    out << "a" << 1;
+    out.pause(1h);
+    out << "b";
+    out.drain();        // no waiter: nothing to wait with
+    EXPECT_EQ(stream.str(), "a1b");
+    EXPECT_EQ(out.writeCalls(), 2u);
+}
+
+} // namespace CppCodeQuestTests
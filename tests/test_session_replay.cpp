@@ -0,0 +1,174 @@
+/**
+ * C++ Code Quest - Session Log and Replay Tests
+ *
+ * The session log format, recording a reader's input, and replaying a
+ * directory of logs through whole games.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GameEngine.hpp"
+#include "InputReader.hpp"
+#include "Renderer.hpp"
+#include "SessionLog.hpp"
+#include "SessionReplay.hpp"
+#include "StringUtils.hpp"
+#include "TempDirectoryTest.hpp"
+
+namespace CppCodeQuestTests {
+
+namespace fs = std::filesystem;
+using std::chrono::milliseconds;
+
+std::string winningTranscript();    // test_game_server.cpp
+
+// ============================================================================
+// Log format
+// ============================================================================
+
+TEST(SessionLogTest, RoundTripsPiecesByteForByte) {
+    SessionLog log;
+    log.append(milliseconds(0), "\n");
+    log.append(milliseconds(1250), "auto x = 1;\nDONE\n");
+    log.append(milliseconds(40), std::string("bin\0ary\r", 8));
+
+    const std::string text = log.serialize();
+    EXPECT_EQ(text.rfind("cq-session 1\n0 1\n\n\n1250 17\n", 0), 0u);
+
+    std::string error;
+    const auto parsed = SessionLog::parse(text, error);
+    ASSERT_TRUE(parsed) << error;
+    ASSERT_EQ(parsed->size(), 3u);
+    EXPECT_EQ((*parsed)[1].delayMillis, 1250u);
+    EXPECT_EQ((*parsed)[1].bytes, "auto x = 1;\nDONE\n");
+    EXPECT_EQ((*parsed)[2].bytes, std::string_view("bin\0ary\r", 8));
+    EXPECT_EQ(parsed->input(), log.input());
+    EXPECT_EQ(parsed->duration(), milliseconds(1290));
+}
+
+TEST(SessionLogTest, RejectsMalformedLogs) {
+    std::string error;
+    EXPECT_FALSE(SessionLog::parse("hello\n", error));
+    EXPECT_NE(error.find("not a session log"), std::string::npos);
+    EXPECT_FALSE(SessionLog::parse("cq-session 1\n0 5\nabc\n", error));
+    EXPECT_NE(error.find("piece 1: truncated"), std::string::npos) << error;
+    EXPECT_FALSE(SessionLog::parse("cq-session 1\n0 1\na\nx 1\nb\n", error));
+    EXPECT_NE(error.find("piece 2"), std::string::npos) << error;
+    EXPECT_TRUE(SessionLog::parse("cq-session 1\n", error));
+}
+
+TEST(SessionLogTest, SavesTheSerializedBytesUnchanged) {
+    const fs::path path = fs::temp_directory_path() / "cpp-code-quest-crlf.cqlog";
+    SessionLog log;
+    log.append(milliseconds(5), "y\r\n");
+    log.append(milliseconds(7), "auto x = 1;\nDONE\n");
+    ASSERT_TRUE(log.save(path.string()));
+
+    EXPECT_EQ(GameUtils::FileUtils::read_file(path.string()), log.serialize());
+    const auto loaded = SessionLog::load(path.string());
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->input(), "y\r\nauto x = 1;\nDONE\n");
+    fs::remove(path);
+}
+
+TEST(SessionLogTest, RecorderCapturesFedAndPulledInput) {
+    const fs::path path = fs::temp_directory_path() / "cpp-code-quest-recorder.cqlog";
+    {
+        InputReader fed{InputReader::Options()};
+        SessionRecorder recorder(fed, path.string());
+        fed.feed("y\n");
+        fed.feed("DONE\n");
+        EXPECT_EQ(recorder.log().size(), 2u);
+    }
+    const auto saved = SessionLog::load(path.string());
+    ASSERT_TRUE(saved);
+    EXPECT_EQ(saved->input(), "y\nDONE\n");
+
+    // A reader with a source is recorded as it pulls blocks
+    const std::string text = "first\nsecond\n";
+    InputReader pulled(InputReader::fromText(text));
+    std::string line;
+    {
+        SessionRecorder recorder(pulled, path.string());
+        ASSERT_TRUE(pulled.readLine(line));
+        EXPECT_EQ(recorder.log().input(), text);
+    }
+    ASSERT_TRUE(pulled.readLine(line));     // no longer tapped
+    EXPECT_EQ(line, "second");
+    fs::remove(path);
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+class SessionReplayTest : public TestSupport::TempDirectoryTest {
+protected:
+    // Plays `transcript` on a recording engine, as a live session would
+    void record(const std::string& name, const std::string& transcript) {
+        std::istringstream in(transcript);
+        std::ostringstream out;
+        InputReader input(InputReader::fromStream(in));
+        Renderer output(Renderer::toStream(out));
+        output.setPacing(false);
+        GameEngine engine(input, output);
+        engine.recordInput(path(name));
+        engine.run();
+    }
+};
+
+TEST_F(SessionReplayTest, ReplaysRecordedGamesDeterministically) {
+    record("won-1.cqlog", winningTranscript());
+    record("won-2.cqlog", winningTranscript());
+    record("quit.cqlog", "\nauto x = 1;\nDONE\nn\n");
+    write("notes.txt", "not a log\n");
+
+    SessionReplay::Options options;
+    options.directory = dir_.string();
+    options.threads = 2;
+    std::ostringstream report;
+    const GameEngine engine;
+    const auto summary = SessionReplay(engine.getLevels()).run(options, report);
+
+    ASSERT_TRUE(summary);
+    EXPECT_EQ(summary->sessions, 4u);
+    EXPECT_EQ(summary->completed, 2u);
+    EXPECT_EQ(summary->stopped, 1u);
+    EXPECT_EQ(summary->errors, 1u);
+    EXPECT_EQ(summary->threads, 2u);
+    EXPECT_EQ(report.str().rfind("file,status,levels,input_bytes,output_bytes,output_hash,micros,error\n", 0), 0u);
+
+    const auto rows = TestSupport::sortedRows(report.str(), true);
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[0].rfind("notes.txt,error,0,", 0), 0u);
+    EXPECT_NE(rows[0].find("not a session log"), std::string::npos);
+    EXPECT_EQ(rows[1].rfind("quit.cqlog,stopped,1,20,", 0), 0u);
+    EXPECT_EQ(rows[2].rfind("won-1.cqlog,complete,5,", 0), 0u);
+
+    // Identical play prints identical output: same sizes and hash
+    auto outputColumns = [](const std::string& row) {
+        const auto fields = StringUtils::split(row, ',');
+        return fields[3] + "," + fields[4] + "," + fields[5];
+    };
+    EXPECT_EQ(outputColumns(rows[2]), outputColumns(rows[3]));
+    EXPECT_NE(outputColumns(rows[1]), outputColumns(rows[2]));
+}
+
+TEST_F(SessionReplayTest, ParsesOptions) {
+    const auto options = SessionReplay::parseOptions({"logs", "--threads", "4", "--output", "r.csv"});
+    ASSERT_TRUE(options);
+    EXPECT_EQ(options->directory, "logs");
+    EXPECT_EQ(options->threads, 4u);
+    EXPECT_EQ(options->outputPath, "r.csv");
+
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(SessionReplay::parseOptions({}));
+    EXPECT_FALSE(SessionReplay::parseOptions({"logs", "--threads", "0"}));
+    testing::internal::GetCapturedStderr();
+}
+
+} // namespace CppCodeQuestTests
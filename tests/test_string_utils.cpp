@@ -0,0 +1,522 @@
+/**
+ * C++ Code Quest - StringUtils Tests
+ *
+ * Unit tests for the string helpers the level validators are built on.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+#include "StringUtils.hpp"
+#include "MultiPatternMatcher.hpp"
+#include "MultiReplacer.hpp"
+#include "SimdSearch.hpp"
+#include "CppKeywords.hpp"
+#include "BraceBalance.hpp"
+#include "AllocationCounter.hpp"
+
+namespace CppCodeQuestTests {
+
+// ==========================================
+// Multi-pattern matching
+// ==========================================
+
+TEST(MultiPatternMatcher, ContainsAllAndAny) {
+    MultiPatternMatcher matcher({"auto", "lambda", "[]"});
+
+    EXPECT_TRUE(matcher.containsAll("auto lambda = [](auto x) { return x; };"));
+    EXPECT_FALSE(matcher.containsAll("auto x = 42;"));
+    EXPECT_TRUE(matcher.containsAny("auto x = 42;"));
+    EXPECT_FALSE(matcher.containsAny("int x = 42;"));
+}
+
+TEST(MultiPatternMatcher, OverlappingAndDuplicatePatterns) {
+    MultiPatternMatcher matcher({"he", "she", "his", "hers", "she"});
+
+    EXPECT_EQ(matcher.patternCount(), 5);
+    EXPECT_EQ(matcher.findMatched("ushers"), (std::vector<std::size_t>{0, 1, 3, 4}));
+    EXPECT_TRUE(matcher.containsAll("ushers this"));
+}
+
+TEST(MultiPatternMatcher, EmptyPatternsMatchLikeFind) {
+    EXPECT_TRUE(MultiPatternMatcher({""}).containsAll(""));
+    EXPECT_TRUE(MultiPatternMatcher({"", "x"}).containsAny("abc"));
+    EXPECT_FALSE(MultiPatternMatcher({"", "x"}).containsAll("abc"));
+    EXPECT_TRUE(MultiPatternMatcher().containsAll("anything"));
+    EXPECT_FALSE(MultiPatternMatcher().containsAny("anything"));
+}
+
+TEST(MultiPatternMatcher, AgreesWithFindLoop) {
+    const std::vector<std::string> needles = {"std::forward", "&&", "template", "<typename", "zz"};
+    const std::string code = "template<typename T>\nauto wrap(T&& arg) { return std::forward<T>(arg); }\n";
+    MultiPatternMatcher matcher(needles);
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < needles.size(); ++i) {
+        if (code.find(needles[i]) != std::string::npos) {
+            expected.push_back(i);
+        }
+    }
+
+    EXPECT_EQ(matcher.findMatched(code), expected);
+    EXPECT_TRUE(StringUtils::containsAll(code, {"std::forward", "&&"}));
+    EXPECT_FALSE(StringUtils::containsAll(code, needles));
+    EXPECT_TRUE(StringUtils::containsAny(code, {"zz", "template"}));
+}
+
+TEST(MultiPatternMatcher, RandomizedAgainstFind) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> letter(0, 3);
+    std::uniform_int_distribution<int> length(1, 4);
+    auto randomString = [&](int size) {
+        std::string out;
+        for (int i = 0; i < size; ++i) {
+            out += static_cast<char>('a' + letter(rng));
+        }
+        return out;
+    };
+
+    for (int round = 0; round < 200; ++round) {
+        std::vector<std::string> needles;
+        for (int i = 0; i < 1 + round % 6; ++i) {
+            needles.push_back(randomString(length(rng)));
+        }
+        const std::string text = randomString(round);
+        MultiPatternMatcher matcher(needles);
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < needles.size(); ++i) {
+            if (text.find(needles[i]) != std::string::npos) {
+                expected.push_back(i);
+            }
+        }
+
+        ASSERT_EQ(matcher.findMatched(text), expected) << "text: " << text;
+        ASSERT_EQ(matcher.containsAll(text), expected.size() == needles.size());
+        ASSERT_EQ(matcher.containsAny(text), !expected.empty());
+    }
+}
+
+// ==========================================
+// C++ keyword extraction
+// ==========================================
+
+TEST(KeywordExtraction, ReportsWholeWordsInTableOrder) {
+    const std::string code = "template<typename T>\nauto f(T&& x) { return std::forward<T>(x); }";
+
+    const std::vector<std::string> expected = {
+        "auto", "return", "template", "typename", "std", "forward"
+    };
+    EXPECT_EQ(StringUtils::extractCppKeywords(code), expected);
+}
+
+TEST(KeywordExtraction, AgreesWithWordBoundaryRegex) {
+    // Substrings of identifiers, digits glued to words and non-ASCII bytes
+    // must not create keyword hits, exactly like "\\bkeyword\\b"
+    const std::string code = "int autoValue = 1; int x2for; caf\xc3\xa9new; _if; (const)";
+    const auto found = StringUtils::extractCppKeywords(code);
+
+    for (const std::string keyword : {"int", "auto", "for", "new", "if", "const"}) {
+        const bool extracted = std::find(found.begin(), found.end(), keyword) != found.end();
+        EXPECT_EQ(extracted, StringUtils::containsCppKeyword(code, keyword)) << keyword;
+    }
+    EXPECT_TRUE(StringUtils::extractCppKeywords("").empty());
+}
+
+TEST(KeywordExtraction, PerfectHashFindsEveryKeywordAndNothingElse) {
+    for (std::size_t i = 0; i < CppKeywords::kCount; ++i) {
+        const std::string_view word = CppKeywords::kWords[i];
+        EXPECT_EQ(CppKeywords::indexOf(word), static_cast<int>(i)) << word;
+        EXPECT_FALSE(StringUtils::isValidCppIdentifier(std::string(word))) << word;
+
+        // Near misses: same length and extended
+        std::string altered(word);
+        altered.back() = altered.back() == 'x' ? 'y' : 'x';
+        EXPECT_FALSE(CppKeywords::contains(altered)) << altered;
+        EXPECT_TRUE(StringUtils::isValidCppIdentifier(std::string(word) + "_"));
+    }
+
+    EXPECT_FALSE(StringUtils::isValidCppIdentifier(""));
+    EXPECT_FALSE(StringUtils::isValidCppIdentifier("2fast"));
+    EXPECT_TRUE(StringUtils::isValidCppIdentifier("_quest_level"));
+}
+
+// ==========================================
+// Vectorized substring search
+// ==========================================
+
+TEST(SimdSearch, EveryKernelAgreesWithStringViewFind) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter(0, 2);
+    auto randomString = [&](std::size_t size) {
+        std::string out;
+        for (std::size_t i = 0; i < size; ++i) {
+            out += static_cast<char>('x' + letter(rng));
+        }
+        return out;
+    };
+
+    for (auto level : {SimdSearch::Level::Scalar, SimdSearch::Level::SSE2, SimdSearch::Level::AVX2}) {
+        if (!SimdSearch::setLevel(level)) {
+            continue;
+        }
+
+        for (std::size_t size = 0; size < 100; ++size) {
+            const std::string haystack = randomString(size);
+            for (std::size_t length = 0; length < 6; ++length) {
+                const std::string needle = randomString(length);
+                for (std::size_t pos : {std::size_t{0}, size / 3, size, size + 1}) {
+                    ASSERT_EQ(SimdSearch::find(haystack, needle, pos),
+                              std::string_view(haystack).find(needle, pos))
+                        << SimdSearch::levelName(level) << " haystack=" << haystack << " needle=" << needle;
+                }
+            }
+            ASSERT_EQ(SimdSearch::findByte(haystack, 'z', size / 2), haystack.find('z', size / 2));
+        }
+    }
+
+    SimdSearch::setLevel(SimdSearch::bestSupportedLevel());
+}
+
+TEST(SimdSearch, StringUtilsHelpersKeepTheirSemantics) {
+    EXPECT_EQ(StringUtils::split("a,b,,c,", ','), (std::vector<std::string>{"a", "b", "", "c"}));
+    EXPECT_EQ(StringUtils::split(",a", ','), (std::vector<std::string>{"", "a"}));
+    EXPECT_TRUE(StringUtils::split("", ',').empty());
+    EXPECT_EQ(StringUtils::split("a::b::", "::"), (std::vector<std::string>{"a", "b", ""}));
+
+    EXPECT_EQ(StringUtils::countOccurrences("aaaa", "aa"), 2);
+    EXPECT_EQ(StringUtils::replaceAll("a.b.c", ".", "::"), "a::b::c");
+    EXPECT_TRUE(StringUtils::contains("std::make_unique<int>", "make_unique"));
+    EXPECT_FALSE(StringUtils::contains("std::make_shared", "make_unique"));
+}
+
+TEST(SimdSearch, CaseFoldingKernelsMatchCLocale) {
+    // Every byte value, repeated so each kernel's vector loop and tail both run
+    std::string allBytes;
+    for (int round = 0; round < 3; ++round) {
+        for (int byte = 0; byte < 256; ++byte) {
+            allBytes += static_cast<char>(byte);
+        }
+    }
+
+    std::string expectedLower = allBytes;
+    std::string expectedUpper = allBytes;
+    for (auto& c : expectedLower) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c + 32);
+    }
+    for (auto& c : expectedUpper) {
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 32);
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> letter(0, 3);
+    auto randomMixedCase = [&](std::size_t size) {
+        static const char alphabet[] = {'a', 'B', '\xC3', ':'};
+        std::string out;
+        for (std::size_t i = 0; i < size; ++i) {
+            out += alphabet[letter(rng)];
+        }
+        return out;
+    };
+    auto referenceFind = [](std::string haystack, std::string needle, std::size_t pos) {
+        for (auto* text : {&haystack, &needle}) {
+            for (auto& c : *text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return haystack.find(needle, pos);
+    };
+
+    for (auto level : {SimdSearch::Level::Scalar, SimdSearch::Level::SSE2, SimdSearch::Level::AVX2}) {
+        if (!SimdSearch::setLevel(level)) {
+            continue;
+        }
+
+        for (std::size_t offset : {std::size_t{0}, std::size_t{5}}) {
+            std::string lower = allBytes.substr(offset);
+            std::string upper = allBytes.substr(offset);
+            SimdSearch::toLower(lower.data(), lower.size());
+            SimdSearch::toUpper(upper.data(), upper.size());
+            ASSERT_EQ(lower, expectedLower.substr(offset)) << SimdSearch::levelName(level);
+            ASSERT_EQ(upper, expectedUpper.substr(offset)) << SimdSearch::levelName(level);
+        }
+
+        for (std::size_t size = 0; size < 80; ++size) {
+            const std::string haystack = randomMixedCase(size);
+            for (std::size_t length = 0; length < 5; ++length) {
+                const std::string needle = randomMixedCase(length);
+                for (std::size_t pos : {std::size_t{0}, size / 2, size + 1}) {
+                    ASSERT_EQ(SimdSearch::findIgnoreCase(haystack, needle, pos), referenceFind(haystack, needle, pos))
+                        << SimdSearch::levelName(level) << " haystack=" << haystack << " needle=" << needle;
+                }
+            }
+        }
+    }
+
+    SimdSearch::setLevel(SimdSearch::bestSupportedLevel());
+}
+
+TEST(SimdSearch, CaseInsensitiveHelpersDoNotAllocate) {
+    const std::string hint = std::string(200, '.') + "Use STD::Make_Unique to own the Resource" + std::string(200, '.');
+    std::string scratch = hint;
+    volatile bool sink = false;
+
+    const std::size_t allocations = TestSupport::countAllocations([&] {
+        sink = StringUtils::containsIgnoreCase(hint, "std::make_unique");
+        sink = StringUtils::containsIgnoreCase(hint, "RESOURCE");
+        sink = StringUtils::findIgnoreCase(hint, "own THE") == std::string_view::npos;
+        StringUtils::toLowerCaseInPlace(scratch);
+        StringUtils::toUpperCaseInPlace(scratch);
+    });
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_TRUE(StringUtils::containsIgnoreCase(hint, "std::make_unique"));
+    EXPECT_FALSE(StringUtils::containsIgnoreCase(hint, "make_shared"));
+    EXPECT_EQ(scratch, StringUtils::toUpperCase(hint));
+    EXPECT_EQ(StringUtils::toLowerCase("Level 3: SMART Pointers"), "level 3: smart pointers");
+}
+
+// ==========================================
+// string_view API
+// ==========================================
+
+TEST(StringViewApi, ViewsPointIntoTheSource) {
+    const std::string line = "  key = value  \n";
+    const std::string_view trimmed = StringUtils::trimView(line);
+
+    EXPECT_EQ(trimmed, "key = value");
+    EXPECT_EQ(trimmed.data(), line.data() + 2);
+    EXPECT_TRUE(StringUtils::trimView(" \t\n").empty());
+
+    const auto fields = StringUtils::splitView(std::string_view("a,b,,c,"), ',');
+    ASSERT_EQ(fields.size(), 4u);
+    EXPECT_EQ(fields[3], "c");
+    EXPECT_EQ(StringUtils::splitView("a::b", "::"), (std::vector<std::string_view>{"a", "b"}));
+    EXPECT_EQ(StringUtils::splitView("abc", ""), (std::vector<std::string_view>{"abc"}));
+
+    EXPECT_TRUE(StringUtils::startsWith("std::make_unique", "std::"));
+    EXPECT_FALSE(StringUtils::startsWith("st", "std::"));
+    EXPECT_TRUE(StringUtils::endsWith("main.cpp", ".cpp"));
+    EXPECT_FALSE(StringUtils::endsWith("main.hpp", ".cpp"));
+    EXPECT_EQ(StringUtils::find("auto [a, b] = p;", "] ="), 10u);
+}
+
+TEST(StringViewApi, AllocationCountsBeforeAndAfter) {
+    const std::string code(256, ' ');
+    const std::string submission = code + "auto [number, text] = pair; if constexpr (true) {}" + code;
+    const MultiPatternMatcher bindings({"auto [", "] ="});
+    volatile bool sink = false;
+
+    // The std::string API copies: trim allocates for any result past SSO,
+    // split allocates the vector plus every long token
+    const std::size_t trimCopies = TestSupport::countAllocations([&] {
+        sink = StringUtils::trim(submission).empty();
+    });
+    const std::size_t splitCopies = TestSupport::countAllocations([&] {
+        sink = StringUtils::split(submission, ';').empty();
+    });
+    EXPECT_GE(trimCopies, 1u);
+    EXPECT_GE(splitCopies, 3u);
+
+    // The view API and the validator predicates do not allocate at all
+    const std::size_t viewAllocations = TestSupport::countAllocations([&] {
+        sink = StringUtils::trimView(submission).empty();
+        sink = StringUtils::startsWith(submission, "  ");
+        sink = StringUtils::endsWith(submission, "  ");
+        sink = StringUtils::find(submission, "if constexpr") == std::string_view::npos;
+    });
+    const std::size_t validatorAllocations = TestSupport::countAllocations([&] {
+        sink = StringUtils::containsAll(submission, bindings);
+        sink = StringUtils::contains(submission, "if constexpr");
+        sink = StringUtils::containsAll(submission, {"auto", "lambda", "[]"});
+        sink = StringUtils::containsAny(submission, {"std::forward", "&&"});
+    });
+    EXPECT_EQ(viewAllocations, 0u);
+    EXPECT_EQ(validatorAllocations, 0u);
+
+    // splitView allocates only its result vector, never the tokens
+    const std::size_t splitViewAllocations = TestSupport::countAllocations([&] {
+        auto tokens = StringUtils::splitView(submission, ';');
+        sink = tokens.empty();
+    });
+    EXPECT_LT(splitViewAllocations, splitCopies);
+
+    std::cout << "  allocations: trim=" << trimCopies << " split=" << splitCopies
+              << " splitView=" << splitViewAllocations << " view API=" << viewAllocations
+              << " validators=" << validatorAllocations << "\n";
+}
+
+// ==========================================
+// Lazy split range
+// ==========================================
+
+TEST(SplitRange, MatchesEagerSplit) {
+    for (const std::string input : {"", ",", "a", "a,b,,c,", ",a,", "a,,"}) {
+        const auto lazy = StringUtils::splitLazy(input, ',');
+        EXPECT_EQ(std::vector<std::string>(lazy.begin(), lazy.end()), StringUtils::split(input, ','))
+            << "input: '" << input << "'";
+    }
+    for (const std::string input : {"", "::", "a", "a::b::::c::", "::a"}) {
+        const auto lazy = StringUtils::splitLazy(input, "::");
+        EXPECT_EQ(std::vector<std::string>(lazy.begin(), lazy.end()), StringUtils::split(input, "::"))
+            << "input: '" << input << "'";
+    }
+}
+
+TEST(SplitRange, EarlyTerminationWithoutAllocation) {
+    std::string log;
+    for (int i = 0; i < 20000; ++i) {
+        log += "field_a,field_b,field_c\n";
+    }
+
+    std::size_t lines = 0;
+    std::size_t fields = 0;
+    std::string_view firstField;
+    const std::size_t allocations = TestSupport::countAllocations([&] {
+        for (std::string_view line : StringUtils::splitLazy(log, '\n')) {
+            ++lines;
+            for (std::string_view field : StringUtils::splitLazy(line, ',')) {
+                ++fields;
+                firstField = field;
+                break;
+            }
+        }
+    });
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(lines, 20000u);
+    EXPECT_EQ(fields, 20000u);
+    EXPECT_EQ(firstField, "field_a");
+    EXPECT_EQ(firstField.data(), log.data() + log.size() - 24);
+}
+
+// ==========================================
+// Bracket balance
+// ==========================================
+
+TEST(BraceBalance, ReportsTheFirstImbalance) {
+    EXPECT_TRUE(BraceBalanceChecker::check("int main() { return v[0]; }").balanced);
+    EXPECT_TRUE(BraceBalanceChecker::check("").balanced);
+
+    // Counters are independent, as they always were
+    EXPECT_TRUE(StringUtils::hasBalancedBraces("([)]"));
+
+    // A stray closer fails where it appears
+    const auto closer = BraceBalanceChecker::check("f(a)) { }");
+    EXPECT_FALSE(closer.balanced);
+    EXPECT_EQ(closer.offset, 4u);
+    EXPECT_EQ(closer.bracket, ')');
+
+    // An unclosed opener fails at the outermost one still open
+    const auto opener = BraceBalanceChecker::check("{ ok(); }\nvoid g() { if (x) { y[1]; }\n");
+    EXPECT_FALSE(opener.balanced);
+    EXPECT_EQ(opener.offset, 19u);
+    EXPECT_EQ(opener.bracket, '{');
+    EXPECT_EQ(StringUtils::findBraceImbalance("a[ (b) { }"), 1u);
+    EXPECT_EQ(StringUtils::findBraceImbalance("a[]"), BraceBalanceChecker::npos);
+}
+
+TEST(BraceBalance, EveryKernelAndChunkingAgree) {
+    // The original per-byte switch, kept as the reference
+    auto reference = [](const std::string& code) {
+        int brace = 0, paren = 0, bracket = 0;
+        for (char c : code) {
+            switch (c) {
+                case '{': brace++; break;
+                case '}': brace--; break;
+                case '(': paren++; break;
+                case ')': paren--; break;
+                case '[': bracket++; break;
+                case ']': bracket--; break;
+            }
+            if (brace < 0 || paren < 0 || bracket < 0) return false;
+        }
+        return brace == 0 && paren == 0 && bracket == 0;
+    };
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, 9);
+    const char alphabet[] = "{}()[]xx x";
+
+    for (auto level : {SimdSearch::Level::Scalar, SimdSearch::Level::SSE2, SimdSearch::Level::AVX2}) {
+        if (!SimdSearch::setLevel(level)) {
+            continue;
+        }
+
+        for (int round = 0; round < 400; ++round) {
+            std::string code;
+            const int length = round % 120;
+            for (int i = 0; i < length; ++i) {
+                code += alphabet[pick(rng)];
+            }
+            // Balanced stretches so that some inputs pass
+            if (round % 2 == 0) {
+                code = "{(" + std::string(static_cast<size_t>(round % 50), 'a') + ")}";
+            }
+
+            const auto whole = BraceBalanceChecker::check(code);
+            ASSERT_EQ(whole.balanced, reference(code)) << SimdSearch::levelName(level) << " " << code;
+
+            BraceBalanceChecker streamed;
+            for (size_t start = 0; start < code.size(); start += 7) {
+                streamed.feed(std::string_view(code).substr(start, 7));
+            }
+            const auto chunked = streamed.finish();
+            ASSERT_EQ(chunked.balanced, whole.balanced);
+            ASSERT_EQ(chunked.offset, whole.offset) << code;
+            ASSERT_EQ(chunked.bracket, whole.bracket);
+        }
+    }
+
+    SimdSearch::setLevel(SimdSearch::bestSupportedLevel());
+}
+
+// ==========================================
+// Multi-rule replacement
+// ==========================================
+
+TEST(MultiReplacer, LeftmostMatchAndFirstRuleWins) {
+    const MultiReplacer replacer({{"ab", "X"}, {"abc", "Y"}, {"b", "Z"}, {"", "never"}});
+
+    EXPECT_EQ(replacer.apply("abcabc"), "XcXc");
+    EXPECT_EQ(replacer.apply("bab"), "ZX");
+    EXPECT_EQ(replacer.apply(""), "");
+    EXPECT_EQ(replacer.ruleCount(), 4u);
+
+    // Replacements are not rescanned, unlike chained replaceAll calls
+    EXPECT_EQ(StringUtils::replaceAll("a->b", {{"a", "b"}, {"b", "a"}}), "b->a");
+    EXPECT_EQ(StringUtils::replaceAll(StringUtils::replaceAll("a->b", "a", "b"), "b", "a"), "a->a");
+}
+
+TEST(MultiReplacer, ReplaceAllKeepsItsSemantics) {
+    EXPECT_EQ(StringUtils::replaceAll("aaaa", "aa", "a"), "aa");
+    EXPECT_EQ(StringUtils::replaceAll("aaa", "a", "aa"), "aaaaaa");
+    EXPECT_EQ(StringUtils::replaceAll("abc", "", "x"), "abc");
+    EXPECT_EQ(StringUtils::replaceAll("abc", "d", "x"), "abc");
+    EXPECT_EQ(StringUtils::replaceAll("x\r\ny\r\n", "\r\n", "\n"), "x\ny\n");
+
+    // Against the in-place replace loop replaceAll used to run
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> letter(0, 2);
+    auto randomString = [&](std::size_t size) {
+        std::string out;
+        for (std::size_t i = 0; i < size; ++i) {
+            out += static_cast<char>('a' + letter(rng));
+        }
+        return out;
+    };
+    for (int round = 0; round < 500; ++round) {
+        const std::string text = randomString(static_cast<std::size_t>(round % 60));
+        const std::string from = randomString(1 + static_cast<std::size_t>(round % 3));
+        const std::string to = randomString(static_cast<std::size_t>(round % 4));
+
+        std::string expected = text;
+        for (size_t pos = 0; (pos = expected.find(from, pos)) != std::string::npos; pos += to.size()) {
+            expected.replace(pos, from.size(), to);
+        }
+        ASSERT_EQ(StringUtils::replaceAll(text, from, to), expected) << text << " " << from << "->" << to;
+    }
+}
+
+} // namespace CppCodeQuestTests
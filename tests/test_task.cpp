@@ -0,0 +1,81 @@
+/**
+ * C++ Code Quest - Task Tests
+ *
+ * Lazy start, values and exceptions through awaits, and long synchronous
+ * chains.
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include "Task.hpp"
+
+namespace CppCodeQuestTests {
+
+namespace {
+
+Task<int> twice(int value, int& runs) {
+    ++runs;
+    co_return value * 2;
+}
+
+Task<std::string> describe(int value, int& runs) {
+    const int doubled = co_await twice(value, runs);
+    co_return std::to_string(doubled);
+}
+
+Task<int> fail() {
+    throw std::runtime_error("no input");
+    co_return 0;
+}
+
+Task<int> recover() {
+    try {
+        co_return co_await fail();
+    } catch (const std::runtime_error&) {
+        co_return -1;
+    }
+}
+
+Task<size_t> countDown(size_t n) {
+    if (n == 0) {
+        co_return 0;
+    }
+    const size_t rest = co_await countDown(n - 1);
+    co_return rest + 1;
+}
+
+} // namespace
+
+TEST(TaskTest, RunsOnlyWhenStartedAndReturnsItsValue) {
+    int runs = 0;
+    auto task = describe(21, runs);
+    EXPECT_EQ(runs, 0);
+    EXPECT_FALSE(task.done());
+
+    task.start();
+    EXPECT_TRUE(task.done());
+    EXPECT_EQ(runs, 1);
+    EXPECT_EQ(task.result(), "42");
+}
+
+TEST(TaskTest, ExceptionsReachTheAwaiterAndTheDriver) {
+    auto recovered = recover();
+    recovered.start();
+    EXPECT_EQ(recovered.result(), -1);
+
+    auto failed = fail();
+    failed.start();
+    ASSERT_TRUE(failed.done());
+    EXPECT_THROW(failed.result(), std::runtime_error);
+}
+
+TEST(TaskTest, LongSynchronousChainsFinish) {
+    // Each level resumes the next by symmetric transfer
+    auto task = countDown(10000);
+    task.start();
+    ASSERT_TRUE(task.done());
+    EXPECT_EQ(task.result(), 10000u);
+}
+
+} // namespace CppCodeQuestTests
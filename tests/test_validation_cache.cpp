@@ -0,0 +1,263 @@
+/**
+ * C++ Code Quest - ValidationCache Tests
+ *
+ * Normalization, keying, CLOCK eviction, persistence and the cache's use by
+ * the game engine's levels.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include "GameEngine.hpp"
+#include "ValidationCache.hpp"
+#include "FileUtils.hpp"
+#include "StringUtils.hpp"
+
+namespace CppCodeQuestTests {
+
+namespace fs = std::filesystem;
+using GameUtils::FileUtils;
+
+std::string normalized(const std::string& code) {
+    std::string out;
+    ValidationCache::normalize(code, out);
+    return out;
+}
+
+// ============================================================================
+// Normalization and keys
+// ============================================================================
+
+TEST(ValidationCacheTest, NormalizesWhitespaceRuns) {
+    EXPECT_EQ(normalized("  auto   x =\t1;  \n\n  auto y = 2;\r\n"), "auto x = 1;\nauto y = 2;");
+    EXPECT_EQ(normalized("// note\n    int x;"), "// note\nint x;");
+    EXPECT_EQ(normalized(" \t\n "), "");
+    EXPECT_EQ(normalized("x"), "x");
+}
+
+TEST(ValidationCacheTest, NormalizesLongInputsLikeShortOnes) {
+    // Long enough for the block fast path, with runs straddling block edges
+    const std::string pieces[] = {"auto", " ", "x", "  ", "=", "\t", "std::make_unique<int>(1);", "\n    ", "\x01", " \r\n"};
+    std::string code;
+    unsigned seed = 7;
+    for (int i = 0; i < 400; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        code += pieces[(seed >> 16) % 10];
+    }
+    for (size_t start = 0; start < 20; ++start) {
+        const std::string input = code.substr(start);
+        std::string reference;
+        for (const auto& piece : StringUtils::splitLazy(input, '\n')) {
+            std::string line;
+            std::istringstream words{std::string(piece)};
+            for (std::string word; words >> word;) {
+                line += (line.empty() ? "" : " ") + word;
+            }
+            if (!line.empty()) {
+                reference += (reference.empty() ? "" : "\n") + line;
+            }
+        }
+        EXPECT_EQ(normalized(input), reference) << "offset " << start;
+    }
+}
+
+TEST(ValidationCacheTest, KeysSeparateLevelsAndContent) {
+    const auto level1 = ValidationCache::levelKey(0, "contains(\"auto\")");
+    const auto level2 = ValidationCache::levelKey(1, "contains(\"auto\")");
+    const auto edited = ValidationCache::levelKey(0, "contains(\"auto \")");
+    EXPECT_NE(level1, level2);
+    EXPECT_NE(level1, edited);
+
+    EXPECT_EQ(ValidationCache::keyFor(level1, "auto x = 1;"), ValidationCache::keyFor(level1, "auto x = 1;"));
+    EXPECT_FALSE(ValidationCache::keyFor(level1, "auto x = 1;") == ValidationCache::keyFor(level2, "auto x = 1;"));
+    EXPECT_FALSE(ValidationCache::keyFor(level1, "auto x = 1;") == ValidationCache::keyFor(level1, "auto x = 2;"));
+    EXPECT_FALSE(ValidationCache::keyFor(level1, "ab") == ValidationCache::keyFor(level1, std::string("ab\0", 3)));
+}
+
+// ============================================================================
+// Caching
+// ============================================================================
+
+TEST(ValidationCacheTest, CountsHitsAndMisses) {
+    ValidationCache cache(8);
+    int calls = 0;
+    auto validator = [&](std::string_view code) {
+        ++calls;
+        return code == "auto x = 1;";
+    };
+
+    EXPECT_TRUE(cache.validate(1, "auto x = 1;", validator));
+    EXPECT_TRUE(cache.validate(1, "  auto  x = 1;\n", validator));
+    EXPECT_FALSE(cache.validate(1, "int x = 1;", validator));
+    EXPECT_FALSE(cache.validate(2, "auto x = 1;", [](std::string_view) { return false; }));
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.entries, 3u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.25);
+}
+
+TEST(ValidationCacheTest, ClockEvictionSparesRecentlyHitEntries) {
+    ValidationCache cache(3);
+    const ValidationCache::Key a{1, 1}, b{2, 2}, c{3, 3}, d{4, 4};
+    cache.store(a, true);
+    cache.store(b, true);
+    cache.store(c, false);
+
+    ASSERT_TRUE(cache.lookup(a).has_value());   // a gets a second chance
+    cache.store(d, true);                       // evicts b
+
+    EXPECT_TRUE(cache.lookup(a).has_value());
+    EXPECT_FALSE(cache.lookup(b).has_value());
+    EXPECT_EQ(cache.lookup(c), std::optional<bool>(false));
+    EXPECT_EQ(cache.lookup(d), std::optional<bool>(true));
+    EXPECT_EQ(cache.stats().entries, 3u);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST(ValidationCacheTest, ZeroCapacityDisablesCaching) {
+    ValidationCache cache(0);
+    int calls = 0;
+    auto validator = [&](std::string_view) { return ++calls > 0; };
+    cache.validate(1, "x", validator);
+    cache.validate(1, "x", validator);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+class ValidationCacheFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (fs::temp_directory_path() / "cpp-code-quest-cache.bin").string();
+    }
+
+    void TearDown() override {
+        fs::remove(path_);
+    }
+
+    std::string path_;
+};
+
+TEST_F(ValidationCacheFileTest, SurvivesSaveAndLoad) {
+    ValidationCache original(16);
+    original.store({1, 2}, true);
+    original.store({3, 4}, false);
+    ASSERT_TRUE(original.save(path_));
+
+    ValidationCache restored(16);
+    ASSERT_TRUE(restored.load(path_));
+    EXPECT_EQ(restored.lookup({1, 2}), std::optional<bool>(true));
+    EXPECT_EQ(restored.lookup({3, 4}), std::optional<bool>(false));
+    EXPECT_FALSE(restored.lookup({5, 6}).has_value());
+
+    ValidationCache small(1);
+    ASSERT_TRUE(small.load(path_));
+    EXPECT_EQ(small.stats().entries, 1u);
+}
+
+TEST_F(ValidationCacheFileTest, KeysWithLineEndBytesRoundTrip) {
+    const ValidationCache::Key crlf{0x0a0d0a0d0a0d0a0dull, 0x0a0a0a0a0d0d0d0dull};
+    ValidationCache original(16);
+    original.store(crlf, true);
+    original.store({'\n', '\r'}, false);
+    ASSERT_TRUE(original.save(path_));
+
+    // 16 header bytes, then 17 per entry, with nothing added on the way out
+    const auto content = FileUtils::read_file(path_);
+    ASSERT_TRUE(content.has_value());
+    EXPECT_EQ(content->size(), 16u + 2u * 17u);
+
+    ValidationCache restored(16);
+    ASSERT_TRUE(restored.load(path_));
+    EXPECT_EQ(restored.lookup(crlf), std::optional<bool>(true));
+    EXPECT_EQ(restored.lookup({'\n', '\r'}), std::optional<bool>(false));
+}
+
+TEST_F(ValidationCacheFileTest, RejectsForeignFiles) {
+    ValidationCache cache;
+    testing::internal::CaptureStderr();
+    ASSERT_TRUE(FileUtils::write_file(path_, "level1 = contains(\"auto\")\n"));
+    EXPECT_FALSE(cache.load(path_));
+
+    ValidationCache source;
+    source.store({1, 2}, true);
+    ASSERT_TRUE(source.save(path_));
+    auto content = FileUtils::read_file(path_);
+    ASSERT_TRUE(content.has_value());
+    ASSERT_TRUE(FileUtils::write_file(path_, content->substr(0, content->size() - 1)));
+    EXPECT_FALSE(cache.load(path_));
+    testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+// ============================================================================
+// Engine integration
+// ============================================================================
+
+TEST_F(ValidationCacheFileTest, LevelsWithTokenRulesUseTheEngineCache) {
+    // The cache belongs to the levels, which every engine in the process
+    // shares, so only this test's lookups are counted
+    GameEngine engine;
+    const auto before = engine.getValidationCache().stats();
+    const std::string code = "auto [key, value] = *inventory.begin();";
+    EXPECT_TRUE(engine.getLevel(4).validateSolution(code));
+    EXPECT_EQ(engine.getValidationCache().stats().misses, before.misses);   // substring rules bypass it
+
+    ASSERT_TRUE(FileUtils::write_file(path_, "level5 = token(\"auto\", \"[\")\n"));
+    ASSERT_TRUE(engine.loadValidationRules(path_));
+    EXPECT_TRUE(engine.getLevel(4).validateSolution(code));
+    EXPECT_TRUE(engine.getLevel(4).validateSolution("  auto  [key,\tvalue] = *inventory.begin();\n"));
+    EXPECT_FALSE(engine.getLevel(4).validateSolution("// auto [key, value]"));
+
+    const auto stats = engine.getValidationCache().stats();
+    EXPECT_EQ(stats.hits - before.hits, 1u);
+    EXPECT_EQ(stats.misses - before.misses, 2u);
+}
+
+TEST_F(ValidationCacheFileTest, RuleOverridesDoNotSeeStaleResults) {
+    GameEngine engine;
+    const std::string code = "auto [key, value] = pair; // if constexpr";
+
+    ASSERT_TRUE(FileUtils::write_file(path_, "level5 = token(\"auto\", \"[\")\n"));
+    ASSERT_TRUE(engine.loadValidationRules(path_));
+    EXPECT_TRUE(engine.getLevel(4).validateSolution(code));
+
+    const auto before = engine.getValidationCache().stats();
+    ASSERT_TRUE(FileUtils::write_file(path_, "level5 = token(\"if\", \"constexpr\")\n"));
+    ASSERT_TRUE(engine.loadValidationRules(path_));
+    EXPECT_FALSE(engine.getLevel(4).validateSolution(code));
+    EXPECT_EQ(engine.getValidationCache().stats().hits, before.hits);
+}
+
+TEST_F(ValidationCacheFileTest, CachedVerdictsMatchTheRuleOnTheTypedCode) {
+    GameEngine engine;
+    ASSERT_TRUE(FileUtils::write_file(path_, "level5 = all(token(\"auto\"), contains(\"auto [\"))\n"));
+    ASSERT_TRUE(engine.loadValidationRules(path_));
+    const Level& level = engine.getLevel(4);
+    ASSERT_NE(level.getRule(), nullptr);
+    EXPECT_TRUE(level.getRule()->dependsOnWhitespace());
+
+    // A re-spaced variant of an accepted submission is judged on its own
+    const std::string accepted = "auto [a, b] = pair;";
+    const std::string spaced = "auto  [a, b] = pair;";
+    EXPECT_TRUE(level.validateSolution(accepted));
+    EXPECT_FALSE(level.validateSolution(spaced));
+    EXPECT_FALSE(level.validateSolution(spaced));
+    EXPECT_EQ(level.validateSolution(spaced), level.getRule()->matches(spaced));
+
+    // Without whitespace in its texts a rule still shares verdicts across re-spacing
+    std::string error;
+    const auto tokens = ValidationRule::parse("all(token(\"auto\", \"[\"), contains(\"[a,\"))", error);
+    ASSERT_TRUE(tokens) << error;
+    EXPECT_FALSE(tokens->dependsOnWhitespace());
+}
+
+} // namespace CppCodeQuestTests
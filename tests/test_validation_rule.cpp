@@ -0,0 +1,283 @@
+/**
+ * C++ Code Quest - ValidationRule Tests
+ *
+ * Parsing and evaluation of declarative level rules, and loading rule
+ * overrides into the game engine.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "GameEngine.hpp"
+#include "ValidationRule.hpp"
+#include "FileUtils.hpp"
+#include "StringUtils.hpp"
+
+namespace CppCodeQuestTests {
+
+namespace fs = std::filesystem;
+using GameUtils::FileUtils;
+
+ValidationRule compile(const std::string& source) {
+    std::string error;
+    auto rule = ValidationRule::parse(source, error);
+    EXPECT_TRUE(rule.has_value()) << source << ": " << error;
+    return rule ? std::move(*rule) : ValidationRule();
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+TEST(ValidationRuleTest, ParsesEveryForm) {
+    const auto rule = compile(R"(  all( contains("a"),
+                                      any(token("auto", "["), not(contains("b"))) ) )");
+    EXPECT_EQ(rule.source().find("all("), 2u);
+}
+
+TEST(ValidationRuleTest, ReportsErrorsWithOffset) {
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"", "expected all, any, not, contains or token at offset 0"},
+        {"contains(\"x\"", "expected ')' at offset 12"},
+        {"contains(x)", "expected a quoted string at offset 9"},
+        {"contains(\"\")", "contains() needs a non-empty string at offset 9"},
+        {"contains(\"abc)", "unterminated string at offset 9"},
+        {"contains(\"a\\n\")", "only \\\" and \\\\ escapes are supported at offset 12"},
+        {"not(contains(\"a\"), contains(\"b\"))", "expected ')' at offset 17"},
+        {"maybe(contains(\"a\"))", "expected all, any, not, contains or token at offset 0"},
+        {"contains(\"a\") extra", "unexpected text after rule at offset 14"},
+    };
+    for (const auto& [source, expected] : cases) {
+        std::string error;
+        EXPECT_FALSE(ValidationRule::parse(source, error).has_value()) << source;
+        EXPECT_EQ(error, expected) << source;
+    }
+}
+
+TEST(ValidationRuleTest, RejectsRunawayNesting) {
+    std::string source;
+    for (int i = 0; i < 100; ++i) {
+        source += "not(";
+    }
+    source += "contains(\"x\")" + std::string(100, ')');
+
+    std::string error;
+    EXPECT_FALSE(ValidationRule::parse(source, error).has_value());
+    EXPECT_NE(error.find("nested too deeply"), std::string::npos);
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+TEST(ValidationRuleTest, EvaluatesBooleanOperators) {
+    const auto rule = compile(R"(all(contains("std::"), any(contains("move"), contains("forward")), not(contains("new "))))");
+    EXPECT_TRUE(rule.matches("auto b = std::move(a);"));
+    EXPECT_TRUE(rule("return std::forward<T>(t);"));
+    EXPECT_FALSE(rule.matches("auto b = std::copy(a);"));
+    EXPECT_FALSE(rule.matches("auto* p = new int; std::move(p);"));
+}
+
+TEST(ValidationRuleTest, EscapedQuotesMatchLiterally) {
+    const auto rule = compile(R"(contains("\"quest\\"))");
+    EXPECT_TRUE(rule.matches(R"(auto s = "quest\n";)"));
+    EXPECT_FALSE(rule.matches("auto s = quest;"));
+}
+
+TEST(ValidationRuleTest, TokenSequencesIgnoreCommentsAndStrings) {
+    const auto rule = compile(R"(token("auto", "["))");
+    EXPECT_TRUE(rule.matches("auto [key, value] = *it;"));
+    EXPECT_TRUE(rule.matches("auto\n  [key, value] = *it;"));
+    EXPECT_FALSE(rule.matches("// auto [key, value] = *it;"));
+    EXPECT_FALSE(rule.matches("const char* s = \"auto [x]\";"));
+}
+
+TEST(ValidationRuleTest, DefaultRuleMatchesNothing) {
+    EXPECT_FALSE(ValidationRule().matches("anything"));
+}
+
+TEST(ValidationRuleTest, HandlesMoreThanSixtyFourNeedles) {
+    std::string source = "all(";
+    for (int i = 0; i < 80; ++i) {
+        source += (i ? ", " : "") + std::string("contains(\"w") + std::to_string(i) + "_\")";
+    }
+    source += ")";
+    const auto rule = compile(source);
+
+    std::string code;
+    for (int i = 0; i < 80; ++i) {
+        code += "w" + std::to_string(i) + "_ ";
+    }
+    EXPECT_TRUE(rule.matches(code));
+    EXPECT_FALSE(rule.matches(StringUtils::replaceAll(code, "w79_", "")));
+}
+
+// ============================================================================
+// Incremental sessions
+// ============================================================================
+
+TEST(ValidationRuleTest, SessionsAgreeWithWholeTextMatching) {
+    const std::vector<ValidationRule> rules = {
+        compile(R"(all(token("auto", "["), contains("make_pair")))"),
+        compile(R"(any(token("x", "=", "1"), not(token("std", "::", "move"))))"),
+        compile(R"(all(token("#include <memory>"), not(contains("/*"))))"),
+        compile(R"rule(token("R", "(", ")"))rule"),
+    };
+    const std::vector<std::string> codes = {
+        "auto [a, b] = std::make_pair(1, 2);\n",
+        "auto /* a comment\nacross lines [ */ [a, b]\n= make_pair(1, 2);",
+        "x\n=\n// note\n1\n",
+        "#include \\\n<memory>\n#include <memory>\nint main() {}\n",
+        "auto s = R\"x(\nstd::move(y)\n)x\"; std::move(z);\n",
+        "auto v = R(\n); std\n::\nmove",
+        "int x = 1; \\\n#define A\n/* open",
+    };
+
+    for (const auto& rule : rules) {
+        for (const auto& code : codes) {
+            for (size_t chunk : {size_t{1}, size_t{3}, size_t{7}, code.size()}) {
+                ValidationRule::Session session(rule);
+                std::string text;
+                for (size_t pos = 0; pos < code.size(); pos += chunk) {
+                    text += code.substr(pos, chunk);
+                    session.advance(text);
+                    ASSERT_EQ(session.matches(), rule.matches(text)) << rule.source() << " on " << text;
+                }
+            }
+        }
+    }
+}
+
+TEST(ValidationRuleTest, SessionsReportProgressLineByLine) {
+    const auto rule = compile(R"(any(all(contains("auto"), contains("lambda"), contains("[]")),
+                                     all(contains("auto"), token("int", "x"))))");
+    ValidationRule::Session session(rule);
+    EXPECT_EQ(session.progress().met, 0u);
+
+    std::string code = "auto f = 1;\n";
+    session.advance(code);
+    EXPECT_EQ(session.progress().met, 1u);
+    EXPECT_EQ(session.progress().total, 2u);     // the shorter branch leads
+
+    code += "auto lambda = [](int y) { return y; };\n";
+    session.advance(code);
+    EXPECT_EQ(session.progress().met, 3u);
+    EXPECT_EQ(session.progress().total, 3u);
+    EXPECT_TRUE(session.matches());
+}
+
+TEST(ValidationRuleTest, SessionsHandleManyNeedles) {
+    std::string source = "all(";
+    for (int i = 0; i < 20; ++i) {
+        source += (i ? ", " : "") + std::string("contains(\"needle") + std::to_string(i) + "_\")";
+    }
+    const auto rule = compile(source + ")");
+
+    ValidationRule::Session session(rule);
+    std::string code;
+    for (int i = 0; i < 20; ++i) {
+        // Split every needle across two calls
+        code += "need";
+        session.advance(code);
+        code += "le" + std::to_string(i) + "_\n";
+        session.advance(code);
+        EXPECT_EQ(session.progress().met, static_cast<size_t>(i + 1));
+    }
+    EXPECT_TRUE(session.matches());
+}
+
+// ============================================================================
+// Built-in levels and overrides
+// ============================================================================
+
+TEST(ValidationRuleTest, BuiltInLevelsKeepTheirBehavior) {
+    const GameEngine engine;
+    ASSERT_EQ(engine.getLevelCount(), 5u);
+
+    const std::vector<std::pair<std::string, std::vector<bool>>> samples = {
+        {"auto f = [](auto x) { return x; };", {true, false, false, false, false}},
+        {"auto p = std::make_unique<int>(1); auto f = [q = std::move(p)] {};", {true, true, true, false, false}},
+        {"template<class T> void f(T&& t) { g(std::forward<T>(t)); }", {false, false, false, true, false}},
+        {"auto [a, b] = pair;", {true, false, false, false, true}},
+        {"int* p = new int(42);", {false, false, false, false, false}},
+    };
+    for (const auto& [code, expected] : samples) {
+        for (size_t level = 0; level < expected.size(); ++level) {
+            EXPECT_EQ(engine.getLevel(level).validateSolution(code), expected[level])
+                << "level " << level + 1 << ": " << code;
+        }
+    }
+}
+
+TEST(ValidationRuleTest, LevelsCallRulesDirectlyAndFunctionsWithViews) {
+    const LevelCatalog::Entry& entry = LevelCatalog::builtin()[0];
+    Level level(entry, compile(R"(contains("auto"))"));
+    ASSERT_NE(level.getRule(), nullptr);
+    EXPECT_TRUE(level.validateSolution(std::string_view("auto x = 1;")));
+    EXPECT_TRUE(level.visitValidator([](const auto& validator) { return validator("auto y;"); }));
+
+    // A runtime validator sees the caller's characters, not a copy
+    const std::string code = "int x = 1;";
+    const char* seen = nullptr;
+    level.setValidator(Level::ValidationFunction([&seen](std::string_view text) {
+        seen = text.data();
+        return text.size() > 3;
+    }));
+    EXPECT_EQ(level.getRule(), nullptr);
+    EXPECT_TRUE(level.validateSolution(code));
+    EXPECT_EQ(seen, code.data());
+    EXPECT_FALSE(level.validateSolution("x"));
+
+    const bool isRule = level.visitValidator([](const auto& validator) {
+        return std::is_same_v<std::decay_t<decltype(validator)>, ValidationRule>;
+    });
+    EXPECT_FALSE(isRule);
+}
+
+class ValidationRuleFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (fs::temp_directory_path() / "cpp-code-quest-rules.txt").string();
+    }
+
+    void TearDown() override {
+        fs::remove(path_);
+    }
+
+    std::string path_;
+    GameEngine engine_;
+};
+
+TEST_F(ValidationRuleFileTest, OverridesSelectedLevels) {
+    ASSERT_TRUE(FileUtils::write_file(path_,
+        "# Level 3 now forbids raw new\n"
+        "level3 = all(contains(\"make_unique\"), not(contains(\"new \")))\n"));
+    ASSERT_TRUE(engine_.loadValidationRules(path_));
+
+    EXPECT_TRUE(engine_.getLevel(2).validateSolution("auto p = std::make_unique<int>(1);"));
+    EXPECT_FALSE(engine_.getLevel(2).validateSolution("auto p = std::make_unique<int>(1); int* q = new int;"));
+    EXPECT_TRUE(engine_.getLevel(0).validateSolution("auto f = [](auto x) { return x; };"));
+}
+
+TEST_F(ValidationRuleFileTest, BadFileChangesNothing) {
+    ASSERT_TRUE(FileUtils::write_file(path_,
+        "level1 = contains(\"never\")\n"
+        "level2 = all(contains(\"a\"\n"));
+
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(engine_.loadValidationRules(path_));
+    const std::string message = testing::internal::GetCapturedStderr();
+    EXPECT_NE(message.find("level2: expected ')'"), std::string::npos) << message;
+
+    ASSERT_TRUE(FileUtils::write_file(path_, "level6 = contains(\"x\")\n"));
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(engine_.loadValidationRules(path_));
+    testing::internal::GetCapturedStderr();
+
+    EXPECT_TRUE(engine_.getLevel(0).validateSolution("auto f = [](auto x) { return x; };"));
+}
+
+} // namespace CppCodeQuestTests
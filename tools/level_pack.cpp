@@ -0,0 +1,60 @@
+/**
+ * level-pack: converts a level catalog into the binary pack that
+ * cpp-code-quest --catalog maps at startup.
+ *
+ *   level-pack assets/levels/default.catalog build/levels/default.pack
+ *
+ * Every rule is compiled first, so a pack that builds is one the game will
+ * accept. The input may itself be a pack (repacking is a format check).
+ * The output is written beside the target and renamed over it.
+ */
+
+#include "LevelCatalog.hpp"
+#include "ValidationRule.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: level-pack <input.catalog> <output.pack>\n";
+        return 2;
+    }
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    const auto catalog = LevelCatalog::load(input);
+    if (!catalog) {
+        return 1;
+    }
+    if (catalog->empty()) {
+        std::cerr << "Error: " << input << ": no levels" << std::endl;
+        return 1;
+    }
+    for (const auto& entry : *catalog) {
+        std::string error;
+        if (!ValidationRule::parse(entry.rule, error)) {
+            std::cerr << "Error: " << input << ": level " << entry.id << " rule: " << error << std::endl;
+            return 1;
+        }
+    }
+
+    // Running games map the old pack, so it is replaced, never truncated
+    const std::string pack = catalog->toPack();
+    const std::string temporary = output + ".tmp";
+    std::ofstream file(temporary, std::ios::binary);
+    file.write(pack.data(), static_cast<std::streamsize>(pack.size()));
+    file.close();
+    std::error_code error;
+    if (file) {
+        std::filesystem::rename(temporary, output, error);
+    }
+    if (!file || error) {
+        std::cerr << "Error: Could not write " << output << std::endl;
+        std::filesystem::remove(temporary, error);
+        return 1;
+    }
+    std::cout << output << ": " << catalog->size() << " levels, " << pack.size() << " bytes\n";
+    return 0;
+}
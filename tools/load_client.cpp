@@ -0,0 +1,247 @@
+/**
+ * load-client: plays many scripted games against cpp-code-quest --serve.
+ *
+ *   load-client unix:/tmp/quest.sock --sessions 2000 --concurrency 200
+ *   load-client tcp:7000 --hold 500 --seconds 30
+ *
+ * Each session connects, sends a whole game up front (Enter, then every
+ * level's reference solution, DONE and "y") and reads until the server
+ * hangs up; a session passes if the victory screen arrived. Throughput and
+ * connect-to-hangup latency are reported. --hold opens that many sessions,
+ * waits until each shows its welcome prompt, keeps them idle for --seconds
+ * and hangs up: the server's own report then gives memory per session.
+ * Serve with --fast, or the pauses after the last input line are waited out.
+ */
+
+#include "LevelCatalog.hpp"
+#include "SocketAddress.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef CQ_SOCKETS_POSIX
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string address;
+    std::string catalogPath;    // must match the server's --catalog
+    size_t sessions = 100;
+    size_t concurrency = 16;
+    size_t hold = 0;
+    unsigned seconds = 10;
+};
+
+void printUsage() {
+    std::cerr << "Usage: load-client <tcp:[HOST:]PORT | unix:PATH> [--sessions N] [--concurrency N]\n"
+              << "                   [--catalog FILE] [--hold N] [--seconds N]\n";
+}
+
+bool parseArguments(int argc, char* argv[], Options& options) {
+    if (argc < 2) {
+        return false;
+    }
+    options.address = argv[1];
+    for (int i = 2; i < argc; i += 2) {
+        const std::string name = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Error: " << name << " needs a value" << std::endl;
+            return false;
+        }
+        const std::string value = argv[i + 1];
+        const size_t number = std::strtoul(value.c_str(), nullptr, 10);
+        if (name == "--catalog") {
+            options.catalogPath = value;
+        } else if (name == "--sessions") {
+            options.sessions = number;
+        } else if (name == "--concurrency") {
+            options.concurrency = std::max<size_t>(1, number);
+        } else if (name == "--hold") {
+            options.hold = number;
+        } else if (name == "--seconds") {
+            options.seconds = static_cast<unsigned>(number);
+        } else {
+            std::cerr << "Error: unknown option " << name << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Everything a player who knows every answer types
+std::string buildTranscript(const LevelCatalog& catalog) {
+    std::string transcript = "\n";
+    for (const auto& level : catalog) {
+        transcript += level.solution;
+        if (!transcript.empty() && transcript.back() != '\n') {
+            transcript += '\n';
+        }
+        transcript += "DONE\ny\n";
+    }
+    return transcript;
+}
+
+#ifdef CQ_SOCKETS_POSIX
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;    // macOS sockets get SO_NOSIGPIPE instead
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t count = ::send(fd, data.data() + sent, data.size() - sent, kSendFlags);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// Reads until `marker` appears (or, with an empty marker, until the server
+// hangs up); the output so far goes to `received`
+bool receiveUntil(int fd, std::string& received, const std::string& marker) {
+    char buffer[16 * 1024];
+    for (;;) {
+        if (!marker.empty() && received.find(marker) != std::string::npos) {
+            return true;
+        }
+        const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return marker.empty() && count == 0;
+        }
+        received.append(buffer, static_cast<size_t>(count));
+    }
+}
+
+int runGames(const SocketAddress& address, const std::string& transcript, const Options& options) {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> received{0};
+    std::mutex latencyMutex;
+    std::vector<double> latencies;
+
+    const auto start = Clock::now();
+    std::vector<std::thread> players;
+    for (size_t p = 0; p < std::min(options.concurrency, options.sessions); ++p) {
+        players.emplace_back([&] {
+            std::string output;
+            while (next.fetch_add(1) < options.sessions) {
+                const auto begin = Clock::now();
+                const int fd = address.connect();
+                output.clear();
+                const bool played = fd >= 0 && sendAll(fd, transcript) && receiveUntil(fd, output, "") &&
+                                    output.find("CONGRATULATIONS") != std::string::npos;
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                if (!played) {
+                    ++failed;
+                    continue;
+                }
+                received += output.size();
+                const std::chrono::duration<double, std::milli> elapsed = Clock::now() - begin;
+                std::lock_guard<std::mutex> lock(latencyMutex);
+                latencies.push_back(elapsed.count());
+            }
+        });
+    }
+    for (auto& player : players) {
+        player.join();
+    }
+    const std::chrono::duration<double> wall = Clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](double p) {
+        return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+    std::cout << "Games: " << latencies.size() << " won, " << failed.load() << " failed, "
+              << options.concurrency << " at a time\n"
+              << "Wall time: " << wall.count() << " s, "
+              << static_cast<double>(latencies.size()) / wall.count() << " games/s\n"
+              << "Latency ms: p50 " << percentile(0.50) << ", p90 " << percentile(0.90) << ", p99 "
+              << percentile(0.99) << ", max " << percentile(1.0) << "\n"
+              << "Received: " << (latencies.empty() ? 0 : received.load() / latencies.size())
+              << " bytes per game\n";
+    return failed.load() == 0 ? 0 : 1;
+}
+
+int holdSessions(const SocketAddress& address, const Options& options) {
+    std::vector<int> sockets;
+    std::string output;
+    for (size_t i = 0; i < options.hold; ++i) {
+        const int fd = address.connect();
+        output.clear();
+        if (fd < 0 || !receiveUntil(fd, output, "Press Enter")) {
+            std::cerr << "Error: session " << i + 1 << " did not start: " << std::strerror(errno) << std::endl;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            break;
+        }
+        sockets.push_back(fd);
+    }
+    std::cout << "Holding " << sockets.size() << " idle sessions for " << options.seconds << " s\n";
+    std::this_thread::sleep_for(std::chrono::seconds(options.seconds));
+    for (const int fd : sockets) {
+        ::close(fd);
+    }
+    return sockets.size() == options.hold ? 0 : 1;
+}
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+#ifdef CQ_SOCKETS_POSIX
+    std::string error;
+    const auto address = SocketAddress::parse(options.address, error);
+    if (!address) {
+        std::cerr << "Error: " << error << std::endl;
+        return 2;
+    }
+    if (options.hold > 0) {
+        return holdSessions(*address, options);
+    }
+
+    std::optional<LevelCatalog> loaded;
+    if (!options.catalogPath.empty()) {
+        loaded = LevelCatalog::load(options.catalogPath);
+        if (!loaded) {
+            return 1;
+        }
+    }
+    const LevelCatalog& catalog = loaded ? *loaded : LevelCatalog::builtin();
+    return runGames(*address, buildTranscript(catalog), options);
+#else
+    std::cerr << "Error: load-client needs POSIX sockets" << std::endl;
+    return 1;
+#endif
+}